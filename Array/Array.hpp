@@ -2,11 +2,155 @@
 #define __ARRAY_ARRAY_HPP
 #include <stdexcept>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <bit>
+
+/*
+Relocation := move-construct into new storage + destroy the source.
+For most types this is equivalent to a raw byte copy of the object, in which case reallocation can be done by one memcpy
+instead of n move constructor + n destructor calls.
+
+Trivially copyable types are always trivially relocatable. Some others (e.g. a type owning a heap ptr, w/out self-referencing
+ptrs) are as well but the compiler cannot prove it, so users may opt in by specializing:
+
+    template <> struct is_trivially_relocatable<MyType> : std::true_type {};
+
+NOTE: do NOT opt in types holding ptrs into themselves (e.g. libstdc++ std::string w/ its SSO buffer).
+*/
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
 
 template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Iterator concepts in terms of the classic iterator_category tag, so that also iterators only declaring the 5 aliases qualify.
+// Constraining the range funcs w/ them keeps e.g. Array<int>(5, 1) from resolving to the range constructor.
+template <typename It>
+concept ArrayInputIterator = std::derived_from<typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>;
+
+template <typename It>
+concept ArrayForwardIterator = ArrayInputIterator<It> && std::derived_from<typename std::iterator_traits<It>::iterator_category, std::forward_iterator_tag>;
+
+/*
+Allocator support:
+
+Array takes a standard Allocator (default std::allocator<T>) and does all allocation, construction and destruction through
+std::allocator_traits. To use a std::pmr::memory_resource (e.g. the arenas in MemoryResource/), instantiate w/
+std::pmr::polymorphic_allocator<T>, or simply use the PmrArray<T> alias below.
+
+Propagation follows the std containers: the allocator is moved w/ a move construction, selected by
+select_on_container_copy_construction on copy, and only replaced on assignment if the propagate_on_* traits say so.
+
+For SIMD or cache line aligned storage use AlignedAllocator<T, 64> (or any power of 2 alignment) below.
+*/
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0 && Alignment >= alignof(T), "Alignment must be a power of 2 and at least alignof(T)");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, (Alignment > alignof(U) ? Alignment : alignof(U))>; };
+
+    AlignedAllocator() = default;
+    template <typename U, size_t A>
+    AlignedAllocator(const AlignedAllocator<U, A>&) {}
+
+    T* allocate(size_t n)  {return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));}
+    void deallocate(T* ptr, size_t)  {::operator delete(ptr, std::align_val_t(Alignment));}
+
+    template <typename U, size_t A>
+    bool operator==(const AlignedAllocator<U, A>&) const  {return true;}
+};
+
+/*
+Growth policies:
+
+Array asks its Growth policy for the new capacity whenever it runs out of room, via
+    static size_t grow(size_t capacity, size_t required, size_t elem_size)   // must return >= required
+and reports every buffer it adopts through 2 hooks, which are no-ops unless instrumented:
+    on_allocate(new_capacity)                 any new buffer (incl. the constructors' first one)
+    on_reallocate(new_capacity, bytes_moved)  a buffer replacing an older one, whose elems were relocated
+
+- DoublingGrowth (default): 2x. Fewest reallocations, but up to 50% of the buffer may be slack.
+- HalfGrowth: 1.5x. More reallocations, less slack, and freed blocks can eventually be reused by the allocator
+  (with 2x, the sum of all previous blocks is always smaller than the next one).
+- PowerOfTwoGrowth: 2x, rounded up to a power of 2 elems, and to whole 2 MiB huge pages once the buffer is that large.
+  Pair it w/ AlignedAllocator<T, ARRAY_HUGE_PAGE_SIZE> to get buffers the kernel can back w/ transparent huge pages.
+
+Wrap any of them in InstrumentedGrowth<Policy> to count reallocations, bytes relocated and the peak capacity:
+
+    Array<int, std::allocator<int>, InstrumentedGrowth<HalfGrowth>> arr;
+    ...
+    arr.growth_policy().stats().reallocations
+*/
+inline constexpr size_t ARRAY_HUGE_PAGE_SIZE = size_t(2) << 20;
+
+struct ArrayGrowthHooks {
+    void on_allocate(size_t /*new_capacity*/) {}
+    void on_reallocate(size_t /*new_capacity*/, size_t /*bytes_moved*/) {}
+};
+
+struct DoublingGrowth : ArrayGrowthHooks {
+    static size_t grow(size_t capacity, size_t required, size_t /*elem_size*/)  {
+        return std::max(required, capacity ? capacity * 2 : 1); // handles moved-from arrs
+    }
+};
+
+struct HalfGrowth : ArrayGrowthHooks {
+    static size_t grow(size_t capacity, size_t required, size_t /*elem_size*/)  {
+        return std::max(required, capacity + capacity / 2 + 1);
+    }
+};
+
+struct PowerOfTwoGrowth : ArrayGrowthHooks {
+    static size_t grow(size_t capacity, size_t required, size_t elem_size)  {
+        size_t target = std::max(required, capacity * 2);
+        if (target * elem_size >= ARRAY_HUGE_PAGE_SIZE) {
+            size_t bytes = (target * elem_size + ARRAY_HUGE_PAGE_SIZE - 1) & ~(ARRAY_HUGE_PAGE_SIZE - 1);
+            return bytes / elem_size;
+        }
+        return std::bit_ceil(std::max<size_t>(target, 1));
+    }
+};
+
+struct ArrayGrowthStats {
+    size_t reallocations = 0;
+    size_t bytes_copied = 0; // bytes of live elems relocated into new buffers
+    size_t peak_capacity = 0; // in elems
+};
+
+template <typename Policy>
+struct InstrumentedGrowth : Policy {
+    void on_allocate(size_t new_capacity)  {stats_.peak_capacity = std::max(stats_.peak_capacity, new_capacity);}
+    void on_reallocate(size_t new_capacity, size_t bytes_moved)  {
+        ++stats_.reallocations;
+        stats_.bytes_copied += bytes_moved;
+        on_allocate(new_capacity);
+    }
+    const ArrayGrowthStats& stats() const  {return stats_;}
+    void reset_stats()  {stats_ = ArrayGrowthStats();}
+
+private:
+    ArrayGrowthStats stats_;
+};
+
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = DoublingGrowth>
 class Array {
+    using AllocTraits = std::allocator_traits<Alloc>;
 public:
-    class iterator  {
+    using allocator_type = Alloc;
+    using growth_policy_type = Growth;
+
+    template <bool Const>
+    class basic_iterator  {
     /*
     To conform to the standard iterator interface, the iterator class must define the following type aliases:
 
@@ -15,35 +159,49 @@ public:
     - pointer: The type of a pointer to the element (T*).
     - reference: The type of a reference to the element (T&).
     - iterator_category: Specifies the type of iterator (e.g., std::random_access_iterator_tag).
+
+    On top of that, std::contiguous_iterator (C++20) asks for
+    - iterator_concept = std::contiguous_iterator_tag, i.e. the elems are adjacent in mem, so std::to_address(it) is valid
+    - the full random access op set: ++/-- (pre & post), +=, -=, it + n, n + it, it - n, it - it, it[n], <, <=, >, >=
+    - a default constructor and ->
+    Then std algorithms & std::span take their ptr based fast paths (memmove, vectorized loops) on Array iters.
+
+    basic_iterator<true> is the const_iterator: same ops, but yields const T&. An iterator converts to a const_iterator
+    implicitly, never the other way around.
     */
     public:
         using difference_type = std::ptrdiff_t;
         using value_type = T;
-        using pointer = T*;
-        using reference = T&;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
         using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
 
-        iterator(pointer ptr_in);
+        basic_iterator() : ptr_(nullptr) {}
+        basic_iterator(pointer ptr_in) : ptr_(ptr_in) {}
+        template <bool OtherConst> requires (Const && !OtherConst)
+        basic_iterator(const basic_iterator<OtherConst>& other) : ptr_(other.operator->()) {} // iterator -> const_iterator
 
-        /*
-        iterator cls should have:
-        > ++ increm op
-        > + offsetting op
-        > * deref op
-        > ==, != (in)eq op, for control conditioning
-        */
+        basic_iterator& operator++()  {++ptr_; return *this;} // return by ref means pre increm
+        basic_iterator& operator--()  {--ptr_; return *this;}
+        basic_iterator operator++(int)  {basic_iterator old = *this; ++ptr_; return old;} // post increm returns the old value
+        basic_iterator operator--(int)  {basic_iterator old = *this; --ptr_; return old;}
 
-        iterator& operator++(); // return by ref means pre increm
-        iterator& operator--();
-        iterator operator+(size_t incr) const; // Note that we want it+incr to return a new incr-ed iter but not modify the original
+        basic_iterator& operator+=(difference_type n)  {ptr_ += n; return *this;}
+        basic_iterator& operator-=(difference_type n)  {ptr_ -= n; return *this;}
+        basic_iterator operator+(difference_type n) const  {return basic_iterator(ptr_ + n);} // it + n returns a new iter, leaving it as is
+        basic_iterator operator-(difference_type n) const  {return basic_iterator(ptr_ - n);}
+        friend basic_iterator operator+(difference_type n, const basic_iterator& it)  {return it + n;}
 
-        reference operator*() const; // return by ref :  could modify through iter as *iter = a;
+        reference operator*() const  {return *ptr_;} // return by ref :  could modify through iter as *iter = a;
+        pointer operator->() const  {return ptr_;}
+        reference operator[](difference_type n) const  {return ptr_[n];}
 
-        bool operator==(iterator rhs) const;
-        bool operator!=(iterator rhs) const;
+        bool operator==(const basic_iterator& rhs) const  {return ptr_ == rhs.ptr_;} // != is derived from == since C++20
+        auto operator<=>(const basic_iterator& rhs) const  {return ptr_ <=> rhs.ptr_;} // <, <=, >, >=
 
         // Difference operator (required for std::distance)
-        difference_type operator-(const iterator& other) const { return ptr_ - other.ptr_; }
+        difference_type operator-(const basic_iterator& other) const { return ptr_ - other.ptr_; }
 
 
         friend class Array; // for convenient direct access of Array attributes
@@ -51,14 +209,25 @@ public:
     private:
         pointer ptr_;
     };
-
-    Array(); // default constructor: empty w/ capacity 1
-    Array(size_t count, const T& other = T()); // fill constructor
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    Array() : Array(Alloc()) {} // default constructor: empty w/ capacity 1
+    explicit Array(const Alloc& alloc);
+    Array(size_t count, const T& other = T(), const Alloc& alloc = Alloc()); // fill constructor
+    template <ArrayInputIterator It>
+    Array(It first, It last, const Alloc& alloc = Alloc()); // range constructor: one allocation of exactly distance(first, last) for forward iters
     ~Array();
     Array(const Array& other); // copy constructor
     Array& operator=(const Array& other); // copy assignment
     Array(Array&& other) noexcept; // move constructor
-    Array& operator=(Array&& other) noexcept; // move assignment
+    Array& operator=(Array&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value); // move assignment
+
+    allocator_type get_allocator() const  {return alloc_;}
+    const Growth& growth_policy() const  {return growth_;} // e.g. growth_policy().stats() w/ InstrumentedGrowth
+
+    T* data()  {return arr_;} // raw contiguous storage, e.g. for the kernels in ArraySIMD.hpp
+    const T* data() const  {return arr_;}
 
     T& operator[](size_t index); // overriding [] index offsetting op, return by ref for modif as arr[i] = a;
     const T& operator[](size_t index) const; // a non-const overload
@@ -66,8 +235,11 @@ public:
     void push_back(const T& input); // append to end, double capac. size_ ~ n : N_alloc ~ O(log n), amortized O(1) by geometric sum
     void push_back(T&& input);
 
-    void remove(size_t index); // rm elem @ idx, size--
-    void clear()    {size_ = 0;}
+    void remove(size_t index); // rm elem @ idx, size--. O(n - idx) as the tail shifts down
+    void swap_remove(size_t index); // rm elem @ idx by moving the last elem into its place: O(1) but does NOT preserve order
+    void pop_back(); // rm last elem, O(1)
+    iterator erase(iterator first, iterator last); // rm [first, last) w/ one shift of the tail, return iter to the elem after
+    void clear(); // destroys all elems, keeps capacity
 
     size_t size() const;
     size_t capacity() const;
@@ -75,69 +247,227 @@ public:
 
     void resize(size_t new_size, const T& filler = T()); // move semantics' inapplicable here as repeated assignment & reusing the src is required
     void reserve(size_t new_capacity);
+    void shrink_to_fit(); // reallocate to exactly max(size, 1) elems, e.g. to hand back the mem of an arr that spiked & drained
 
     // For iter controls:
     iterator begin();
     iterator end();
 
-    const iterator begin() const;
-    const iterator end() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const  {return begin();}
+    const_iterator cend() const  {return end();}
 
     template <typename... Args>
     void emplace_back(Args&&... args); // additionally templated funcs come last, otherwise other funcs will be affected
 
+    /*
+    Bulk insertion: for forward iters the final size is known upfront, so there is at most one reallocation for the whole range,
+    and trivially copyable elems coming from contiguous mem (ptrs, Array iters) are copied w/ a single memcpy.
+    Input-only iters (e.g. istream_iterator) fall back to push_back per elem.
+    Precondition: [first, last) must not be a range of this arr itself.
+    */
+    template <ArrayInputIterator It>
+    void append(It first, It last); // append [first, last) at the end
+    template <ArrayInputIterator It>
+    iterator insert(iterator pos, It first, It last); // insert [first, last) before pos, return iter to first inserted elem
+    template <ArrayInputIterator It>
+    void assign(It first, It last); // replace contents w/ [first, last)
+
+    // Stable single pass compaction: rm all elems for which pred returns true, keeping the order of the rest.
+    // O(n) moves in total, as opposed to O(k*n) for k calls to remove(). Return num of removed elems.
+    template <typename Pred>
+    size_t remove_if(Pred pred);
+
 private:
-    T* arr_;
+    [[no_unique_address]] Alloc alloc_; // stateless allocators take no space
+    [[no_unique_address]] Growth growth_; // so do uninstrumented growth policies
+    T* arr_; // raw storage: only [0, size_) holds live objects, [size_, capacity_) is uninitialized
     size_t size_;
     size_t capacity_;
+
+    T* allocate(size_t n);
+    void deallocate(T* ptr, size_t n);
+    void relocate(T* dst, T* src, size_t n); // dst must be uninitialized; src is left uninitialized
+    void destroy(T* first, T* last);
+    void release(); // destroys all elems and frees the buffer, leaving *this w/ no storage
+
+    size_t next_capacity(size_t required) const {return Growth::grow(capacity_, required, sizeof(T));}
+    void reallocate(size_t new_capacity);
+    void adopt(T* buffer, size_t new_capacity); // frees the old buffer & takes over buffer, whose elems were relocated already
+
+    template <typename... Args>
+    void emplace_back_realloc(Args&&... args);
+
+    // Constructs n elems into uninitialized dst w/ fn(dst, n), reallocating once to fit if needed. fn must clean up after
+    // itself if it throws. fn is run BEFORE the old buffer is released, so it may still read from it (e.g. resize(n, arr[0])).
+    template <typename Fn>
+    void append_n(size_t n, Fn&& fn);
+    template <typename It>
+    void uninitialized_copy_n(It first, size_t n, T* dst);
+    void uninitialized_fill_n(T* dst, size_t n, const T& value);
 };
 
-// Let's begin implementing these templated funcs. Remember to always include template <typename T>
+// Array drawing its mem from a std::pmr::memory_resource, e.g. PmrArray<int> arr(&arena);
+template <typename T>
+using PmrArray = Array<T, std::pmr::polymorphic_allocator<T>>;
+
+// Let's begin implementing these templated funcs. Remember to always include template <typename T, typename Alloc, typename Growth>
 // and fully specify scope:: for all funcs as we are outside the classes.
 
-template <typename T>
-Array<T>::Array() : arr_(new T[1]), size_(0), capacity_(1) {}
+template <typename T, typename Alloc, typename Growth>
+T* Array<T, Alloc, Growth>::allocate(size_t n)  {
+    // Unlike new T[n], no default construction takes place: we only get raw bytes.
+    return AllocTraits::allocate(alloc_, n);
+}
 
-template <typename T>
-Array<T>::Array(size_t count, const T& other) : arr_(new T[1]), size_(0), capacity_(1) {
-    for (size_t i = 0; i < count; ++i)  {
-        push_back(other);
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::deallocate(T* ptr, size_t n)  {
+    if (ptr) AllocTraits::deallocate(alloc_, ptr, n);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::relocate(T* dst, T* src, size_t n)  {
+    if (n == 0) return;
+    if constexpr (is_trivially_relocatable_v<T>) {
+        // cast to void* to tell the compiler we know what we are doing w/ user opted-in nontrivial types
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+    } else {
+        // move_if_noexcept: fall back to copying if moving could throw, so the old buffer stays intact on failure.
+        // Whatever was built in dst is destroyed before rethrowing; freeing dst is up to the caller
+        size_t i = 0;
+        try {
+            for (; i < n; ++i)  {
+                AllocTraits::construct(alloc_, dst + i, std::move_if_noexcept(src[i]));
+            }
+        } catch (...) {
+            destroy(dst, dst + i);
+            throw;
+        }
+        destroy(src, src + n);
     }
 }
 
-template <typename T>
-Array<T>::~Array() {
-    delete[] arr_;
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::destroy(T* first, T* last)  {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (; first != last; ++first)  {
+            AllocTraits::destroy(alloc_, first);
+        }
+    }
 }
 
-template <typename T>
-Array<T>::Array(const Array& other) : arr_(new T[1]), size_(0), capacity_(1) { 
-    for (size_t i = 0; i < other.size_; ++i)  {
-        push_back(other[i]);
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::release()  {
+    destroy(arr_, arr_ + size_);
+    deallocate(arr_, capacity_);
+    arr_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::reallocate(size_t new_capacity)  {
+    // Precondition: new_capacity >= size_
+    T* temp = allocate(new_capacity); // this is not exception safe, so it goes first
+    try {
+        relocate(temp, arr_, size_);
+    } catch (...) {
+        deallocate(temp, new_capacity); // relocate left the old buffer intact & temp empty
+        throw;
     }
+    adopt(temp, new_capacity);
 }
 
-template <typename T>
-Array<T>& Array<T>::operator=(const Array& other)    {
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::adopt(T* buffer, size_t new_capacity)  {
+    deallocate(arr_, capacity_);
+    arr_ = buffer;
+    capacity_ = new_capacity;
+    growth_.on_reallocate(new_capacity, size_ * sizeof(T));
+}
+
+
+template <typename T, typename Alloc, typename Growth>
+Array<T, Alloc, Growth>::Array(const Alloc& alloc) : alloc_(alloc), arr_(allocate(1)), size_(0), capacity_(1) {
+    growth_.on_allocate(1);
+}
+
+template <typename T, typename Alloc, typename Growth>
+Array<T, Alloc, Growth>::Array(size_t count, const T& other, const Alloc& alloc)
+    : alloc_(alloc), arr_(allocate(std::max<size_t>(count, 1))), size_(0), capacity_(std::max<size_t>(count, 1)) {
+    // storage is sized upfront, so this is exactly 1 allocation
+    growth_.on_allocate(capacity_);
+    try {
+        append_n(count, [&](T* dst, size_t n) {uninitialized_fill_n(dst, n, other);});
+    } catch (...) {
+        deallocate(arr_, capacity_); // destructor won't run for a throwing constructor
+        throw;
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+Array<T, Alloc, Growth>::~Array() {
+    release();
+}
+
+template <typename T, typename Alloc, typename Growth>
+Array<T, Alloc, Growth>::Array(const Array& other)
+    : alloc_(AllocTraits::select_on_container_copy_construction(other.alloc_)),
+      arr_(allocate(std::max<size_t>(other.size_, 1))), size_(0), capacity_(std::max<size_t>(other.size_, 1)) {
+    // the growth policy is NOT copied: the copy starts its own instrumentation history
+    growth_.on_allocate(capacity_);
+    try {
+        append(other.arr_, other.arr_ + other.size_); // fits, so no reallocation: 1 allocation + 1 memcpy for trivially copyable T
+    } catch (...) {
+        deallocate(arr_, capacity_);
+        throw;
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+Array<T, Alloc, Growth>& Array<T, Alloc, Growth>::operator=(const Array& other)    {
     if (this != &other) {
-        for (size_t i = 0; i < other.size_; ++i)  {
-            push_back(other[i]);
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) release(); // our buffer must be freed by the allocator that allocated it
+            alloc_ = other.alloc_;
         }
+        assign(other.arr_, other.arr_ + other.size_);
     }
     return *this;
 }
 
-template <typename T>
-Array<T>::Array(Array<T>&& other) noexcept : arr_(other.arr_), size_(other.size_), capacity_(other.capacity_)  {
+template <typename T, typename Alloc, typename Growth>
+Array<T, Alloc, Growth>::Array(Array<T, Alloc, Growth>&& other) noexcept
+    : alloc_(std::move(other.alloc_)), growth_(std::move(other.growth_)), arr_(other.arr_), size_(other.size_), capacity_(other.capacity_)  {
+    // the growth policy's history goes w/ the buffer, the emptied source starts a new one
+    other.growth_ = Growth();
     other.arr_ = nullptr;
     other.size_ = 0;
     other.capacity_ = 0;
 }
 
-template <typename T>
-Array<T>& Array<T>::operator=(Array<T>&& other) noexcept  {
+template <typename T, typename Alloc, typename Growth>
+Array<T, Alloc, Growth>& Array<T, Alloc, Growth>::operator=(Array<T, Alloc, Growth>&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)  {
     if (this != &other) {
-        delete[] arr_;
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value) {
+            if (alloc_ != other.alloc_) {
+                // other's buffer belongs to another resource which we cannot free: move elem by elem instead
+                clear();
+                reserve(other.size_);
+                for (size_t i = 0; i < other.size_; ++i)  {
+                    emplace_back(std::move(other.arr_[i]));
+                }
+                other.clear();
+                return *this;
+            }
+        }
+        release();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            alloc_ = std::move(other.alloc_);
+        }
+        growth_ = std::move(other.growth_);
+        other.growth_ = Growth();
         arr_ = other.arr_;
         size_ = other.size_;
         capacity_ = other.capacity_;
@@ -148,8 +478,8 @@ Array<T>& Array<T>::operator=(Array<T>&& other) noexcept  {
     return *this;
 }
 
-template <typename T>
-T& Array<T>::operator[](size_t index)   {
+template <typename T, typename Alloc, typename Growth>
+T& Array<T, Alloc, Growth>::operator[](size_t index)   {
     if (index >= size_) {
         throw std::out_of_range("Index out of bounds");
     }
@@ -157,8 +487,8 @@ T& Array<T>::operator[](size_t index)   {
 }
 
 
-template <typename T>
-const T& Array<T>::operator[](size_t index) const {
+template <typename T, typename Alloc, typename Growth>
+const T& Array<T, Alloc, Growth>::operator[](size_t index) const {
     if (index >= size_) {
         throw std::out_of_range("Index out of bounds");
     }
@@ -166,174 +496,357 @@ const T& Array<T>::operator[](size_t index) const {
 }
 
 
-template <typename T>
-void Array<T>::push_back(const T& input)   {
-    if (capacity_ == size_) {
-        capacity_ ? capacity_ *= 2 : capacity_ += 1; // IMPORTANT: handles moved-from arrs
-        auto temp = new T[capacity_];
-        // O(n) copying is inevitable for resizing and move semantics cannot be use to optimize: NO auto temp = std::move(*this)
-        // as resizing is essentially allocing new mem space and we don't want to transfer ownership of old mem space which has no effect at all.
-        for (size_t i = 0; i < size_; ++i)  {
-            temp[i] = std::move(arr_[i]); // However one could use std::move here to optimize copying of individual arr elem
-            // note that arr elements could be nontrivial objs as well
-            // compiler copy elison will NOT come into effect here as the RHS is not a rvalue
-        }
-        delete[] arr_;
-        arr_ = temp;
-    }
-    arr_[size_] = input;
-    size_++;
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::push_back(const T& input)   {
+    emplace_back(input); // copy-construct in place
 }
 
 
-template <typename T>
-void Array<T>::push_back(T&& input)   { // rvalue overload
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::push_back(T&& input)   { // rvalue overload
+    emplace_back(std::move(input));
+}
+
+template <typename T, typename Alloc, typename Growth>
+template <typename... Args>
+void Array<T, Alloc, Growth>::emplace_back(Args&&... args) {
     if (capacity_ == size_) {
-        capacity_ *= 2;
-        auto temp = new T[capacity_];
-        // O(n) copying is inevitable for resizing and move semantics cannot be use to optimize: NO auto temp = std::move(*this)
-        // as resizing is essentially allocing new mem space and we don't want to transfer ownership of old mem space which has no effect at all.
-        for (size_t i = 0; i < size_; ++i)  {
-            temp[i] = std::move(arr_[i]); // However one could use std::move here to optimize copying of individual arr elem
-            // note that arr elements could be nontrivial objs as well
-            // compiler copy elison will NOT come into effect here as the RHS is not a rvalue
-        }
-        delete[] arr_;
-        arr_ = temp;
+        emplace_back_realloc(std::forward<Args>(args)...);
+        return;
     }
-    arr_[size_] = std::move(input);
+    // Construct the new element in-place using perfect forwarding. The slot is raw memory, so no object is overwritten.
+    AllocTraits::construct(alloc_, arr_ + size_, std::forward<Args>(args)...);
     size_++;
 }
 
-template <typename T>
+template <typename T, typename Alloc, typename Growth>
 template <typename... Args>
-void Array<T>::emplace_back(Args&&... args) {
-    if (capacity_ == size_) {
-        capacity_ ? capacity_ *= 2 : capacity_ += 1;
-        auto temp = new T[capacity_];
-        for (size_t i = 0; i < size_; ++i) {
-            temp[i] = std::move(arr_[i]); // Move existing elements
-        }
-        delete[] arr_;
-        arr_ = temp;
+void Array<T, Alloc, Growth>::emplace_back_realloc(Args&&... args) {
+    // O(n) relocation is inevitable for resizing, yet w/ raw storage its cost is a memcpy of the live bytes for
+    // trivially relocatable T, and n move constructions otherwise -- never default construction of the whole new buffer.
+    size_t new_capacity = next_capacity(size_ + 1);
+    T* temp = allocate(new_capacity);
+    try {
+        // Construct the new elem BEFORE relocating: args may refer to an elem of this arr (e.g. arr.push_back(arr[0]))
+        AllocTraits::construct(alloc_, temp + size_, std::forward<Args>(args)...);
+    } catch (...) {
+        deallocate(temp, new_capacity);
+        throw;
+    }
+    try {
+        relocate(temp, arr_, size_);
+    } catch (...) {
+        destroy(temp + size_, temp + size_ + 1);
+        deallocate(temp, new_capacity);
+        throw;
     }
-    // Construct the new element in-place using perfect forwarding
-    new (&arr_[size_]) T(std::forward<Args>(args)...);
+    adopt(temp, new_capacity);
     size_++;
 }
 
 
-template <typename T>
-void Array<T>::remove(size_t index)   {
-    auto iter = this->begin() + index;
-    // left shift the part after removed index
-    for (auto it = iter; (it + 1) != this->end(); ++it)    { // Note the loop termination condition
-        *it = *(it + 1); // last elem is unchanged yet will go obsolete
+template <typename T, typename Alloc, typename Growth>
+template <typename Fn>
+void Array<T, Alloc, Growth>::append_n(size_t n, Fn&& fn)  {
+    if (n == 0) return;
+    if (size_ + n <= capacity_) {
+        fn(arr_ + size_, n);
+    } else {
+        // grow geometrically unless the request alone is larger, so that repeated appends stay amortized O(1)
+        size_t new_capacity = next_capacity(size_ + n);
+        T* temp = allocate(new_capacity);
+        try {
+            fn(temp + size_, n);
+        } catch (...) {
+            deallocate(temp, new_capacity);
+            throw;
+        }
+        try {
+            relocate(temp, arr_, size_);
+        } catch (...) {
+            destroy(temp + size_, temp + size_ + n);
+            deallocate(temp, new_capacity);
+            throw;
+        }
+        adopt(temp, new_capacity);
     }
-    size_--;
+    size_ += n;
 }
 
-template <typename T>
-void Array<T>::resize(size_t new_size, const T& filler)   {
-    if (new_size == size_) return;
-    if (new_size < size_) {
-        size_ = new_size;
-        return;
-    }
-    
-    for (size_t i = size_; i < new_size; ++i)  {
-        push_back(filler);
+template <typename T, typename Alloc, typename Growth>
+template <typename It>
+void Array<T, Alloc, Growth>::uninitialized_copy_n(It first, size_t n, T* dst)  {
+    if constexpr (std::is_trivially_copyable_v<T> && std::contiguous_iterator<It> &&
+                  std::is_same_v<std::remove_cv_t<std::iter_value_t<It>>, T>) {
+        // a block of plain bytes: one memcpy
+        if (n) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(std::to_address(first)), n * sizeof(T));
+    } else {
+        size_t i = 0;
+        try {
+            for (; i < n; ++i, ++first)  {
+                AllocTraits::construct(alloc_, dst + i, *first);
+            }
+        } catch (...) {
+            destroy(dst, dst + i); // roll back the ones already built
+            throw;
+        }
     }
+}
 
-    // A heap buffer overflow occurs when a program writes data beyond the bounds of allocated heap memory.
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::uninitialized_fill_n(T* dst, size_t n, const T& value)  {
+    size_t i = 0;
+    try {
+        for (; i < n; ++i)  {
+            AllocTraits::construct(alloc_, dst + i, value);
+        }
+    } catch (...) {
+        destroy(dst, dst + i);
+        throw;
+    }
 }
 
-template <typename T>
-void Array<T>::reserve(size_t new_capacity)   {
-    if (new_capacity <= capacity_) return;
+template <typename T, typename Alloc, typename Growth>
+template <ArrayInputIterator It>
+Array<T, Alloc, Growth>::Array(It first, It last, const Alloc& alloc) : alloc_(alloc), arr_(nullptr), size_(0), capacity_(1) {
+    size_t n = 0;
+    if constexpr (ArrayForwardIterator<It>) {
+        n = static_cast<size_t>(std::distance(first, last));
+        capacity_ = std::max<size_t>(n, 1); // sized upfront, so this is exactly 1 allocation
+    }
+    arr_ = allocate(capacity_); // single pass iters start like a default constructed arr & grow
+    growth_.on_allocate(capacity_);
+    try {
+        if constexpr (ArrayForwardIterator<It>) {
+            append_n(n, [&](T* dst, size_t count) {uninitialized_copy_n(first, count, dst);}); // fits: no reallocation
+        } else {
+            append(first, last);
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
 
-    auto temp = new T[new_capacity]; // this is not exception safe, so it goes first
-    
-    for (size_t i = 0; i < size_; ++i)  {
-        temp[i] = std::move(arr_[i]);
+template <typename T, typename Alloc, typename Growth>
+template <ArrayInputIterator It>
+void Array<T, Alloc, Growth>::append(It first, It last)  {
+    if constexpr (ArrayForwardIterator<It>) {
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        append_n(n, [&](T* dst, size_t count) {uninitialized_copy_n(first, count, dst);});
+    } else {
+        for (; first != last; ++first)  {
+            emplace_back(*first); // single pass: size unknown upfront
+        }
     }
+}
 
-    delete[] arr_;
+template <typename T, typename Alloc, typename Growth>
+template <ArrayInputIterator It>
+typename Array<T, Alloc, Growth>::iterator Array<T, Alloc, Growth>::insert(iterator pos, It first, It last)  {
+    size_t idx = static_cast<size_t>(pos.ptr_ - arr_);
+    if (idx > size_) {
+        throw std::out_of_range("Insert position out of bounds");
+    }
+    size_t old_size = size_;
+
+    if constexpr (ArrayForwardIterator<It> && is_trivially_relocatable_v<T>) {
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        if (n == 0) return iterator(arr_ + idx);
+        if (size_ + n > capacity_) {
+            // fresh buffer: build the new elems in the middle, then relocate the 2 halves around them
+            size_t new_capacity = next_capacity(size_ + n);
+            T* temp = allocate(new_capacity);
+            try {
+                uninitialized_copy_n(first, n, temp + idx);
+            } catch (...) {
+                deallocate(temp, new_capacity);
+                throw;
+            }
+            try {
+                // memcpy for a trivially relocatable T, so this never throws in practice, and a 2nd relocate cannot
+                // fail after the 1st has emptied the head of arr_
+                relocate(temp, arr_, idx);
+                relocate(temp + idx + n, arr_ + idx, size_ - idx);
+            } catch (...) {
+                destroy(temp + idx, temp + idx + n);
+                deallocate(temp, new_capacity);
+                throw;
+            }
+            adopt(temp, new_capacity);
+        } else {
+            // open a gap by sliding the tail as raw bytes, fill it, slide back if filling throws
+            std::memmove(static_cast<void*>(arr_ + idx + n), static_cast<const void*>(arr_ + idx), (size_ - idx) * sizeof(T));
+            try {
+                uninitialized_copy_n(first, n, arr_ + idx);
+            } catch (...) {
+                std::memmove(static_cast<void*>(arr_ + idx), static_cast<const void*>(arr_ + idx + n), (size_ - idx) * sizeof(T));
+                throw;
+            }
+        }
+        size_ += n;
+    } else {
+        // general case: append at the end (at most 1 reallocation for forward iters), then rotate into place.
+        // O(n + tail) moves, and the arr stays valid if copying throws midway.
+        append(first, last);
+        std::rotate(arr_ + idx, arr_ + old_size, arr_ + size_);
+    }
+    return iterator(arr_ + idx);
+}
 
-    capacity_ = new_capacity;
-    arr_ = temp;
+template <typename T, typename Alloc, typename Growth>
+template <ArrayInputIterator It>
+void Array<T, Alloc, Growth>::assign(It first, It last)  {
+    clear();
+    if constexpr (ArrayForwardIterator<It>) {
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        if (n > capacity_) {
+            // nothing to keep: drop the old buffer instead of relocating an empty arr into a new one
+            deallocate(arr_, capacity_);
+            arr_ = nullptr; // stay valid should allocate throw
+            capacity_ = 0;
+            arr_ = allocate(n);
+            capacity_ = n;
+            growth_.on_allocate(n);
+        }
+    }
+    append(first, last);
 }
 
 
-template <typename T>
-size_t Array<T>::size() const   {
-    return size_;
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::remove(size_t index)   {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    erase(iterator(arr_ + index), iterator(arr_ + index + 1));
 }
 
-template <typename T>
-size_t Array<T>::capacity() const   {
-    return capacity_;
+template <typename T, typename Alloc, typename Growth>
+typename Array<T, Alloc, Growth>::iterator Array<T, Alloc, Growth>::erase(iterator first, iterator last)   {
+    size_t begin_idx = static_cast<size_t>(first.ptr_ - arr_);
+    size_t end_idx = static_cast<size_t>(last.ptr_ - arr_);
+    if (begin_idx > end_idx || end_idx > size_) {
+        throw std::out_of_range("Erase range out of bounds");
+    }
+    size_t count = end_idx - begin_idx;
+    if (count == 0) return first;
+
+    if constexpr (is_trivially_relocatable_v<T>) {
+        // destroy the erased elems and slide the tail down as raw bytes
+        destroy(arr_ + begin_idx, arr_ + end_idx);
+        std::memmove(static_cast<void*>(arr_ + begin_idx), static_cast<const void*>(arr_ + end_idx), (size_ - end_idx) * sizeof(T));
+    } else {
+        // left shift the part after the erased range by count in one go, every tail elem is moved exactly once
+        std::move(arr_ + end_idx, arr_ + size_, arr_ + begin_idx);
+        destroy(arr_ + size_ - count, arr_ + size_); // last count elems are moved-from and go obsolete
+    }
+    size_ -= count;
+    return iterator(arr_ + begin_idx);
 }
 
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::swap_remove(size_t index)   {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    size_t last = size_ - 1;
+    if constexpr (is_trivially_relocatable_v<T>) {
+        destroy(arr_ + index, arr_ + index + 1);
+        if (index != last) { // relocate the last elem into the hole, its old slot is raw mem afterwards
+            std::memcpy(static_cast<void*>(arr_ + index), static_cast<const void*>(arr_ + last), sizeof(T));
+        }
+    } else {
+        if (index != last) arr_[index] = std::move(arr_[last]);
+        destroy(arr_ + last, arr_ + size_);
+    }
+    size_--;
+}
 
-template <typename T>
-typename Array<T>::iterator Array<T>::begin()  {
-    return Array<T>::iterator(arr_);
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::pop_back()   {
+    if (size_ == 0) {
+        throw std::out_of_range("Array is empty");
+    }
+    destroy(arr_ + size_ - 1, arr_ + size_);
+    size_--;
 }
 
-template <typename T>
-typename Array<T>::iterator Array<T>::end()  {
-    return Array<T>::iterator(arr_ + size_);
+template <typename T, typename Alloc, typename Growth>
+template <typename Pred>
+size_t Array<T, Alloc, Growth>::remove_if(Pred pred)   {
+    // std::remove_if on the raw range: kept elems are moved forward over the removed ones, leaving moved-from leftovers at the tail
+    T* new_end = std::remove_if(arr_, arr_ + size_, pred);
+    size_t removed = static_cast<size_t>((arr_ + size_) - new_end);
+    destroy(new_end, arr_ + size_);
+    size_ -= removed;
+    return removed;
 }
 
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::clear()   {
+    destroy(arr_, arr_ + size_);
+    size_ = 0;
+}
 
-template <typename T>
-const typename Array<T>::iterator Array<T>::begin() const  {
-    return Array<T>::iterator(arr_);
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::resize(size_t new_size, const T& filler)   {
+    if (new_size == size_) return;
+    if (new_size < size_) {
+        destroy(arr_ + new_size, arr_ + size_);
+        size_ = new_size;
+        return;
+    }
+    
+    append_n(new_size - size_, [&](T* dst, size_t n) {uninitialized_fill_n(dst, n, filler);});
+
+    // A heap buffer overflow occurs when a program writes data beyond the bounds of allocated heap memory.
 }
 
-template <typename T>
-const typename Array<T>::iterator Array<T>::end() const  {
-    return Array<T>::iterator(arr_ + size_);
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::reserve(size_t new_capacity)   {
+    if (new_capacity <= capacity_) return;
+    reallocate(new_capacity);
 }
 
+template <typename T, typename Alloc, typename Growth>
+void Array<T, Alloc, Growth>::shrink_to_fit()   {
+    size_t new_capacity = std::max<size_t>(size_, 1); // keep the 1 slot every live arr owns
+    if (new_capacity >= capacity_) return;
+    reallocate(new_capacity);
+}
 
-template <typename T>
-Array<T>::iterator::iterator(T* ptr_in) : ptr_(ptr_in)  {}
 
-template <typename T>
-typename Array<T>::iterator& Array<T>::iterator::operator++()   {
-    ++(this->ptr_); // ptrs have built-in ++ and + op
-    return *this; // for void func this line is omitted; yet one wants to enable the use *(it++)
-                  // so we let the func return the modified obj which is simply *this.
+template <typename T, typename Alloc, typename Growth>
+size_t Array<T, Alloc, Growth>::size() const   {
+    return size_;
 }
 
-template <typename T>
-typename Array<T>::iterator& Array<T>::iterator::operator--()   {
-    --(this->ptr_);
-    return *this;
+template <typename T, typename Alloc, typename Growth>
+size_t Array<T, Alloc, Growth>::capacity() const   {
+    return capacity_;
 }
 
-template <typename T>
-typename Array<T>::iterator Array<T>::iterator::operator+(size_t incr) const {
-    return Array<T>::iterator((this->ptr_) + incr);
-}
 
+template <typename T, typename Alloc, typename Growth>
+typename Array<T, Alloc, Growth>::iterator Array<T, Alloc, Growth>::begin()  {
+    return Array<T, Alloc, Growth>::iterator(arr_);
+}
 
-template <typename T>
-typename Array<T>::iterator::reference Array<T>::iterator::operator*() const  {
-    return *(this->ptr_);
+template <typename T, typename Alloc, typename Growth>
+typename Array<T, Alloc, Growth>::iterator Array<T, Alloc, Growth>::end()  {
+    return Array<T, Alloc, Growth>::iterator(arr_ + size_);
 }
 
 
-template <typename T>
-bool Array<T>::iterator::operator==(iterator rhs) const  {
-    return this->ptr_ == rhs.ptr_;
+template <typename T, typename Alloc, typename Growth>
+typename Array<T, Alloc, Growth>::const_iterator Array<T, Alloc, Growth>::begin() const  {
+    return Array<T, Alloc, Growth>::const_iterator(arr_);
 }
 
-template <typename T>
-bool Array<T>::iterator::operator!=(iterator rhs) const  {
-    return this->ptr_ != rhs.ptr_;
+template <typename T, typename Alloc, typename Growth>
+typename Array<T, Alloc, Growth>::const_iterator Array<T, Alloc, Growth>::end() const  {
+    return Array<T, Alloc, Growth>::const_iterator(arr_ + size_);
 }
 
 
@@ -0,0 +1,363 @@
+#ifndef __ARRAY_ARRAYPARALLEL_HPP
+#define __ARRAY_ARRAYPARALLEL_HPP
+#include <iterator>
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include "./Array.hpp"
+#include "./../ThreadPool/ThreadPool.hpp"
+
+/*
+Parallel algorithms over Array (or any random access) iters, run on a ThreadPool:
+
+    parallel_for_each(first, last, f)
+    parallel_transform(first, last, d_first, op)
+    parallel_reduce(first, last, init, op)
+    parallel_inclusive_scan(first, last, d_first, op)
+    parallel_exclusive_scan(first, last, d_first, init, op)
+    parallel_sort(first, last, comp)          chunk sort + parallel merge passes, O(n log n / p)
+    parallel_stable_sort(first, last, comp)   same, stable
+
+Every algorithm takes an optional ParallelConfig as its last arg:
+- pool:  the ThreadPool to run on (default: ThreadPool::global()).
+- grain: num of elems per task. Smaller grains balance better, larger ones cut scheduling overhead.
+         Ranges not longer than one grain run serially on the calling thread.
+
+Determinism:
+reduce & the scans cut the range into grain sized chunks, reduce each chunk left to right, and combine the chunk results
+in chunk order. The association of op is therefore fixed by the grain alone, NOT by the num of threads or the scheduling,
+so even non-associative ops (e.g. float +) give bit identical results run after run for the same grain.
+(They may still differ from a serial std::accumulate, which associates strictly left to right.)
+
+Iter requirements: it + size_t, *it and it2 - it1, which Array iters provide. The sorts additionally require contiguous
+storage (Array, std::vector, raw ptrs), as they sort through raw ptrs.
+*/
+
+struct ParallelConfig {
+    ThreadPool* pool = nullptr; // nullptr -> ThreadPool::global()
+    size_t grain = 1 << 14;
+
+    ThreadPool& get_pool() const  {return pool ? *pool : ThreadPool::global();}
+};
+
+
+template <typename It, typename F>
+void parallel_for_each(It first, It last, F f, const ParallelConfig& config = {})  {
+    size_t n = static_cast<size_t>(last - first);
+    config.get_pool().parallel_for(0, n, config.grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)  {
+            f(*(first + i));
+        }
+    });
+}
+
+template <typename It, typename OutIt, typename UnaryOp>
+OutIt parallel_transform(It first, It last, OutIt d_first, UnaryOp op, const ParallelConfig& config = {})  {
+    size_t n = static_cast<size_t>(last - first);
+    config.get_pool().parallel_for(0, n, config.grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)  {
+            *(d_first + i) = op(*(first + i));
+        }
+    });
+    return d_first + n;
+}
+
+template <typename It, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce(It first, It last, T init, BinaryOp op = BinaryOp(), const ParallelConfig& config = {})  {
+    size_t n = static_cast<size_t>(last - first);
+    if (n == 0) return init;
+    size_t grain = config.grain ? config.grain : 1;
+    size_t num_chunks = (n + grain - 1) / grain;
+
+    // one partial per chunk, seeded w/ the chunk's first elem so op needs no identity
+    Array<T> partials(num_chunks, static_cast<T>(*first));
+    config.get_pool().parallel_for(0, n, grain, [&](size_t begin, size_t end) {
+        T acc = static_cast<T>(*(first + begin));
+        for (size_t i = begin + 1; i < end; ++i)  {
+            acc = op(std::move(acc), *(first + i));
+        }
+        partials[begin / grain] = std::move(acc);
+    });
+
+    for (size_t c = 0; c < num_chunks; ++c)  { // fixed order: deterministic
+        init = op(std::move(init), std::move(partials[c]));
+    }
+    return init;
+}
+
+/*
+Scans run in 3 phases over grain sized chunks:
+1. (parallel) reduce every chunk but the last
+2. (serial)   exclusive scan of the chunk totals -> each chunk's carry-in
+3. (parallel) scan every chunk starting from its carry-in
+Each elem is thus read twice, yet both parallel phases scale w/ the cores.
+In place use (d_first == first) is allowed.
+*/
+template <typename It, typename OutIt, typename BinaryOp = std::plus<>>
+OutIt parallel_inclusive_scan(It first, It last, OutIt d_first, BinaryOp op = BinaryOp(), const ParallelConfig& config = {})  {
+    using T = typename std::iterator_traits<It>::value_type;
+    size_t n = static_cast<size_t>(last - first);
+    if (n == 0) return d_first;
+    size_t grain = config.grain ? config.grain : 1;
+    size_t num_chunks = (n + grain - 1) / grain;
+    ThreadPool& pool = config.get_pool();
+
+    Array<T> carry(num_chunks, static_cast<T>(*first));
+    pool.parallel_for(0, (num_chunks - 1) * grain, grain, [&](size_t begin, size_t end) { // the last chunk's total is never needed
+        T acc = *(first + begin);
+        for (size_t i = begin + 1; i < end; ++i)  {
+            acc = op(std::move(acc), *(first + i));
+        }
+        carry[begin / grain + 1] = std::move(acc); // stash chunk c's total in slot c + 1
+    });
+    for (size_t c = 2; c < num_chunks; ++c)  {
+        carry[c] = op(carry[c - 1], carry[c]); // turn totals into carry-ins; slot 0 is unused
+    }
+
+    pool.parallel_for(0, n, grain, [&](size_t begin, size_t end) {
+        size_t c = begin / grain;
+        T acc = c == 0 ? static_cast<T>(*(first + begin)) : op(carry[c], *(first + begin));
+        *(d_first + begin) = acc;
+        for (size_t i = begin + 1; i < end; ++i)  {
+            acc = op(std::move(acc), *(first + i));
+            *(d_first + i) = acc;
+        }
+    });
+    return d_first + n;
+}
+
+template <typename It, typename OutIt, typename T, typename BinaryOp = std::plus<>>
+OutIt parallel_exclusive_scan(It first, It last, OutIt d_first, T init, BinaryOp op = BinaryOp(), const ParallelConfig& config = {})  {
+    size_t n = static_cast<size_t>(last - first);
+    if (n == 0) return d_first;
+    size_t grain = config.grain ? config.grain : 1;
+    size_t num_chunks = (n + grain - 1) / grain;
+    ThreadPool& pool = config.get_pool();
+
+    Array<T> carry(num_chunks, init);
+    pool.parallel_for(0, (num_chunks - 1) * grain, grain, [&](size_t begin, size_t end) { // the last chunk's total is never needed
+        T acc = static_cast<T>(*(first + begin));
+        for (size_t i = begin + 1; i < end; ++i)  {
+            acc = op(std::move(acc), *(first + i));
+        }
+        carry[begin / grain + 1] = std::move(acc);
+    });
+    for (size_t c = 1; c < num_chunks; ++c)  {
+        carry[c] = op(carry[c - 1], carry[c]); // slot 0 holds init
+    }
+
+    pool.parallel_for(0, n, grain, [&](size_t begin, size_t end) {
+        T acc = carry[begin / grain];
+        for (size_t i = begin; i < end; ++i)  {
+            T next = op(acc, *(first + i)); // read before writing: d_first may alias first
+            *(d_first + i) = std::move(acc);
+            acc = std::move(next);
+        }
+    });
+    return d_first + n;
+}
+
+
+/*
+Parallel merge sort:
+1. Move the elems into a scratch buffer and sort grain sized runs there in parallel (std::sort / std::stable_sort).
+2. Merge pairs of runs level by level, ping-ponging between buffer and arr, until one run is left.
+   Within a level the OUTPUT is cut into grain sized pieces, and every piece finds its inputs by binary search
+   (the co-rank / merge path partitioning), so even the last level w/ a single merge runs on all cores. The searches
+   run up front on the calling thread (n / grain of them, O(log n) each), so a throwing comp stops a level before
+   anything moved or after every piece is placed.
+3. If the result ended up in the buffer, move it back.
+
+Ties are always taken from the left run, so merging preserves the order of equal elems, hence stable_sort is stable.
+Extra mem: n elems.
+
+If comp throws, the exception is rethrown once every task is done, w/ all the elems back in [first, last) in an
+unspecified order. std::sort may lose the elem it holds aside when comp throws, so unless comp is noexcept a run is
+sorted through ptrs first and only moved into the buffer once sorted; a merge piece whose comp threw still moves its
+remaining inputs to its output, so a pass never leaves an elem behind. A throwing move may lose the elems it was moving.
+*/
+
+// Num of elems the first k outputs of stable merge(a[0, na), b[0, nb)) take from a
+template <typename T, typename Compare>
+size_t merge_co_rank(size_t k, const T* a, size_t na, const T* b, size_t nb, Compare& comp)  {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = std::min(k, na);
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+        if (j > 0 && !comp(b[j - 1], a[i])) { // a[i] <= b[j - 1]: a[i] is output before b[j - 1], so more than i come from a
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+// Scratch buffer of the merge sort: destroys the runs moved in & frees the mem, also when unwinding
+template <typename T>
+struct SortBuffer {
+    Array<bool> moved; // moved[r]: run r (elems [r * grain, (r + 1) * grain)) was moved in
+    std::allocator<T> alloc;
+    size_t n, grain;
+    T* data;
+
+    SortBuffer(size_t n, size_t grain) : moved((n + grain - 1) / grain, false), n(n), grain(grain), data(alloc.allocate(n)) {}
+    SortBuffer(const SortBuffer&) = delete;
+    SortBuffer& operator=(const SortBuffer&) = delete;
+    ~SortBuffer()  {
+        for (size_t r = 0; r < moved.size(); ++r)  {
+            if (moved[r]) std::destroy(data + r * grain, data + std::min(n, (r + 1) * grain));
+        }
+        alloc.deallocate(data, n);
+    }
+};
+
+// Moves run [first, last) into out sorted, or (comp threw) leaves it untouched
+template <bool Stable, typename T, typename Compare>
+void sort_run_into(T* first, T* last, T* out, Compare& comp)  {
+    if constexpr (std::is_nothrow_invocable_v<Compare&, const T&, const T&>) {
+        std::uninitialized_move(first, last, out);
+        if constexpr (Stable) std::stable_sort(out, out + (last - first), comp);
+        else std::sort(out, out + (last - first), comp);
+    } else {
+        Array<T*> order;
+        order.reserve(static_cast<size_t>(last - first));
+        for (T* it = first; it != last; ++it) order.push_back(it);
+        auto by_elem = [&comp](const T* a, const T* b) {return comp(*a, *b);};
+        if constexpr (Stable) std::stable_sort(order.begin(), order.end(), by_elem);
+        else std::sort(order.begin(), order.end(), by_elem);
+        size_t built = 0;
+        try {
+            for (; built < order.size(); ++built) std::construct_at(out + built, std::move(*order[built]));
+        } catch (...) {
+            std::destroy(out, out + built);
+            throw;
+        }
+    }
+}
+
+// Every elem of src ends up in dst, even when comp throws (then unsorted)
+template <typename T, typename Compare>
+void merge_pass(T* src, T* dst, size_t n, size_t width, Compare& comp, const ParallelConfig& config)  {
+    size_t grain = config.grain ? config.grain : 1;
+    auto pair_of = [&](size_t pos) {
+        size_t pair_begin = pos - pos % (2 * width);
+        return std::pair{pair_begin, std::min(pair_begin + width, n)};
+    };
+
+    // co-rank of every piece start, before anything moves: if comp throws here, src is moved over as is
+    Array<size_t> splits((n + grain - 1) / grain, 0);
+    try {
+        for (size_t p = 0; p < splits.size(); ++p)  {
+            auto [pair_begin, mid] = pair_of(p * grain);
+            size_t pair_end = std::min(pair_begin + 2 * width, n);
+            splits[p] = merge_co_rank(p * grain - pair_begin, src + pair_begin, mid - pair_begin, src + mid, pair_end - mid, comp);
+        }
+    } catch (...) {
+        std::move(src, src + n, dst);
+        throw;
+    }
+
+    config.get_pool().parallel_for(0, n, grain, [&](size_t begin, size_t end) {
+        // output piece [begin, end) may span several run pairs: handle each overlap separately
+        size_t pos = begin;
+        while (pos < end) {
+            auto [pair_begin, mid] = pair_of(pos);
+            size_t pair_end = std::min(pair_begin + 2 * width, n);
+            size_t seg_end = std::min(end, pair_end);
+
+            // a segment starts at the piece start or at a pair start, and ends at the piece end or at a pair end
+            size_t k0 = pos - pair_begin, k1 = seg_end - pair_begin;
+            size_t i0 = pos == begin ? splits[begin / grain] : 0;
+            size_t i1 = seg_end == pair_end ? mid - pair_begin : splits[end / grain];
+
+            T* a_it = src + pair_begin + i0;
+            T* a_end = src + pair_begin + i1;
+            T* b_it = src + mid + (k0 - i0);
+            T* b_end = src + mid + (k1 - i1);
+            T* out = dst + pos;
+            try {
+                while (a_it != a_end && b_it != b_end) {
+                    if (comp(*b_it, *a_it)) *out++ = std::move(*b_it++);
+                    else *out++ = std::move(*a_it++);
+                }
+            } catch (...) {
+                std::move(b_it, b_end, std::move(a_it, a_end, out)); // unsorted, but every input reaches dst
+                throw;
+            }
+            std::move(b_it, b_end, std::move(a_it, a_end, out));
+            pos = seg_end;
+        }
+    });
+}
+
+template <bool Stable, typename It, typename Compare>
+void parallel_merge_sort(It first, It last, Compare comp, const ParallelConfig& config)  {
+    using T = typename std::iterator_traits<It>::value_type;
+    size_t n = static_cast<size_t>(last - first);
+    if (n < 2) return;
+    size_t grain = std::max<size_t>(config.grain, 2);
+    T* data = std::addressof(*first); // contiguous storage required
+
+    // a single run: nothing to parallelize (a comp that may throw still goes through the buffer, see above)
+    if (n <= grain && std::is_nothrow_invocable_v<Compare&, const T&, const T&>) {
+        if constexpr (Stable) std::stable_sort(data, data + n, comp);
+        else std::sort(data, data + n, comp);
+        return;
+    }
+
+    ThreadPool& pool = config.get_pool();
+    ParallelConfig merge_config{&pool, grain};
+
+    SortBuffer<T> scratch(n, grain);
+    T* buffer = scratch.data;
+    // phase 1: move into the buffer and sort the runs there, one task per run
+    try {
+        pool.parallel_for(0, n, grain, [&](size_t begin, size_t end) {
+            sort_run_into<Stable>(data + begin, data + end, buffer + begin, comp);
+            scratch.moved[begin / grain] = true;
+        });
+    } catch (...) {
+        for (size_t r = 0; r < scratch.moved.size(); ++r)  { // the runs not moved in are still in arr, untouched
+            size_t begin = r * grain, end = std::min(n, begin + grain);
+            if (scratch.moved[r]) std::move(buffer + begin, buffer + end, data + begin);
+        }
+        throw;
+    }
+
+    // phase 2: merge levels
+    T* src = buffer;
+    T* dst = data;
+    try {
+        for (size_t width = grain; width < n; width *= 2)  {
+            merge_pass(src, dst, n, width, comp, merge_config);
+            std::swap(src, dst);
+        }
+    } catch (...) {
+        if (dst == buffer) std::move(buffer, buffer + n, data); // the failed pass still moved every elem to dst
+        throw;
+    }
+
+    // phase 3: src holds the result
+    if (src == buffer) {
+        pool.parallel_for(0, n, grain, [&](size_t begin, size_t end) {
+            std::move(buffer + begin, buffer + end, data + begin);
+        });
+    }
+}
+
+template <typename It, typename Compare = std::less<>>
+void parallel_sort(It first, It last, Compare comp = Compare(), const ParallelConfig& config = {})  {
+    parallel_merge_sort<false>(first, last, comp, config);
+}
+
+template <typename It, typename Compare = std::less<>>
+void parallel_stable_sort(It first, It last, Compare comp = Compare(), const ParallelConfig& config = {})  {
+    parallel_merge_sort<true>(first, last, comp, config);
+}
+
+
+#endif // __ARRAY_ARRAYPARALLEL_HPP
@@ -0,0 +1,864 @@
+#ifndef __ARRAY_ARRAYSIMD_HPP
+#define __ARRAY_ARRAYSIMD_HPP
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <bit>
+#include "./Array.hpp"
+
+/*
+Vectorized search & reduction kernels for arithmetic arrs.
+
+Kernels (all on a raw (ptr, n) range, plus overloads taking an Array):
+- simd_find(data, n, x)              idx of first elem == x, n if absent
+- simd_count(data, n, x)             num of elems == x
+- simd_min / simd_max(data, n)       smallest / largest elem, n must be > 0
+- simd_argmin / simd_argmax(data, n) idx of the first smallest / largest elem
+- simd_sum(data, n)                  sum, accumulated in int64_t / uint64_t / double (see SimdSum)
+- simd_compare_mask(data, n, op, x, out)
+                                     bit i of out[i / 64] := (data[i] op x), return num of set bits.
+                                     out must hold (n + 63) / 64 words.
+
+Dispatch:
+The ISA is picked at runtime (cpuid through __builtin_cpu_supports), so one binary runs everywhere:
+    AVX-512F  -> 16 x 32-bit / 8 x 64-bit lanes
+    AVX2      -> 8 x 32-bit / 4 x 64-bit lanes
+    otherwise -> plain scalar loops
+SIMD paths exist for 32/64-bit integers (signed & unsigned), float and double. Any other arithmetic type
+(char, short, long double, ...) always takes the scalar path.
+simd_set_level() lowers the level at runtime, e.g. for testing the fallbacks or benchmarking.
+
+The SIMD functions are compiled w/ the target attribute, so no -mavx2 / -mavx512f flags are needed, and they are only
+ever called after the cpuid check. Only GCC & Clang on x86-64 get SIMD paths, other compilers get the scalar ones.
+
+Floating point notes:
+- Comparisons follow the scalar C++ operators, incl. NaN (NaN != x is true, every other comparison is false).
+- min/max on ranges containing NaN are unspecified.
+- simd_sum adds in lane order, so the result may differ from a sequential scalar sum in the last bits,
+  and between ISA levels. For a given machine & level it is deterministic.
+*/
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define ARRAY_SIMD_X86 1
+#include <immintrin.h>
+#define ARRAY_SIMD_AVX2 __attribute__((target("avx2,popcnt")))
+#define ARRAY_SIMD_AVX512 __attribute__((target("avx512f,avx2,popcnt")))
+#else
+#define ARRAY_SIMD_X86 0
+#endif
+
+
+enum class SimdLevel { Scalar = 0, AVX2 = 1, AVX512 = 2 };
+
+enum class CmpOp { EQ, NE, LT, LE, GT, GE };
+
+inline SimdLevel simd_detect()  {
+#if ARRAY_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+inline SimdLevel& simd_active_level()  {
+    static SimdLevel level = simd_detect(); // detected once, on first use
+    return level;
+}
+
+inline SimdLevel simd_level()  {return simd_active_level();}
+
+// Select a level for all following kernel calls. Levels above what the cpu supports are clamped down.
+inline void simd_set_level(SimdLevel level)  {
+    SimdLevel max_level = simd_detect();
+    simd_active_level() = static_cast<int>(level) > static_cast<int>(max_level) ? max_level : level;
+}
+
+// Accumulator type of simd_sum: wide enough that summing 32-bit elems does not overflow in practice
+template <typename T>
+using SimdSum = std::conditional_t<std::is_floating_point_v<T>, double,
+                std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+
+// ----------------------------------------------------------------------------------------------------------------
+// Scalar kernels: the reference semantics, the fallback, and the tails of the SIMD loops
+
+template <typename T>
+bool simd_scalar_cmp(T a, T b, CmpOp op)  {
+    switch (op) {
+        case CmpOp::EQ: return a == b;
+        case CmpOp::NE: return a != b;
+        case CmpOp::LT: return a < b;
+        case CmpOp::LE: return a <= b;
+        case CmpOp::GT: return a > b;
+        case CmpOp::GE: return a >= b;
+    }
+    return false;
+}
+
+template <typename T>
+size_t scalar_find(const T* p, size_t n, T x, size_t i = 0)  {
+    for (; i < n; ++i)  {
+        if (p[i] == x) return i;
+    }
+    return n;
+}
+
+template <typename T>
+size_t scalar_count(const T* p, size_t n, T x, size_t i = 0)  {
+    size_t count = 0;
+    for (; i < n; ++i)  {
+        count += (p[i] == x);
+    }
+    return count;
+}
+
+template <typename T>
+void scalar_minmax(const T* p, size_t n, T& lo, T& hi, size_t i = 0)  {
+    for (; i < n; ++i)  {
+        if (p[i] < lo) lo = p[i];
+        if (hi < p[i]) hi = p[i];
+    }
+}
+
+template <typename T>
+SimdSum<T> scalar_sum(const T* p, size_t n, size_t i = 0)  {
+    if constexpr (std::is_floating_point_v<T>) {
+        double sum = 0;
+        for (; i < n; ++i) sum += p[i];
+        return sum;
+    } else {
+        uint64_t sum = 0; // unsigned: wraps instead of signed overflow UB, same as the SIMD lanes
+        for (; i < n; ++i) sum += static_cast<uint64_t>(static_cast<SimdSum<T>>(p[i]));
+        return static_cast<SimdSum<T>>(sum);
+    }
+}
+
+template <typename T>
+size_t scalar_compare_mask(const T* p, size_t n, CmpOp op, T x, uint64_t* out, size_t i = 0)  {
+    // Precondition: the words covering [i, n) are zeroed
+    size_t count = 0;
+    for (; i < n; ++i)  {
+        if (simd_scalar_cmp(p[i], x, op)) {
+            out[i / 64] |= uint64_t(1) << (i % 64);
+            ++count;
+        }
+    }
+    return count;
+}
+
+
+#if ARRAY_SIMD_X86
+
+/*
+Ops: one struct per (ISA, lane type), wrapping the intrinsics behind a common interface so the kernels can be written once
+per ISA:
+
+    S                 lane type
+    V                 vector type
+    W                 num of lanes
+    load(ptr)         unaligned load of W lanes
+    store(S*, V)
+    set1(x)           broadcast
+    cmp(a, b, op)     lane wise a op b, as a W bit mask (bit j <-> lane j)
+    min(a, b), max(a, b)
+    sum(ptr, n)       sum of the first n lanes (n a multiple of W) in SimdSum precision
+
+The kernels only touch elem mem through load(), so T (e.g. long long) need not be the exact same type as S (long).
+*/
+
+// AVX2 integer compares only come as == and signed >, the others are derived from those two
+template <typename Ops>
+ARRAY_SIMD_AVX2 inline uint32_t avx2_int_cmp(typename Ops::V a, typename Ops::V b, CmpOp op)  {
+    constexpr uint32_t full = (1u << Ops::W) - 1;
+    switch (op) {
+        case CmpOp::EQ: return Ops::eq(a, b);
+        case CmpOp::NE: return ~Ops::eq(a, b) & full;
+        case CmpOp::LT: return Ops::gt(b, a);
+        case CmpOp::LE: return ~Ops::gt(a, b) & full;
+        case CmpOp::GT: return Ops::gt(a, b);
+        case CmpOp::GE: return ~Ops::gt(b, a) & full;
+    }
+    return 0;
+}
+
+struct Avx2I32 {
+    using S = int32_t;
+    using V = __m256i;
+    static constexpr size_t W = 8;
+
+    ARRAY_SIMD_AVX2 static V load(const void* p)  {return _mm256_loadu_si256(static_cast<const __m256i*>(p));}
+    ARRAY_SIMD_AVX2 static void store(S* p, V v)  {_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);}
+    ARRAY_SIMD_AVX2 static V set1(S x)  {return _mm256_set1_epi32(x);}
+    ARRAY_SIMD_AVX2 static uint32_t bits(V m)  {return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));}
+    ARRAY_SIMD_AVX2 static uint32_t eq(V a, V b)  {return bits(_mm256_cmpeq_epi32(a, b));}
+    ARRAY_SIMD_AVX2 static uint32_t gt(V a, V b)  {return bits(_mm256_cmpgt_epi32(a, b));}
+    ARRAY_SIMD_AVX2 static uint32_t cmp(V a, V b, CmpOp op)  {return avx2_int_cmp<Avx2I32>(a, b, op);}
+    ARRAY_SIMD_AVX2 static V min(V a, V b)  {return _mm256_min_epi32(a, b);}
+    ARRAY_SIMD_AVX2 static V max(V a, V b)  {return _mm256_max_epi32(a, b);}
+    ARRAY_SIMD_AVX2 static int64_t sum(const void* p, size_t n)  {
+        // widen to 64-bit lanes before adding so that sums of many 32-bit values do not wrap
+        const S* ptr = static_cast<const S*>(p);
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t i = 0; i < n; i += W)  {
+            __m256i v = load(ptr + i);
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        return static_cast<int64_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    }
+};
+
+struct Avx2U32 {
+    using S = uint32_t;
+    using V = __m256i;
+    static constexpr size_t W = 8;
+
+    // flipping the sign bit maps unsigned order onto signed order, for the signed-only cmpgt
+    ARRAY_SIMD_AVX2 static V flip(V a)  {return _mm256_xor_si256(a, _mm256_set1_epi32(INT32_MIN));}
+
+    ARRAY_SIMD_AVX2 static V load(const void* p)  {return _mm256_loadu_si256(static_cast<const __m256i*>(p));}
+    ARRAY_SIMD_AVX2 static void store(S* p, V v)  {_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);}
+    ARRAY_SIMD_AVX2 static V set1(S x)  {return _mm256_set1_epi32(static_cast<int32_t>(x));}
+    ARRAY_SIMD_AVX2 static uint32_t bits(V m)  {return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));}
+    ARRAY_SIMD_AVX2 static uint32_t eq(V a, V b)  {return bits(_mm256_cmpeq_epi32(a, b));}
+    ARRAY_SIMD_AVX2 static uint32_t gt(V a, V b)  {return bits(_mm256_cmpgt_epi32(flip(a), flip(b)));}
+    ARRAY_SIMD_AVX2 static uint32_t cmp(V a, V b, CmpOp op)  {return avx2_int_cmp<Avx2U32>(a, b, op);}
+    ARRAY_SIMD_AVX2 static V min(V a, V b)  {return _mm256_min_epu32(a, b);}
+    ARRAY_SIMD_AVX2 static V max(V a, V b)  {return _mm256_max_epu32(a, b);}
+    ARRAY_SIMD_AVX2 static uint64_t sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t i = 0; i < n; i += W)  {
+            __m256i v = load(ptr + i);
+            acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+};
+
+struct Avx2I64 {
+    using S = int64_t;
+    using V = __m256i;
+    static constexpr size_t W = 4;
+
+    ARRAY_SIMD_AVX2 static V load(const void* p)  {return _mm256_loadu_si256(static_cast<const __m256i*>(p));}
+    ARRAY_SIMD_AVX2 static void store(S* p, V v)  {_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);}
+    ARRAY_SIMD_AVX2 static V set1(S x)  {return _mm256_set1_epi64x(x);}
+    ARRAY_SIMD_AVX2 static uint32_t bits(V m)  {return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));}
+    ARRAY_SIMD_AVX2 static uint32_t eq(V a, V b)  {return bits(_mm256_cmpeq_epi64(a, b));}
+    ARRAY_SIMD_AVX2 static uint32_t gt(V a, V b)  {return bits(_mm256_cmpgt_epi64(a, b));}
+    ARRAY_SIMD_AVX2 static uint32_t cmp(V a, V b, CmpOp op)  {return avx2_int_cmp<Avx2I64>(a, b, op);}
+    // no 64-bit min/max before AVX-512: select through the compare mask
+    ARRAY_SIMD_AVX2 static V min(V a, V b)  {return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));}
+    ARRAY_SIMD_AVX2 static V max(V a, V b)  {return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));}
+    ARRAY_SIMD_AVX2 static int64_t sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm256_add_epi64(acc, load(ptr + i)); // wraps like the scalar uint64_t accumulation
+        }
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        return static_cast<int64_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    }
+};
+
+struct Avx2U64 {
+    using S = uint64_t;
+    using V = __m256i;
+    static constexpr size_t W = 4;
+
+    ARRAY_SIMD_AVX2 static V flip(V a)  {return _mm256_xor_si256(a, _mm256_set1_epi64x(INT64_MIN));}
+    ARRAY_SIMD_AVX2 static V gt_lanes(V a, V b)  {return _mm256_cmpgt_epi64(flip(a), flip(b));}
+
+    ARRAY_SIMD_AVX2 static V load(const void* p)  {return _mm256_loadu_si256(static_cast<const __m256i*>(p));}
+    ARRAY_SIMD_AVX2 static void store(S* p, V v)  {_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);}
+    ARRAY_SIMD_AVX2 static V set1(S x)  {return _mm256_set1_epi64x(static_cast<int64_t>(x));}
+    ARRAY_SIMD_AVX2 static uint32_t bits(V m)  {return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));}
+    ARRAY_SIMD_AVX2 static uint32_t eq(V a, V b)  {return bits(_mm256_cmpeq_epi64(a, b));}
+    ARRAY_SIMD_AVX2 static uint32_t gt(V a, V b)  {return bits(gt_lanes(a, b));}
+    ARRAY_SIMD_AVX2 static uint32_t cmp(V a, V b, CmpOp op)  {return avx2_int_cmp<Avx2U64>(a, b, op);}
+    ARRAY_SIMD_AVX2 static V min(V a, V b)  {return _mm256_blendv_epi8(a, b, gt_lanes(a, b));}
+    ARRAY_SIMD_AVX2 static V max(V a, V b)  {return _mm256_blendv_epi8(b, a, gt_lanes(a, b));}
+    ARRAY_SIMD_AVX2 static uint64_t sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm256_add_epi64(acc, load(ptr + i));
+        }
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+};
+
+struct Avx2F32 {
+    using S = float;
+    using V = __m256;
+    static constexpr size_t W = 8;
+
+    ARRAY_SIMD_AVX2 static V load(const void* p)  {return _mm256_loadu_ps(static_cast<const float*>(p));}
+    ARRAY_SIMD_AVX2 static void store(S* p, V v)  {_mm256_storeu_ps(p, v);}
+    ARRAY_SIMD_AVX2 static V set1(S x)  {return _mm256_set1_ps(x);}
+    ARRAY_SIMD_AVX2 static uint32_t cmp(V a, V b, CmpOp op)  {
+        // ordered predicates (false on NaN) except NE, which is unordered like the scalar !=
+        switch (op) {
+            case CmpOp::EQ: return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+            case CmpOp::NE: return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)));
+            case CmpOp::LT: return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)));
+            case CmpOp::LE: return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)));
+            case CmpOp::GT: return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)));
+            case CmpOp::GE: return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ)));
+        }
+        return 0;
+    }
+    ARRAY_SIMD_AVX2 static V min(V a, V b)  {return _mm256_min_ps(a, b);}
+    ARRAY_SIMD_AVX2 static V max(V a, V b)  {return _mm256_max_ps(a, b);}
+    ARRAY_SIMD_AVX2 static double sum(const void* p, size_t n)  {
+        // accumulate in double, as the scalar path does
+        const S* ptr = static_cast<const S*>(p);
+        __m256d acc = _mm256_setzero_pd();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(ptr + i)));
+            acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(ptr + i + 4)));
+        }
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, acc);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+
+struct Avx2F64 {
+    using S = double;
+    using V = __m256d;
+    static constexpr size_t W = 4;
+
+    ARRAY_SIMD_AVX2 static V load(const void* p)  {return _mm256_loadu_pd(static_cast<const double*>(p));}
+    ARRAY_SIMD_AVX2 static void store(S* p, V v)  {_mm256_storeu_pd(p, v);}
+    ARRAY_SIMD_AVX2 static V set1(S x)  {return _mm256_set1_pd(x);}
+    ARRAY_SIMD_AVX2 static uint32_t cmp(V a, V b, CmpOp op)  {
+        switch (op) {
+            case CmpOp::EQ: return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+            case CmpOp::NE: return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ)));
+            case CmpOp::LT: return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)));
+            case CmpOp::LE: return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ)));
+            case CmpOp::GT: return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)));
+            case CmpOp::GE: return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GE_OQ)));
+        }
+        return 0;
+    }
+    ARRAY_SIMD_AVX2 static V min(V a, V b)  {return _mm256_min_pd(a, b);}
+    ARRAY_SIMD_AVX2 static V max(V a, V b)  {return _mm256_max_pd(a, b);}
+    ARRAY_SIMD_AVX2 static double sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m256d acc = _mm256_setzero_pd();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm256_add_pd(acc, load(ptr + i));
+        }
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, acc);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+
+
+// AVX-512 compares write straight into mask registers and support every predicate, signed & unsigned
+struct Avx512I32 {
+    using S = int32_t;
+    using V = __m512i;
+    static constexpr size_t W = 16;
+
+    ARRAY_SIMD_AVX512 static V load(const void* p)  {return _mm512_loadu_si512(p);}
+    ARRAY_SIMD_AVX512 static void store(S* p, V v)  {_mm512_storeu_si512(p, v);}
+    ARRAY_SIMD_AVX512 static V set1(S x)  {return _mm512_set1_epi32(x);}
+    ARRAY_SIMD_AVX512 static uint32_t cmp(V a, V b, CmpOp op)  {
+        switch (op) {
+            case CmpOp::EQ: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_EQ);
+            case CmpOp::NE: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NE);
+            case CmpOp::LT: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LT);
+            case CmpOp::LE: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LE);
+            case CmpOp::GT: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NLE);
+            case CmpOp::GE: return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NLT);
+        }
+        return 0;
+    }
+    ARRAY_SIMD_AVX512 static V min(V a, V b)  {return _mm512_min_epi32(a, b);}
+    ARRAY_SIMD_AVX512 static V max(V a, V b)  {return _mm512_max_epi32(a, b);}
+    ARRAY_SIMD_AVX512 static int64_t sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m512i acc = _mm512_setzero_si512();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i))));
+            acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i + 8))));
+        }
+        return _mm512_reduce_add_epi64(acc);
+    }
+};
+
+struct Avx512U32 {
+    using S = uint32_t;
+    using V = __m512i;
+    static constexpr size_t W = 16;
+
+    ARRAY_SIMD_AVX512 static V load(const void* p)  {return _mm512_loadu_si512(p);}
+    ARRAY_SIMD_AVX512 static void store(S* p, V v)  {_mm512_storeu_si512(p, v);}
+    ARRAY_SIMD_AVX512 static V set1(S x)  {return _mm512_set1_epi32(static_cast<int32_t>(x));}
+    ARRAY_SIMD_AVX512 static uint32_t cmp(V a, V b, CmpOp op)  {
+        switch (op) {
+            case CmpOp::EQ: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_EQ);
+            case CmpOp::NE: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_NE);
+            case CmpOp::LT: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_LT);
+            case CmpOp::LE: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_LE);
+            case CmpOp::GT: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_NLE);
+            case CmpOp::GE: return _mm512_cmp_epu32_mask(a, b, _MM_CMPINT_NLT);
+        }
+        return 0;
+    }
+    ARRAY_SIMD_AVX512 static V min(V a, V b)  {return _mm512_min_epu32(a, b);}
+    ARRAY_SIMD_AVX512 static V max(V a, V b)  {return _mm512_max_epu32(a, b);}
+    ARRAY_SIMD_AVX512 static uint64_t sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m512i acc = _mm512_setzero_si512();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm512_add_epi64(acc, _mm512_cvtepu32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i))));
+            acc = _mm512_add_epi64(acc, _mm512_cvtepu32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i + 8))));
+        }
+        return static_cast<uint64_t>(_mm512_reduce_add_epi64(acc));
+    }
+};
+
+struct Avx512I64 {
+    using S = int64_t;
+    using V = __m512i;
+    static constexpr size_t W = 8;
+
+    ARRAY_SIMD_AVX512 static V load(const void* p)  {return _mm512_loadu_si512(p);}
+    ARRAY_SIMD_AVX512 static void store(S* p, V v)  {_mm512_storeu_si512(p, v);}
+    ARRAY_SIMD_AVX512 static V set1(S x)  {return _mm512_set1_epi64(x);}
+    ARRAY_SIMD_AVX512 static uint32_t cmp(V a, V b, CmpOp op)  {
+        switch (op) {
+            case CmpOp::EQ: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_EQ);
+            case CmpOp::NE: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NE);
+            case CmpOp::LT: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_LT);
+            case CmpOp::LE: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_LE);
+            case CmpOp::GT: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NLE);
+            case CmpOp::GE: return _mm512_cmp_epi64_mask(a, b, _MM_CMPINT_NLT);
+        }
+        return 0;
+    }
+    ARRAY_SIMD_AVX512 static V min(V a, V b)  {return _mm512_min_epi64(a, b);}
+    ARRAY_SIMD_AVX512 static V max(V a, V b)  {return _mm512_max_epi64(a, b);}
+    ARRAY_SIMD_AVX512 static int64_t sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m512i acc = _mm512_setzero_si512();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm512_add_epi64(acc, load(ptr + i));
+        }
+        return _mm512_reduce_add_epi64(acc);
+    }
+};
+
+struct Avx512U64 {
+    using S = uint64_t;
+    using V = __m512i;
+    static constexpr size_t W = 8;
+
+    ARRAY_SIMD_AVX512 static V load(const void* p)  {return _mm512_loadu_si512(p);}
+    ARRAY_SIMD_AVX512 static void store(S* p, V v)  {_mm512_storeu_si512(p, v);}
+    ARRAY_SIMD_AVX512 static V set1(S x)  {return _mm512_set1_epi64(static_cast<int64_t>(x));}
+    ARRAY_SIMD_AVX512 static uint32_t cmp(V a, V b, CmpOp op)  {
+        switch (op) {
+            case CmpOp::EQ: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_EQ);
+            case CmpOp::NE: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_NE);
+            case CmpOp::LT: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_LT);
+            case CmpOp::LE: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_LE);
+            case CmpOp::GT: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_NLE);
+            case CmpOp::GE: return _mm512_cmp_epu64_mask(a, b, _MM_CMPINT_NLT);
+        }
+        return 0;
+    }
+    ARRAY_SIMD_AVX512 static V min(V a, V b)  {return _mm512_min_epu64(a, b);}
+    ARRAY_SIMD_AVX512 static V max(V a, V b)  {return _mm512_max_epu64(a, b);}
+    ARRAY_SIMD_AVX512 static uint64_t sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m512i acc = _mm512_setzero_si512();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm512_add_epi64(acc, load(ptr + i));
+        }
+        return static_cast<uint64_t>(_mm512_reduce_add_epi64(acc));
+    }
+};
+
+struct Avx512F32 {
+    using S = float;
+    using V = __m512;
+    static constexpr size_t W = 16;
+
+    ARRAY_SIMD_AVX512 static V load(const void* p)  {return _mm512_loadu_ps(p);}
+    ARRAY_SIMD_AVX512 static void store(S* p, V v)  {_mm512_storeu_ps(p, v);}
+    ARRAY_SIMD_AVX512 static V set1(S x)  {return _mm512_set1_ps(x);}
+    ARRAY_SIMD_AVX512 static uint32_t cmp(V a, V b, CmpOp op)  {
+        switch (op) {
+            case CmpOp::EQ: return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+            case CmpOp::NE: return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ);
+            case CmpOp::LT: return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+            case CmpOp::LE: return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+            case CmpOp::GT: return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+            case CmpOp::GE: return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+        }
+        return 0;
+    }
+    ARRAY_SIMD_AVX512 static V min(V a, V b)  {return _mm512_min_ps(a, b);}
+    ARRAY_SIMD_AVX512 static V max(V a, V b)  {return _mm512_max_ps(a, b);}
+    ARRAY_SIMD_AVX512 static double sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m512d acc = _mm512_setzero_pd();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm512_add_pd(acc, _mm512_cvtps_pd(_mm256_loadu_ps(ptr + i)));
+            acc = _mm512_add_pd(acc, _mm512_cvtps_pd(_mm256_loadu_ps(ptr + i + 8)));
+        }
+        return _mm512_reduce_add_pd(acc);
+    }
+};
+
+struct Avx512F64 {
+    using S = double;
+    using V = __m512d;
+    static constexpr size_t W = 8;
+
+    ARRAY_SIMD_AVX512 static V load(const void* p)  {return _mm512_loadu_pd(p);}
+    ARRAY_SIMD_AVX512 static void store(S* p, V v)  {_mm512_storeu_pd(p, v);}
+    ARRAY_SIMD_AVX512 static V set1(S x)  {return _mm512_set1_pd(x);}
+    ARRAY_SIMD_AVX512 static uint32_t cmp(V a, V b, CmpOp op)  {
+        switch (op) {
+            case CmpOp::EQ: return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+            case CmpOp::NE: return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ);
+            case CmpOp::LT: return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+            case CmpOp::LE: return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+            case CmpOp::GT: return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+            case CmpOp::GE: return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+        }
+        return 0;
+    }
+    ARRAY_SIMD_AVX512 static V min(V a, V b)  {return _mm512_min_pd(a, b);}
+    ARRAY_SIMD_AVX512 static V max(V a, V b)  {return _mm512_max_pd(a, b);}
+    ARRAY_SIMD_AVX512 static double sum(const void* p, size_t n)  {
+        const S* ptr = static_cast<const S*>(p);
+        __m512d acc = _mm512_setzero_pd();
+        for (size_t i = 0; i < n; i += W)  {
+            acc = _mm512_add_pd(acc, load(ptr + i));
+        }
+        return _mm512_reduce_add_pd(acc);
+    }
+};
+
+
+/*
+Kernels, written once against the Ops interface. Each ISA gets its own copy, since a function must carry the target
+attribute of the intrinsics it inlines -- and must NOT carry a wider one, or the compiler is free to emit AVX-512 code
+into what is supposed to be the AVX2 path.
+*/
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX2 inline size_t avx2_find(const T* p, size_t n, T x)  {
+    const auto vx = Ops::set1(static_cast<typename Ops::S>(x));
+    size_t i = 0;
+    for (; i + Ops::W <= n; i += Ops::W)  {
+        if (uint32_t m = Ops::cmp(Ops::load(p + i), vx, CmpOp::EQ)) return i + std::countr_zero(m); // lowest set lane is the first hit
+    }
+    return scalar_find(p, n, x, i);
+}
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX2 inline size_t avx2_count(const T* p, size_t n, T x)  {
+    const auto vx = Ops::set1(static_cast<typename Ops::S>(x));
+    size_t count = 0, i = 0;
+    for (; i + Ops::W <= n; i += Ops::W)  {
+        count += std::popcount(Ops::cmp(Ops::load(p + i), vx, CmpOp::EQ));
+    }
+    return count + scalar_count(p, n, x, i);
+}
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX2 inline void avx2_minmax(const T* p, size_t n, T& lo, T& hi)  {
+    // Precondition: n > 0
+    size_t i = 0;
+    lo = hi = p[0];
+    if (n >= Ops::W) {
+        auto vlo = Ops::load(p), vhi = vlo;
+        for (i = Ops::W; i + Ops::W <= n; i += Ops::W)  {
+            auto v = Ops::load(p + i);
+            vlo = Ops::min(vlo, v);
+            vhi = Ops::max(vhi, v);
+        }
+        typename Ops::S lanes_lo[Ops::W], lanes_hi[Ops::W];
+        Ops::store(lanes_lo, vlo);
+        Ops::store(lanes_hi, vhi);
+        for (size_t j = 0; j < Ops::W; ++j)  {
+            if (static_cast<T>(lanes_lo[j]) < lo) lo = static_cast<T>(lanes_lo[j]);
+            if (hi < static_cast<T>(lanes_hi[j])) hi = static_cast<T>(lanes_hi[j]);
+        }
+    }
+    scalar_minmax(p, n, lo, hi, i);
+}
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX2 inline SimdSum<T> avx2_sum(const T* p, size_t n)  {
+    size_t full = n - n % Ops::W;
+    SimdSum<T> sum = static_cast<SimdSum<T>>(Ops::sum(p, full));
+    if constexpr (std::is_floating_point_v<T>) {
+        return sum + scalar_sum(p, n, full);
+    } else {
+        return static_cast<SimdSum<T>>(static_cast<uint64_t>(sum) + static_cast<uint64_t>(scalar_sum(p, n, full)));
+    }
+}
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX2 inline size_t avx2_compare_mask(const T* p, size_t n, CmpOp op, T x, uint64_t* out)  {
+    // W divides 64 and i is a multiple of W, so a block's mask never straddles 2 words
+    const auto vx = Ops::set1(static_cast<typename Ops::S>(x));
+    size_t count = 0, i = 0;
+    for (; i + Ops::W <= n; i += Ops::W)  {
+        uint64_t m = Ops::cmp(Ops::load(p + i), vx, op);
+        out[i / 64] |= m << (i % 64);
+        count += std::popcount(m);
+    }
+    return count + scalar_compare_mask(p, n, op, x, out, i);
+}
+
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX512 inline size_t avx512_find(const T* p, size_t n, T x)  {
+    const auto vx = Ops::set1(static_cast<typename Ops::S>(x));
+    size_t i = 0;
+    for (; i + Ops::W <= n; i += Ops::W)  {
+        if (uint32_t m = Ops::cmp(Ops::load(p + i), vx, CmpOp::EQ)) return i + std::countr_zero(m);
+    }
+    return scalar_find(p, n, x, i);
+}
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX512 inline size_t avx512_count(const T* p, size_t n, T x)  {
+    const auto vx = Ops::set1(static_cast<typename Ops::S>(x));
+    size_t count = 0, i = 0;
+    for (; i + Ops::W <= n; i += Ops::W)  {
+        count += std::popcount(Ops::cmp(Ops::load(p + i), vx, CmpOp::EQ));
+    }
+    return count + scalar_count(p, n, x, i);
+}
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX512 inline void avx512_minmax(const T* p, size_t n, T& lo, T& hi)  {
+    size_t i = 0;
+    lo = hi = p[0];
+    if (n >= Ops::W) {
+        auto vlo = Ops::load(p), vhi = vlo;
+        for (i = Ops::W; i + Ops::W <= n; i += Ops::W)  {
+            auto v = Ops::load(p + i);
+            vlo = Ops::min(vlo, v);
+            vhi = Ops::max(vhi, v);
+        }
+        typename Ops::S lanes_lo[Ops::W], lanes_hi[Ops::W];
+        Ops::store(lanes_lo, vlo);
+        Ops::store(lanes_hi, vhi);
+        for (size_t j = 0; j < Ops::W; ++j)  {
+            if (static_cast<T>(lanes_lo[j]) < lo) lo = static_cast<T>(lanes_lo[j]);
+            if (hi < static_cast<T>(lanes_hi[j])) hi = static_cast<T>(lanes_hi[j]);
+        }
+    }
+    scalar_minmax(p, n, lo, hi, i);
+}
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX512 inline SimdSum<T> avx512_sum(const T* p, size_t n)  {
+    size_t full = n - n % Ops::W;
+    SimdSum<T> sum = static_cast<SimdSum<T>>(Ops::sum(p, full));
+    if constexpr (std::is_floating_point_v<T>) {
+        return sum + scalar_sum(p, n, full);
+    } else {
+        return static_cast<SimdSum<T>>(static_cast<uint64_t>(sum) + static_cast<uint64_t>(scalar_sum(p, n, full)));
+    }
+}
+
+template <typename Ops, typename T>
+ARRAY_SIMD_AVX512 inline size_t avx512_compare_mask(const T* p, size_t n, CmpOp op, T x, uint64_t* out)  {
+    const auto vx = Ops::set1(static_cast<typename Ops::S>(x));
+    size_t count = 0, i = 0;
+    for (; i + Ops::W <= n; i += Ops::W)  {
+        uint64_t m = Ops::cmp(Ops::load(p + i), vx, op);
+        out[i / 64] |= m << (i % 64);
+        count += std::popcount(m);
+    }
+    return count + scalar_compare_mask(p, n, op, x, out, i);
+}
+
+#endif // ARRAY_SIMD_X86
+
+
+// Map an elem type to its Ops by size, signedness and floatness, so that e.g. long and long long share Avx2I64.
+// void means no SIMD path.
+template <typename T, bool IsFloat = std::is_floating_point_v<T>, bool IsSigned = std::is_signed_v<T>, size_t Size = sizeof(T)>
+struct SimdOpsFor {
+    using Avx2 = void;
+    using Avx512 = void;
+};
+
+#if ARRAY_SIMD_X86
+template <typename T> struct SimdOpsFor<T, false, true, 4>  {using Avx2 = Avx2I32; using Avx512 = Avx512I32;};
+template <typename T> struct SimdOpsFor<T, false, false, 4> {using Avx2 = Avx2U32; using Avx512 = Avx512U32;};
+template <typename T> struct SimdOpsFor<T, false, true, 8>  {using Avx2 = Avx2I64; using Avx512 = Avx512I64;};
+template <typename T> struct SimdOpsFor<T, false, false, 8> {using Avx2 = Avx2U64; using Avx512 = Avx512U64;};
+template <> struct SimdOpsFor<float, true, true, 4>         {using Avx2 = Avx2F32; using Avx512 = Avx512F32;};
+template <> struct SimdOpsFor<double, true, true, 8>        {using Avx2 = Avx2F64; using Avx512 = Avx512F64;};
+#endif
+
+template <typename T>
+inline constexpr bool simd_supported_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                                         !std::is_void_v<typename SimdOpsFor<T>::Avx2>;
+
+
+// ----------------------------------------------------------------------------------------------------------------
+// Public dispatching kernels
+
+template <typename T>
+size_t simd_find(const T* data, size_t n, T value)  {
+    static_assert(std::is_arithmetic_v<T>, "SIMD kernels require an arithmetic elem type");
+#if ARRAY_SIMD_X86
+    if constexpr (simd_supported_v<T>) {
+        switch (simd_level()) {
+            case SimdLevel::AVX512: return avx512_find<typename SimdOpsFor<T>::Avx512>(data, n, value);
+            case SimdLevel::AVX2: return avx2_find<typename SimdOpsFor<T>::Avx2>(data, n, value);
+            default: break;
+        }
+    }
+#endif
+    return scalar_find(data, n, value);
+}
+
+template <typename T>
+size_t simd_count(const T* data, size_t n, T value)  {
+    static_assert(std::is_arithmetic_v<T>, "SIMD kernels require an arithmetic elem type");
+#if ARRAY_SIMD_X86
+    if constexpr (simd_supported_v<T>) {
+        switch (simd_level()) {
+            case SimdLevel::AVX512: return avx512_count<typename SimdOpsFor<T>::Avx512>(data, n, value);
+            case SimdLevel::AVX2: return avx2_count<typename SimdOpsFor<T>::Avx2>(data, n, value);
+            default: break;
+        }
+    }
+#endif
+    return scalar_count(data, n, value);
+}
+
+template <typename T>
+void simd_minmax(const T* data, size_t n, T& lo, T& hi)  {
+    static_assert(std::is_arithmetic_v<T>, "SIMD kernels require an arithmetic elem type");
+    if (n == 0) throw std::invalid_argument("min/max of an empty range");
+#if ARRAY_SIMD_X86
+    if constexpr (simd_supported_v<T>) {
+        switch (simd_level()) {
+            case SimdLevel::AVX512: avx512_minmax<typename SimdOpsFor<T>::Avx512>(data, n, lo, hi); return;
+            case SimdLevel::AVX2: avx2_minmax<typename SimdOpsFor<T>::Avx2>(data, n, lo, hi); return;
+            default: break;
+        }
+    }
+#endif
+    lo = hi = data[0];
+    scalar_minmax(data, n, lo, hi, 1);
+}
+
+template <typename T>
+T simd_min(const T* data, size_t n)  {
+    T lo, hi;
+    simd_minmax(data, n, lo, hi);
+    return lo;
+}
+
+template <typename T>
+T simd_max(const T* data, size_t n)  {
+    T lo, hi;
+    simd_minmax(data, n, lo, hi);
+    return hi;
+}
+
+// 2 streaming passes (reduce, then find) beat one pass carrying idx vectors along for memory bound sizes
+template <typename T>
+size_t simd_argmin(const T* data, size_t n)  {
+    return simd_find(data, n, simd_min(data, n));
+}
+
+template <typename T>
+size_t simd_argmax(const T* data, size_t n)  {
+    return simd_find(data, n, simd_max(data, n));
+}
+
+template <typename T>
+SimdSum<T> simd_sum(const T* data, size_t n)  {
+    static_assert(std::is_arithmetic_v<T>, "SIMD kernels require an arithmetic elem type");
+#if ARRAY_SIMD_X86
+    if constexpr (simd_supported_v<T>) {
+        switch (simd_level()) {
+            case SimdLevel::AVX512: return avx512_sum<typename SimdOpsFor<T>::Avx512>(data, n);
+            case SimdLevel::AVX2: return avx2_sum<typename SimdOpsFor<T>::Avx2>(data, n);
+            default: break;
+        }
+    }
+#endif
+    return scalar_sum(data, n);
+}
+
+template <typename T>
+size_t simd_compare_mask(const T* data, size_t n, CmpOp op, T value, uint64_t* out)  {
+    static_assert(std::is_arithmetic_v<T>, "SIMD kernels require an arithmetic elem type");
+    std::memset(out, 0, ((n + 63) / 64) * sizeof(uint64_t));
+#if ARRAY_SIMD_X86
+    if constexpr (simd_supported_v<T>) {
+        switch (simd_level()) {
+            case SimdLevel::AVX512: return avx512_compare_mask<typename SimdOpsFor<T>::Avx512>(data, n, op, value, out);
+            case SimdLevel::AVX2: return avx2_compare_mask<typename SimdOpsFor<T>::Avx2>(data, n, op, value, out);
+            default: break;
+        }
+    }
+#endif
+    return scalar_compare_mask(data, n, op, value, out);
+}
+
+
+// Array overloads: operate on the whole arr, skipping the bounds checked operator[]
+
+template <typename T, typename Alloc, typename Growth>
+size_t simd_find(const Array<T, Alloc, Growth>& arr, T value)  {return simd_find(arr.data(), arr.size(), value);}
+
+template <typename T, typename Alloc, typename Growth>
+size_t simd_count(const Array<T, Alloc, Growth>& arr, T value)  {return simd_count(arr.data(), arr.size(), value);}
+
+template <typename T, typename Alloc, typename Growth>
+T simd_min(const Array<T, Alloc, Growth>& arr)  {return simd_min(arr.data(), arr.size());}
+
+template <typename T, typename Alloc, typename Growth>
+T simd_max(const Array<T, Alloc, Growth>& arr)  {return simd_max(arr.data(), arr.size());}
+
+template <typename T, typename Alloc, typename Growth>
+size_t simd_argmin(const Array<T, Alloc, Growth>& arr)  {return simd_argmin(arr.data(), arr.size());}
+
+template <typename T, typename Alloc, typename Growth>
+size_t simd_argmax(const Array<T, Alloc, Growth>& arr)  {return simd_argmax(arr.data(), arr.size());}
+
+template <typename T, typename Alloc, typename Growth>
+SimdSum<T> simd_sum(const Array<T, Alloc, Growth>& arr)  {return simd_sum(arr.data(), arr.size());}
+
+template <typename T, typename Alloc, typename Growth>
+size_t simd_compare_mask(const Array<T, Alloc, Growth>& arr, CmpOp op, T value, uint64_t* out)  {
+    return simd_compare_mask(arr.data(), arr.size(), op, value, out);
+}
+
+
+#endif // __ARRAY_ARRAYSIMD_HPP
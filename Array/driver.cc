@@ -3,7 +3,16 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <random>
+#include <cstdint>
 #include "Array.hpp"
+#include "ArraySIMD.hpp"
+#include "ArrayParallel.hpp"
+#include <numeric>
+#include <span>
 
 void printTestResult(const std::string& testName, bool passed) {
     std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
@@ -19,6 +28,86 @@ bool verifyContents(const Array<T>& arr, const std::vector<T>& expected) {
     return true;
 }
 
+// Counts live objects and default constructions, to verify Array only constructs live elements
+struct Tracked {
+    static int live;
+    static int default_constructed;
+    int value;
+
+    Tracked() : value(0) { ++live; ++default_constructed; }
+    Tracked(int v) : value(v) { ++live; }
+    Tracked(const Tracked& other) : value(other.value) { ++live; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    Tracked& operator=(const Tracked& other) = default;
+    Tracked& operator=(Tracked&& other) noexcept = default;
+    ~Tracked() { --live; }
+};
+int Tracked::live = 0;
+int Tracked::default_constructed = 0;
+
+// A move that may throw, so relocation copies, and a copy that throws once copies_left runs out
+struct ThrowingCopy {
+    static int live;
+    static int copies_left;
+    std::string value; // heap allocated, so a leaked elem shows up under LeakSanitizer
+
+    ThrowingCopy(int v) : value(std::string(32, 'a') + std::to_string(v)) { ++live; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (copies_left-- == 0) throw std::runtime_error("copy");
+        ++live;
+    }
+    ThrowingCopy(ThrowingCopy&& other) : value(std::move(other.value)) { ++live; }
+    ThrowingCopy& operator=(const ThrowingCopy& other) = default;
+    ~ThrowingCopy() { --live; }
+};
+int ThrowingCopy::live = 0;
+int ThrowingCopy::copies_left = -1; // never runs out
+
+// Runs every SIMD kernel on random data and compares against straightforward loops
+template<typename T>
+bool checkSimdKernels(std::mt19937& gen) {
+    for (size_t n : {size_t(1), size_t(7), size_t(16), size_t(33), size_t(1000)}) {
+        Array<T> arr;
+        std::uniform_int_distribution<int> dis(-50, 50);
+        for (size_t i = 0; i < n; ++i) {
+            arr.push_back(static_cast<T>(dis(gen)));
+        }
+        T probe = arr[n / 2];
+
+        size_t expectedFind = n, expectedCount = 0, expectedArgmin = 0, expectedArgmax = 0;
+        SimdSum<T> expectedSum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (arr[i] == probe) {
+                if (expectedFind == n) expectedFind = i;
+                ++expectedCount;
+            }
+            if (arr[i] < arr[expectedArgmin]) expectedArgmin = i;
+            if (arr[i] > arr[expectedArgmax]) expectedArgmax = i;
+            expectedSum += static_cast<SimdSum<T>>(arr[i]);
+        }
+
+        if (simd_find(arr, probe) != expectedFind) return false;
+        if (simd_find(arr, static_cast<T>(99)) != n) return false;
+        if (simd_count(arr, probe) != expectedCount) return false;
+        if (simd_argmin(arr) != expectedArgmin || simd_min(arr) != arr[expectedArgmin]) return false;
+        if (simd_argmax(arr) != expectedArgmax || simd_max(arr) != arr[expectedArgmax]) return false;
+        if (simd_sum(arr) != expectedSum) return false; // small integral values: exact even in float
+
+        std::vector<uint64_t> mask((n + 63) / 64);
+        for (CmpOp op : {CmpOp::EQ, CmpOp::NE, CmpOp::LT, CmpOp::LE, CmpOp::GT, CmpOp::GE}) {
+            size_t count = simd_compare_mask(arr, op, probe, mask.data());
+            size_t expected = 0;
+            for (size_t i = 0; i < n; ++i) {
+                bool bit = (mask[i / 64] >> (i % 64)) & 1;
+                if (bit != simd_scalar_cmp(arr[i], probe, op)) return false;
+                expected += bit;
+            }
+            if (count != expected) return false;
+        }
+    }
+    return true;
+}
+
 int main() {
     try {
         // Test 1: Basic Operations
@@ -213,6 +302,415 @@ int main() {
             printTestResult("Stress Test - Iterator Stability", iterTraversed == reference);
         }
 
+        // Test 8: Raw Storage Growth
+        {
+            {
+                Array<Tracked> arr;
+                for (int i = 0; i < 100; ++i) {
+                    arr.emplace_back(i);
+                }
+                printTestResult("Raw Storage - No Default Construction", Tracked::default_constructed == 0);
+                printTestResult("Raw Storage - Live Count", Tracked::live == 100);
+
+                arr.remove(10);
+                arr.resize(50);
+                printTestResult("Raw Storage - Remove/Resize Destroy", Tracked::live == 50 && arr[10].value == 11);
+
+                arr.clear();
+                printTestResult("Raw Storage - Clear Destroys", Tracked::live == 0);
+            }
+            printTestResult("Raw Storage - Destructor", Tracked::live == 0);
+
+            // push_back of an own element while reallocating must not read freed memory
+            Array<std::string> strs;
+            strs.push_back("self");
+            for (int i = 0; i < 10; ++i) {
+                strs.push_back(strs[0]);
+            }
+            printTestResult("Raw Storage - Self Push Back", strs.size() == 11 && strs[10] == "self");
+
+            // copy assignment replaces rather than appends
+            Array<std::string> other;
+            other.push_back("x");
+            other = strs;
+            printTestResult("Raw Storage - Copy Assignment", other.size() == strs.size() && other[0] == "self");
+
+            // a copy throwing midway through relocation leaves the arr as it was, w/ nothing leaked
+            {
+                Array<ThrowingCopy> throwing;
+                throwing.reserve(4);
+                for (int i = 0; i < 4; ++i) {
+                    throwing.emplace_back(i);
+                }
+                bool intact = true;
+                auto relocationThrows = [&](int copies, auto&& op) { // the 1st copies succeed
+                    ThrowingCopy::copies_left = copies;
+                    try {
+                        op();
+                        intact = false;
+                    } catch (const std::runtime_error&) {}
+                    ThrowingCopy::copies_left = -1;
+                    intact = intact && throwing.size() == 4 && throwing.capacity() == 4 && throwing[3].value.back() == '3'
+                             && ThrowingCopy::live == 4;
+                };
+                relocationThrows(2, [&] { throwing.emplace_back(4); });
+                relocationThrows(2, [&] { throwing.reserve(16); });
+                relocationThrows(6, [&] { throwing.resize(8, ThrowingCopy(9)); }); // 4 fills, then relocating throws
+                printTestResult("Raw Storage - Throwing Relocation", intact);
+            }
+            printTestResult("Raw Storage - Throwing Relocation Leaks Nothing", ThrowingCopy::live == 0);
+        }
+
+        // Test 9: Range and Bulk Insertion
+        {
+            std::vector<int> source(1000);
+            for (int i = 0; i < 1000; ++i) source[i] = i;
+
+            Array<int> ranged(source.begin(), source.end());
+            printTestResult("Range Constructor - Contents", verifyContents(ranged, source));
+            printTestResult("Range Constructor - Single Allocation", ranged.capacity() == source.size());
+
+            Array<int> filled(100, 7);
+            printTestResult("Fill Constructor - Single Allocation", filled.capacity() == 100 && filled[99] == 7);
+
+            Array<int> copied(ranged);
+            printTestResult("Copy Constructor - Exact Capacity", copied.capacity() == ranged.size() && verifyContents(copied, source));
+
+            Array<std::string> strs;
+            strs.push_back("a");
+            strs.push_back("e");
+            std::list<std::string> middle = {"b", "c", "d"};
+            auto it = strs.insert(strs.begin() + 1, middle.begin(), middle.end());
+            printTestResult("Insert Range - Non-trivial", verifyContents(strs, {"a", "b", "c", "d", "e"}) && *it == "b");
+
+            int extra[] = {-3, -2, -1};
+            ranged.insert(ranged.begin(), extra, extra + 3);
+            printTestResult("Insert Range - Trivial Front", ranged.size() == 1003 && ranged[0] == -3 && ranged[3] == 0 && ranged[1002] == 999);
+
+            ranged.reserve(2000);
+            ranged.insert(ranged.begin() + 3, extra, extra + 3);
+            printTestResult("Insert Range - In Place", ranged.size() == 1006 && ranged[3] == -3 && ranged[6] == 0);
+
+            ranged.insert(ranged.end(), extra, extra + 3);
+            printTestResult("Insert Range - End", ranged[1008] == -1);
+
+            Array<int> appended;
+            appended.append(source.begin(), source.begin() + 10);
+            appended.append(copied.begin(), copied.begin() + 10);
+            printTestResult("Append - Contents", appended.size() == 20 && appended[10] == 0 && appended[19] == 9);
+
+            appended.assign(extra, extra + 3);
+            printTestResult("Assign - Replaces", verifyContents(appended, {-3, -2, -1}));
+
+            std::istringstream in("4 5 6");
+            Array<int> streamed((std::istream_iterator<int>(in)), std::istream_iterator<int>());
+            printTestResult("Range Constructor - Input Iterator", verifyContents(streamed, {4, 5, 6}));
+
+            Array<int> resized;
+            resized.push_back(1);
+            resized.resize(50, resized[0]); // filler aliasing an own elem across reallocation
+            printTestResult("Resize - Aliased Filler", resized.size() == 50 && resized[49] == 1);
+        }
+
+        // Test 10: Batched Erase
+        {
+            Array<int> arr;
+            std::vector<int> reference;
+            for (int i = 0; i < 20; ++i) {
+                arr.push_back(i);
+                reference.push_back(i);
+            }
+
+            auto it = arr.erase(arr.begin() + 5, arr.begin() + 10);
+            reference.erase(reference.begin() + 5, reference.begin() + 10);
+            printTestResult("Erase Range - Contents", verifyContents(arr, reference) && *it == 10);
+
+            size_t removed = arr.remove_if([](int x) { return x % 2 == 0; });
+            std::erase_if(reference, [](int x) { return x % 2 == 0; });
+            printTestResult("Remove If - Stable Compaction", removed == 8 && verifyContents(arr, reference));
+
+            arr.swap_remove(0);
+            printTestResult("Swap Remove - Last Moved In", arr.size() == 6 && arr[0] == 19);
+
+            arr.pop_back();
+            printTestResult("Pop Back", arr.size() == 5 && arr[4] == 15);
+
+            Array<std::string> strs;
+            for (int i = 0; i < 10; ++i) {
+                strs.push_back(std::to_string(i));
+            }
+            strs.erase(strs.begin(), strs.begin() + 3);
+            strs.remove_if([](const std::string& s) { return s == "5" || s == "9"; });
+            strs.swap_remove(1);
+            printTestResult("Batched Erase - Non-trivial", verifyContents(strs, {"3", "8", "6", "7"}));
+
+            bool exceptionThrown = false;
+            try {
+                strs.erase(strs.begin() + 2, strs.begin() + 10);
+            } catch (const std::out_of_range&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Erase Range - Out of Bounds", exceptionThrown);
+
+            {
+                Array<Tracked> tracked;
+                for (int i = 0; i < 10; ++i) {
+                    tracked.emplace_back(i);
+                }
+                tracked.erase(tracked.begin(), tracked.begin() + 2);
+                tracked.remove_if([](const Tracked& t) { return t.value > 7; });
+                tracked.swap_remove(0);
+                printTestResult("Batched Erase - Destroys Removed", Tracked::live == 5 && tracked[0].value == 7);
+            }
+        }
+
+        // Test 11: SIMD Kernels at every supported level
+        {
+            std::mt19937 gen(42);
+            SimdLevel detected = simd_detect();
+            for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+                if (static_cast<int>(level) > static_cast<int>(detected)) continue;
+                simd_set_level(level);
+                std::string name = level == SimdLevel::Scalar ? "Scalar" : level == SimdLevel::AVX2 ? "AVX2" : "AVX512";
+                bool ok = checkSimdKernels<int32_t>(gen) && checkSimdKernels<uint32_t>(gen) &&
+                          checkSimdKernels<int64_t>(gen) && checkSimdKernels<uint64_t>(gen) &&
+                          checkSimdKernels<long long>(gen) && checkSimdKernels<float>(gen) &&
+                          checkSimdKernels<double>(gen) && checkSimdKernels<short>(gen);
+                printTestResult("SIMD Kernels - " + name, ok);
+            }
+            simd_set_level(detected);
+
+            Array<uint32_t> big;
+            big.push_back(0xFFFFFFFFu);
+            big.push_back(1);
+            printTestResult("SIMD Kernels - Unsigned Order", simd_max(big) == 0xFFFFFFFFu && simd_min(big) == 1);
+
+            bool exceptionThrown = false;
+            try {
+                simd_min(Array<int>());
+            } catch (const std::invalid_argument&) {
+                exceptionThrown = true;
+            }
+            printTestResult("SIMD Kernels - Empty Min Throws", exceptionThrown);
+        }
+
+        // Test 12: Parallel Algorithms
+        {
+            ThreadPool pool(4);
+            ParallelConfig config{&pool, 1000};
+            std::mt19937 gen(7);
+            std::uniform_int_distribution<int> dis(0, 5000);
+
+            Array<int> arr;
+            std::vector<int> reference;
+            for (int i = 0; i < 100000; ++i) {
+                int value = dis(gen);
+                arr.push_back(value);
+                reference.push_back(value);
+            }
+
+            parallel_sort(arr.begin(), arr.end(), std::less<>(), config);
+            std::sort(reference.begin(), reference.end());
+            printTestResult("Parallel Sort", verifyContents(arr, reference));
+
+            // stable: sort (key, original position) pairs by key only, positions must stay ascending per key
+            Array<std::pair<int, int>> pairs;
+            for (int i = 0; i < 20000; ++i) {
+                pairs.push_back({dis(gen) % 50, i});
+            }
+            parallel_stable_sort(pairs.begin(), pairs.end(),
+                                 [](const auto& a, const auto& b) { return a.first < b.first; }, config);
+            bool stable = true;
+            for (size_t i = 1; i < pairs.size(); ++i) {
+                if (pairs[i - 1].first > pairs[i].first ||
+                    (pairs[i - 1].first == pairs[i].first && pairs[i - 1].second > pairs[i].second)) stable = false;
+            }
+            printTestResult("Parallel Stable Sort", stable);
+
+            Array<std::string> strs;
+            for (int i = 0; i < 5000; ++i) {
+                strs.push_back(std::to_string(dis(gen)));
+            }
+            std::vector<std::string> strsReference(strs.begin(), strs.end());
+            parallel_sort(strs.begin(), strs.end(), std::less<>(), ParallelConfig{&pool, 300});
+            std::sort(strsReference.begin(), strsReference.end());
+            printTestResult("Parallel Sort - Non-trivial", verifyContents(strs, strsReference));
+
+            // a comparator throwing during the run sorts or any merge pass: rethrown, no elem lost or leaked
+            bool rethrown = true, kept = true;
+            for (int throwAt : {1, 60, 150, 250, 350}) {
+                Array<std::string> words;
+                for (int i = 0; i < 64; ++i) {
+                    words.push_back(std::string(32, 'w') + std::to_string(dis(gen)));
+                }
+                std::vector<std::string> wordsReference(words.begin(), words.end());
+                std::atomic<int> calls{0};
+                try {
+                    parallel_sort(words.begin(), words.end(), [&](const std::string& a, const std::string& b) {
+                        if (++calls == throwAt) throw std::runtime_error("comparator failed");
+                        return a < b;
+                    }, ParallelConfig{&pool, 8});
+                    rethrown = false;
+                } catch (const std::runtime_error&) {}
+                std::sort(words.begin(), words.end());
+                std::sort(wordsReference.begin(), wordsReference.end());
+                if (!verifyContents(words, wordsReference)) kept = false;
+            }
+            Array<std::string> fewWords;
+            for (const char* word : {"c", "a", "b"}) fewWords.push_back(word);
+            try {
+                parallel_sort(fewWords.begin(), fewWords.end(), [](const std::string& a, const std::string& b) -> bool {
+                    if (a == "a" || b == "a") throw std::runtime_error("comparator failed");
+                    return a < b;
+                }, ParallelConfig{&pool, 8});
+                rethrown = false;
+            } catch (const std::runtime_error&) {}
+            std::sort(fewWords.begin(), fewWords.end());
+            kept = kept && verifyContents(fewWords, {"a", "b", "c"});
+            printTestResult("Parallel Sort - Throwing Comparator Keeps Every Elem", rethrown && kept);
+
+            long long sum = parallel_reduce(arr.begin(), arr.end(), 0LL, std::plus<>(), config);
+            printTestResult("Parallel Reduce", sum == std::accumulate(reference.begin(), reference.end(), 0LL));
+
+            // float reduction is bit identical no matter how many threads run it
+            Array<float> floats;
+            for (int i = 0; i < 50000; ++i) {
+                floats.push_back(static_cast<float>(dis(gen)) * 0.001f);
+            }
+            ThreadPool single(1);
+            float many = parallel_reduce(floats.begin(), floats.end(), 0.0f, std::plus<>(), config);
+            float one = parallel_reduce(floats.begin(), floats.end(), 0.0f, std::plus<>(), ParallelConfig{&single, 1000});
+            printTestResult("Parallel Reduce - Deterministic", many == one);
+
+            Array<long long> scanned(arr.size(), 0);
+            std::vector<long long> scanReference(reference.size());
+            parallel_inclusive_scan(arr.begin(), arr.end(), scanned.begin(), std::plus<long long>(), config);
+            std::inclusive_scan(reference.begin(), reference.end(), scanReference.begin(), std::plus<long long>());
+            printTestResult("Parallel Inclusive Scan", verifyContents(scanned, scanReference));
+
+            parallel_exclusive_scan(arr.begin(), arr.end(), scanned.begin(), 10LL, std::plus<long long>(), config);
+            std::exclusive_scan(reference.begin(), reference.end(), scanReference.begin(), 10LL, std::plus<long long>());
+            printTestResult("Parallel Exclusive Scan", verifyContents(scanned, scanReference));
+
+            Array<int> inPlace(5000, 1);
+            parallel_inclusive_scan(inPlace.begin(), inPlace.end(), inPlace.begin(), std::plus<>(), ParallelConfig{&pool, 64});
+            printTestResult("Parallel Scan - In Place", inPlace[0] == 1 && inPlace[4999] == 5000);
+
+            Array<int> doubled(arr.size(), 0);
+            parallel_transform(arr.begin(), arr.end(), doubled.begin(), [](int x) { return 2 * x; }, config);
+            parallel_for_each(doubled.begin(), doubled.end(), [](int& x) { x += 1; }, config);
+            bool transformed = true;
+            for (size_t i = 0; i < arr.size(); ++i) {
+                if (doubled[i] != 2 * arr[i] + 1) transformed = false;
+            }
+            printTestResult("Parallel Transform and For Each", transformed);
+        }
+
+        // Test 13: Growth Policies, Shrink To Fit and Aligned Allocation
+        {
+            Array<int, std::allocator<int>, InstrumentedGrowth<DoublingGrowth>> doubling;
+            for (int i = 0; i < 1000; ++i) {
+                doubling.push_back(i);
+            }
+            const ArrayGrowthStats& stats = doubling.growth_policy().stats();
+            printTestResult("Doubling Growth - Capacity", doubling.capacity() == 1024);
+            printTestResult("Doubling Growth - Reallocations", stats.reallocations == 10);
+            // every reallocation relocates the full old buffer: 1 + 2 + ... + 512 elems
+            printTestResult("Doubling Growth - Bytes Copied", stats.bytes_copied == 1023 * sizeof(int));
+            printTestResult("Doubling Growth - Peak Capacity", stats.peak_capacity == 1024);
+
+            Array<int, std::allocator<int>, InstrumentedGrowth<HalfGrowth>> half;
+            for (int i = 0; i < 1000; ++i) {
+                half.push_back(i);
+            }
+            printTestResult("1.5x Growth - Less Slack", half.capacity() >= 1000 && half.capacity() < 1500
+                            && half.growth_policy().stats().reallocations > stats.reallocations);
+
+            printTestResult("Power Of Two Growth - Small", PowerOfTwoGrowth::grow(5, 11, sizeof(int)) == 16);
+            // a forward range is 1 allocation of exactly its size, whatever the policy
+            std::list<int> five{1, 2, 3, 4, 5};
+            Array<int, std::allocator<int>, InstrumentedGrowth<PowerOfTwoGrowth>> fromRange(five.begin(), five.end());
+            printTestResult("Range Constructor - No Reallocation", fromRange.capacity() == 5 && fromRange[4] == 5
+                            && fromRange.growth_policy().stats().reallocations == 0 && fromRange.growth_policy().stats().peak_capacity == 5);
+            size_t hugeCapacity = PowerOfTwoGrowth::grow(300000, 300001, 24);
+            printTestResult("Power Of Two Growth - Huge Page Multiple",
+                            hugeCapacity >= 600000 && ARRAY_HUGE_PAGE_SIZE - (hugeCapacity * 24) % ARRAY_HUGE_PAGE_SIZE < 24); // fills whole pages but for the last partial elem
+
+            half.resize(10);
+            half.shrink_to_fit();
+            printTestResult("Shrink To Fit", half.capacity() == 10 && half[9] == 9
+                            && half.growth_policy().stats().peak_capacity >= 1000);
+            half.clear();
+            half.shrink_to_fit();
+            printTestResult("Shrink To Fit - Empty Keeps One Slot", half.capacity() == 1 && half.empty());
+
+            // the growth history moves w/ the buffer
+            Array<int, std::allocator<int>, InstrumentedGrowth<HalfGrowth>> grown;
+            for (int i = 0; i < 1000; ++i) {
+                grown.push_back(i);
+            }
+            size_t grownReallocations = grown.growth_policy().stats().reallocations;
+            half = std::move(grown);
+            printTestResult("Move Assignment - Growth Stats Follow The Buffer", half.growth_policy().stats().reallocations == grownReallocations
+                            && grown.growth_policy().stats().reallocations == 0 && grown.growth_policy().stats().peak_capacity == 0);
+            Array<int, std::allocator<int>, InstrumentedGrowth<HalfGrowth>> moved(std::move(half));
+            printTestResult("Move Constructor - Growth Stats Follow The Buffer", moved.growth_policy().stats().reallocations == grownReallocations
+                            && half.growth_policy().stats().reallocations == 0);
+
+            Array<double, AlignedAllocator<double, 64>> aligned;
+            bool allAligned = true;
+            for (int i = 0; i < 100; ++i) {
+                aligned.push_back(i);
+                if (reinterpret_cast<uintptr_t>(aligned.data()) % 64 != 0) allAligned = false;
+            }
+            printTestResult("Aligned Allocation", allAligned && aligned[99] == 99.0);
+            printTestResult("Aligned Allocation - SIMD Kernels", simd_sum(aligned) == 99.0 * 100 / 2);
+            printTestResult("Uninstrumented Policy Takes No Space", sizeof(Array<int>) == sizeof(Array<double, AlignedAllocator<double, 64>>));
+        }
+
+        // Test 14: Contiguous Iterators
+        {
+            static_assert(std::contiguous_iterator<Array<int>::iterator>);
+            static_assert(std::contiguous_iterator<Array<int>::const_iterator>);
+            static_assert(std::is_same_v<std::iter_reference_t<Array<int>::const_iterator>, const int&>);
+            static_assert(std::is_convertible_v<Array<int>::iterator, Array<int>::const_iterator>);
+            static_assert(!std::is_convertible_v<Array<int>::const_iterator, Array<int>::iterator>);
+
+            Array<int> arr;
+            std::mt19937 rng(3);
+            for (int i = 0; i < 1000; ++i) {
+                arr.push_back(static_cast<int>(rng() % 500));
+            }
+            std::sort(arr.begin(), arr.end());
+            printTestResult("std::sort", std::is_sorted(arr.begin(), arr.end()));
+
+            auto it = arr.begin();
+            it += 10;
+            it -= 4;
+            auto old = it++;
+            printTestResult("Compound And Postfix Ops", old - arr.begin() == 6 && it - arr.begin() == 7
+                            && it[3] == arr[10] && *(it - 7) == arr[0] && *(2 + it) == arr[9]);
+            printTestResult("Relational Ops", arr.begin() < it && it > old && it >= it && arr.end() > it);
+
+            Array<std::string> words(3, "abc");
+            printTestResult("Arrow Op", words.begin()->size() == 3);
+
+            std::span<int> view(arr.begin(), arr.end());
+            printTestResult("std::span From Iterators", view.size() == 1000 && view.data() == arr.data());
+            printTestResult("std::to_address", std::to_address(arr.begin() + 5) == arr.data() + 5);
+
+            const Array<int>& constArr = arr;
+            Array<int>::const_iterator cit = arr.begin(); // iterator -> const_iterator
+            printTestResult("Const Iterator", cit == constArr.begin() && constArr.cend() - cit == 1000
+                            && std::lower_bound(constArr.begin(), constArr.end(), 250) - cit >= 0);
+
+            Array<int> copied(1000, 0);
+            std::copy(constArr.begin(), constArr.end(), copied.begin()); // memmove fast path for contiguous iters
+            printTestResult("std::copy Between Arrays", std::equal(copied.begin(), copied.end(), arr.begin()));
+            std::ranges::reverse(copied);
+            printTestResult("std::ranges Algorithms", copied[0] == arr[999] && std::ranges::is_sorted(copied, std::greater<>()));
+        }
+
         std::cout << "\nAll Array tests completed!" << std::endl;
 
     } catch (const std::exception& e) {
@@ -0,0 +1,382 @@
+#ifndef __BITARRAY_BITARRAY_HPP
+#define __BITARRAY_BITARRAY_HPP
+#include <stdexcept>
+#include <cstdint>
+#include <bit>
+#include <utility>
+#include "./../Array/Array.hpp"
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/*
+BitArray: bit packed Array<bool>, 1 bit per flag
+
+Bits live in 64 bit words, bit i being bit (i % 64) of word i / 64, so that
+- single bit ops are a shift + mask on one word,
+- count / any / the bulk AND, OR, XOR, ANDNOT work a word (64 flags) at a time, and count is one popcount per word,
+- iterating the set bits skips whole zero words and jumps between set bits w/ count trailing zeros:
+      for (size_t i = bits.find_first(); i < bits.size(); i = bits.find_next(i))  ...
+  or bits.for_each_set([](size_t i) {...}), which costs O(words + set bits) instead of O(size).
+The bits past size() in the last word are kept 0, so whole word ops never need masking on the read side.
+
+Rank / select (optional): after build_rank_select(),
+- rank1(i):   num of set bits in [0, i), O(1): a stored count per 512 bit block + at most 8 popcounts
+- select1(k): position of the k-th set bit (k from 0), O(1) in practice: a sampled hint jumps near the right block,
+              then scans blocks (the sample spacing bounds the scan for evenly spread bits) and finally 1 word.
+Extra mem: 1/8 of the bits for the block counts + 8 B per 512 set bits for the select samples.
+The directory is NOT maintained by updates: any mutation marks it stale, and rank1 / select1 then throw std::logic_error
+until build_rank_select() is called again.
+*/
+
+class BitArray {
+public:
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    BitArray() : num_bits_(0), rank_valid_(false) {}
+    explicit BitArray(size_t num_bits, bool value = false);
+
+    bool test(size_t index) const;
+    bool operator[](size_t index) const  {return test(index);}
+    void set(size_t index);
+    void set(size_t index, bool value);
+    void reset(size_t index);
+    void flip(size_t index);
+    bool test_and_set(size_t index); // sets the bit, returns its old value: one word access for visited-set checks
+
+    void set_all();
+    void reset_all();
+    void flip_all();
+
+    size_t count() const; // num of set bits
+    bool any() const;
+    bool none() const  {return !any();}
+    bool all() const  {return count() == num_bits_;}
+
+    size_t find_first() const; // idx of the first set bit, or size() if none
+    size_t find_next(size_t index) const; // idx of the first set bit after index, or size() if none
+    template <typename F>
+    void for_each_set(F f) const; // f(idx) for every set bit, in ascending order
+
+    // Bulk ops, word by word. Both operands must have the same size (std::invalid_argument otherwise)
+    BitArray& operator&=(const BitArray& other);
+    BitArray& operator|=(const BitArray& other);
+    BitArray& operator^=(const BitArray& other);
+    BitArray& and_not(const BitArray& other); // this & ~other, i.e. set difference
+    bool operator==(const BitArray& other) const;
+
+    size_t size() const  {return num_bits_;}
+    bool empty() const  {return num_bits_ == 0;}
+    void resize(size_t num_bits, bool value = false);
+    void push_back(bool value);
+    void clear();
+
+    // Raw words, e.g. for hashing or to feed ArraySIMD kernels
+    uint64_t* words()  {rank_valid_ = false; return words_.data();}
+    const uint64_t* words() const  {return words_.data();}
+    size_t word_count() const  {return words_.size();}
+
+    void build_rank_select();
+    size_t rank1(size_t index) const; // set bits in [0, index), index <= size()
+    size_t rank0(size_t index) const  {return index - rank1(index);}
+    size_t select1(size_t k) const; // position of the k-th set bit, or size() if there are not that many
+
+private:
+    static constexpr size_t BLOCK_WORDS = 8; // rank block: 512 bits
+    static constexpr size_t BLOCK_BITS = BLOCK_WORDS * WORD_BITS;
+    static constexpr size_t SELECT_SAMPLE = 512; // every 512th set bit's block is sampled
+
+    Array<uint64_t> words_;
+    size_t num_bits_;
+    Array<uint64_t> block_rank_; // set bits before each block, plus a total at the end
+    Array<uint64_t> select_hint_; // block of set bit j * SELECT_SAMPLE
+    bool rank_valid_;
+
+    static size_t words_for(size_t num_bits)  {return (num_bits + WORD_BITS - 1) / WORD_BITS;}
+    static uint64_t bit(size_t index)  {return uint64_t(1) << (index % WORD_BITS);}
+    static size_t select_in_word(uint64_t word, size_t k); // position of the k-th set bit of word
+
+    void check_index(size_t index) const;
+    void check_same_size(const BitArray& other) const;
+    void clear_tail(); // zero the bits past num_bits_ in the last word
+    void require_rank() const;
+};
+
+
+inline BitArray::BitArray(size_t num_bits, bool value) : words_(words_for(num_bits), value ? ~uint64_t(0) : 0), num_bits_(num_bits), rank_valid_(false) {
+    clear_tail();
+}
+
+inline void BitArray::check_index(size_t index) const  {
+    if (index >= num_bits_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+}
+
+inline void BitArray::check_same_size(const BitArray& other) const  {
+    if (num_bits_ != other.num_bits_) {
+        throw std::invalid_argument("BitArray sizes differ");
+    }
+}
+
+inline void BitArray::clear_tail()  {
+    if (num_bits_ % WORD_BITS) {
+        words_.data()[words_.size() - 1] &= bit(num_bits_) - 1;
+    }
+}
+
+inline bool BitArray::test(size_t index) const  {
+    check_index(index);
+    return words_.data()[index / WORD_BITS] & bit(index);
+}
+
+inline void BitArray::set(size_t index)  {
+    check_index(index);
+    words_.data()[index / WORD_BITS] |= bit(index);
+    rank_valid_ = false;
+}
+
+inline void BitArray::set(size_t index, bool value)  {
+    check_index(index);
+    uint64_t& word = words_.data()[index / WORD_BITS];
+    word = (word & ~bit(index)) | (value ? bit(index) : 0); // branchless
+    rank_valid_ = false;
+}
+
+inline void BitArray::reset(size_t index)  {
+    check_index(index);
+    words_.data()[index / WORD_BITS] &= ~bit(index);
+    rank_valid_ = false;
+}
+
+inline void BitArray::flip(size_t index)  {
+    check_index(index);
+    words_.data()[index / WORD_BITS] ^= bit(index);
+    rank_valid_ = false;
+}
+
+inline bool BitArray::test_and_set(size_t index)  {
+    check_index(index);
+    uint64_t& word = words_.data()[index / WORD_BITS];
+    bool old = word & bit(index);
+    word |= bit(index);
+    rank_valid_ = false;
+    return old;
+}
+
+inline void BitArray::set_all()  {
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        words_.data()[w] = ~uint64_t(0);
+    }
+    clear_tail();
+    rank_valid_ = false;
+}
+
+inline void BitArray::reset_all()  {
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        words_.data()[w] = 0;
+    }
+    rank_valid_ = false;
+}
+
+inline void BitArray::flip_all()  {
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        words_.data()[w] = ~words_.data()[w];
+    }
+    clear_tail();
+    rank_valid_ = false;
+}
+
+inline size_t BitArray::count() const  {
+    size_t total = 0;
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        total += static_cast<size_t>(std::popcount(words_.data()[w]));
+    }
+    return total;
+}
+
+inline bool BitArray::any() const  {
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        if (words_.data()[w]) return true;
+    }
+    return false;
+}
+
+inline size_t BitArray::find_first() const  {
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        if (words_.data()[w]) return w * WORD_BITS + static_cast<size_t>(std::countr_zero(words_.data()[w]));
+    }
+    return num_bits_;
+}
+
+inline size_t BitArray::find_next(size_t index) const  {
+    ++index;
+    if (index >= num_bits_) return num_bits_;
+    size_t w = index / WORD_BITS;
+    uint64_t word = words_.data()[w] & ~(bit(index) - 1); // drop the bits before index
+    while (true) {
+        if (word) return w * WORD_BITS + static_cast<size_t>(std::countr_zero(word));
+        if (++w == words_.size()) return num_bits_;
+        word = words_.data()[w];
+    }
+}
+
+template <typename F>
+void BitArray::for_each_set(F f) const  {
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        uint64_t word = words_.data()[w];
+        while (word) {
+            f(w * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+            word &= word - 1; // clear the lowest set bit
+        }
+    }
+}
+
+inline BitArray& BitArray::operator&=(const BitArray& other)  {
+    check_same_size(other);
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        words_.data()[w] &= other.words_.data()[w];
+    }
+    rank_valid_ = false;
+    return *this;
+}
+
+inline BitArray& BitArray::operator|=(const BitArray& other)  {
+    check_same_size(other);
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        words_.data()[w] |= other.words_.data()[w];
+    }
+    rank_valid_ = false;
+    return *this;
+}
+
+inline BitArray& BitArray::operator^=(const BitArray& other)  {
+    check_same_size(other);
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        words_.data()[w] ^= other.words_.data()[w];
+    }
+    rank_valid_ = false;
+    return *this;
+}
+
+inline BitArray& BitArray::and_not(const BitArray& other)  {
+    check_same_size(other);
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        words_.data()[w] &= ~other.words_.data()[w];
+    }
+    rank_valid_ = false;
+    return *this;
+}
+
+inline bool BitArray::operator==(const BitArray& other) const  {
+    if (num_bits_ != other.num_bits_) return false;
+    for (size_t w = 0; w < words_.size(); ++w)  {
+        if (words_.data()[w] != other.words_.data()[w]) return false; // tails are 0 on both sides
+    }
+    return true;
+}
+
+inline BitArray operator&(BitArray lhs, const BitArray& rhs)  {return lhs &= rhs;}
+inline BitArray operator|(BitArray lhs, const BitArray& rhs)  {return lhs |= rhs;}
+inline BitArray operator^(BitArray lhs, const BitArray& rhs)  {return lhs ^= rhs;}
+
+inline void BitArray::resize(size_t num_bits, bool value)  {
+    size_t old_bits = num_bits_;
+    words_.resize(words_for(num_bits), value ? ~uint64_t(0) : 0);
+    num_bits_ = num_bits;
+    if (value && num_bits > old_bits && old_bits % WORD_BITS) {
+        words_.data()[old_bits / WORD_BITS] |= ~(bit(old_bits) - 1); // the old last word's free bits
+    }
+    clear_tail();
+    rank_valid_ = false;
+}
+
+inline void BitArray::push_back(bool value)  {
+    if (num_bits_ % WORD_BITS == 0) words_.push_back(0);
+    ++num_bits_;
+    if (value) words_.data()[(num_bits_ - 1) / WORD_BITS] |= bit(num_bits_ - 1);
+    rank_valid_ = false;
+}
+
+inline void BitArray::clear()  {
+    words_.clear();
+    num_bits_ = 0;
+    rank_valid_ = false;
+}
+
+
+inline void BitArray::build_rank_select()  {
+    size_t num_blocks = (words_.size() + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    block_rank_.clear();
+    block_rank_.reserve(num_blocks + 1);
+    select_hint_.clear();
+
+    uint64_t total = 0;
+    for (size_t b = 0; b < num_blocks; ++b)  {
+        block_rank_.push_back(total);
+        size_t end = std::min(words_.size(), (b + 1) * BLOCK_WORDS);
+        for (size_t w = b * BLOCK_WORDS; w < end; ++w)  {
+            uint64_t ones = static_cast<uint64_t>(std::popcount(words_.data()[w]));
+            // record block b for every sample position that falls into this word
+            while (select_hint_.size() * SELECT_SAMPLE < total + ones) {
+                select_hint_.push_back(b);
+            }
+            total += ones;
+        }
+    }
+    block_rank_.push_back(total); // sentinel: the grand total
+    rank_valid_ = true;
+}
+
+inline void BitArray::require_rank() const  {
+    if (!rank_valid_) {
+        throw std::logic_error("BitArray rank/select directory is stale, call build_rank_select()");
+    }
+}
+
+inline size_t BitArray::rank1(size_t index) const  {
+    require_rank();
+    if (index > num_bits_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    size_t w = index / WORD_BITS;
+    size_t block = w / BLOCK_WORDS;
+    size_t rank = block_rank_.data()[block];
+    for (size_t i = block * BLOCK_WORDS; i < w; ++i)  {
+        rank += static_cast<size_t>(std::popcount(words_.data()[i]));
+    }
+    if (index % WORD_BITS) rank += static_cast<size_t>(std::popcount(words_.data()[w] & (bit(index) - 1)));
+    return rank;
+}
+
+inline size_t BitArray::select_in_word(uint64_t word, size_t k)  {
+#if defined(__BMI2__)
+    return static_cast<size_t>(std::countr_zero(_pdep_u64(uint64_t(1) << k, word))); // deposit a 1 onto the k-th set bit
+#else
+    for (size_t i = 0; i < k; ++i)  {
+        word &= word - 1;
+    }
+    return static_cast<size_t>(std::countr_zero(word));
+#endif
+}
+
+inline size_t BitArray::select1(size_t k) const  {
+    require_rank();
+    size_t num_blocks = block_rank_.size() - 1;
+    if (k >= block_rank_.data()[num_blocks]) return num_bits_;
+
+    size_t block = select_hint_.data()[k / SELECT_SAMPLE];
+    while (block + 1 < num_blocks && block_rank_.data()[block + 1] <= k) {
+        ++block;
+    }
+    size_t remaining = k - block_rank_.data()[block];
+    for (size_t w = block * BLOCK_WORDS; ; ++w)  {
+        size_t ones = static_cast<size_t>(std::popcount(words_.data()[w]));
+        if (remaining < ones) return w * WORD_BITS + select_in_word(words_.data()[w], remaining);
+        remaining -= ones;
+    }
+}
+
+
+#endif // __BITARRAY_BITARRAY_HPP
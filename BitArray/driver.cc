@@ -0,0 +1,179 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include "BitArray.hpp"
+
+void printTestResult(const std::string& testName, bool passed) {
+    std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+bool verifyContents(const BitArray& bits, const std::vector<bool>& expected) {
+    if (bits.size() != expected.size()) return false;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        if (bits[i] != expected[i]) return false;
+    }
+    return true;
+}
+
+int main() {
+    try {
+        // Test 1: Single Bit Operations
+        {
+            BitArray bits(100);
+            printTestResult("Initial All Clear", bits.size() == 100 && bits.none() && bits.count() == 0);
+
+            bits.set(0);
+            bits.set(63);
+            bits.set(64);
+            bits.set(99);
+            printTestResult("Set And Test", bits.test(0) && bits.test(63) && bits[64] && bits[99] && !bits[1]);
+            printTestResult("Count", bits.count() == 4);
+
+            bits.reset(63);
+            bits.flip(1);
+            bits.flip(0);
+            bits.set(5, true);
+            bits.set(64, false);
+            printTestResult("Reset Flip And Set Value", verifyContents(bits, [] {
+                std::vector<bool> v(100);
+                v[1] = v[5] = v[99] = true;
+                return v;
+            }()));
+
+            printTestResult("Test And Set", !bits.test_and_set(2) && bits.test_and_set(2));
+
+            bool exceptionThrown = false;
+            try {
+                bits.test(100);
+            } catch (const std::out_of_range&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Out Of Bounds Throws", exceptionThrown);
+        }
+
+        // Test 2: Whole Array Operations
+        {
+            BitArray bits(130, true);
+            printTestResult("Fill Constructor", bits.all() && bits.count() == 130 && bits.word_count() == 3);
+            bits.flip_all();
+            printTestResult("Flip All Keeps Tail Clear", bits.none());
+            bits.set_all();
+            printTestResult("Set All", bits.count() == 130);
+            bits.reset_all();
+            printTestResult("Reset All", bits.none());
+
+            bits.resize(70, true);
+            printTestResult("Resize Down", bits.size() == 70 && bits.none());
+            bits.resize(200, true);
+            printTestResult("Resize Up Fills New Bits", bits.count() == 130 && !bits[69] && bits[70] && bits[199]);
+
+            BitArray pushed;
+            for (int i = 0; i < 70; ++i) {
+                pushed.push_back(i % 3 == 0);
+            }
+            printTestResult("Push Back", pushed.size() == 70 && pushed.count() == 24 && pushed[69] && !pushed[68]);
+            pushed.clear();
+            printTestResult("Clear", pushed.empty() && pushed.none());
+        }
+
+        // Test 3: Set Bit Iteration
+        {
+            BitArray bits(1000);
+            std::vector<size_t> expected = {3, 64, 65, 200, 511, 512, 999};
+            for (size_t i : expected) {
+                bits.set(i);
+            }
+            std::vector<size_t> found;
+            for (size_t i = bits.find_first(); i < bits.size(); i = bits.find_next(i)) {
+                found.push_back(i);
+            }
+            printTestResult("Find First / Find Next", found == expected);
+
+            std::vector<size_t> visited;
+            bits.for_each_set([&visited](size_t i) { visited.push_back(i); });
+            printTestResult("For Each Set", visited == expected);
+
+            BitArray empty(500);
+            printTestResult("Find First On Empty", empty.find_first() == 500 && empty.find_next(10) == 500);
+        }
+
+        // Test 4: Bulk Operations
+        {
+            BitArray a(150), b(150);
+            for (size_t i = 0; i < 150; i += 2) a.set(i);
+            for (size_t i = 0; i < 150; i += 3) b.set(i);
+
+            printTestResult("AND", (a & b).count() == 25);
+            printTestResult("OR", (a | b).count() == 100);
+            printTestResult("XOR", (a ^ b).count() == 75);
+            BitArray difference = a;
+            difference.and_not(b);
+            printTestResult("ANDNOT", difference.count() == 50 && difference[2] && !difference[6]);
+            printTestResult("Equality", (a | b) == (b | a) && !(a == b));
+
+            bool exceptionThrown = false;
+            try {
+                a &= BitArray(10);
+            } catch (const std::invalid_argument&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Size Mismatch Throws", exceptionThrown);
+        }
+
+        // Test 5: Rank And Select
+        {
+            std::mt19937_64 rng(7);
+            for (double density : {0.001, 0.1, 0.5, 0.99}) {
+                size_t n = 20000 + static_cast<size_t>(density * 1000);
+                BitArray bits(n);
+                std::vector<size_t> positions;
+                std::bernoulli_distribution coin(density);
+                for (size_t i = 0; i < n; ++i) {
+                    if (coin(rng)) {
+                        bits.set(i);
+                        positions.push_back(i);
+                    }
+                }
+                bits.build_rank_select();
+
+                bool rankCorrect = true;
+                size_t expectedRank = 0;
+                for (size_t i = 0; i <= n; ++i) {
+                    if (bits.rank1(i) != expectedRank || bits.rank0(i) != i - expectedRank) rankCorrect = false;
+                    if (i < n && bits[i]) ++expectedRank;
+                }
+                bool selectCorrect = true;
+                for (size_t k = 0; k < positions.size(); ++k) {
+                    if (bits.select1(k) != positions[k]) selectCorrect = false;
+                }
+                if (bits.select1(positions.size()) != n) selectCorrect = false;
+
+                std::string suffix = " (density " + std::to_string(density).substr(0, 5) + ")";
+                printTestResult("Rank" + suffix, rankCorrect);
+                printTestResult("Select" + suffix, selectCorrect);
+            }
+
+            BitArray bits(10);
+            bits.build_rank_select();
+            bits.set(3);
+            bool exceptionThrown = false;
+            try {
+                bits.rank1(5);
+            } catch (const std::logic_error&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Stale Directory Throws", exceptionThrown);
+            bits.build_rank_select();
+            printTestResult("Rebuilt Directory", bits.rank1(5) == 1 && bits.select1(0) == 3);
+        }
+
+        std::cout << "\nAll BitArray tests completed!" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+#ifndef __CONCURRENTHASHMAP_CONCURRENTHASHMAP_HPP
+#define __CONCURRENTHASHMAP_CONCURRENTHASHMAP_HPP
+#include <new>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <functional>
+#include <limits>
+#include <bit>
+#include "./../HashMap/HashMap.hpp"
+
+/*
+ConcurrentHashMap: a HashMap split into independently locked shards
+
+    key --mixed_hash--> [ shard bits | ............ bits used inside the shard ]
+                           |
+            shards:  [ rw lock | HashMap ] [ rw lock | HashMap ] ... [ rw lock | HashMap ]   each on its own cache lines
+
+The high bits of the (mixed) hash pick the shard, the HashMap inside uses the low bits, so keys spread evenly over both.
+Threads touching different shards never contend; readers of the same shard share its lock (std::shared_mutex).
+
+No reference into the map ever escapes a lock, since another thread may rehash the shard right after. Instead:
+    find(key)                     a copy of the value, std::optional
+    visit(key, f)                 f(const V&) under the shard's read lock
+    upsert(key, f, args...)       f(V&) on the existing value, or inserts V(args...), atomically
+    compute_if_absent(key, make)  inserts make() if absent, make runs at most once per key; returns a copy of the value
+    erase_if(key, pred)           erases key iff pred(const V&), atomically
+    erase_if(pred)                erases every entry w/ pred(const K&, const V&), shard by shard
+The callbacks run under the shard's lock: keep them short & never call back into the map (self deadlock).
+Whole map ops (size, for_each, clear) go shard by shard, so they see each shard at a different instant.
+
+Map: the per shard imple, HashMap (see its toggle) by default, e.g. RobinHoodHashMap to bound probe lengths under churn.
+*/
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>, typename Map = HashMap<K, V, Hash, KeyEqual, Alloc>>
+class ConcurrentHashMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Alloc;
+
+    // default_shards(): a power of 2 >= 4 shards per hardware thread, so that contention on any one shard stays rare
+    explicit ConcurrentHashMap(size_t num_shards = default_shards(), const Hash& hash = Hash(), const KeyEqual& key_eq = KeyEqual(),
+                               const Alloc& alloc = Alloc());
+    ~ConcurrentHashMap();
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete; // locks can be neither copied nor moved
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    bool insert(const K& key, const V& val); // insert, or overwrite the value of an existing key. Returns inserted?
+    template <typename... Args>
+    bool try_emplace(const K& key, Args&&... args); // insert V(args...) if absent. Returns inserted?
+    bool erase(const K& key);
+    bool contains(const K& key) const;
+    std::optional<V> find(const K& key) const;
+
+    template <typename F>
+    bool visit(const K& key, F&& f) const; // false if key is absent
+    template <typename F, typename... Args>
+    bool upsert(const K& key, F&& update, Args&&... args); // returns inserted?
+    template <typename F>
+    V compute_if_absent(const K& key, F&& make);
+    template <typename Pred>
+    bool erase_if(const K& key, Pred&& pred);
+    template <typename Pred>
+    size_t erase_if(Pred&& pred); // returns the num of erased entries
+
+    template <typename F>
+    void for_each(F&& f) const; // f(const K&, const V&) on every entry, each shard under its read lock
+
+    size_t size() const;
+    bool empty() const  {return size() == 0;}
+    void clear();
+
+    size_t shard_count() const  {return num_shards_;}
+    static size_t default_shards();
+
+private:
+    struct alignas(64) Shard { // no 2 locks on a cache line, or they contend anyway (false sharing)
+        mutable std::shared_mutex mutex;
+        Map map;
+
+        Shard(const Hash& hash, const KeyEqual& key_eq, const Alloc& alloc) : map(hash, key_eq, alloc) {}
+    };
+
+    Shard* shards_; // num_shards_ of them
+    size_t num_shards_; // a power of 2
+    unsigned shard_shift_; // hash >> shard_shift_ is the shard
+    [[no_unique_address]] Hash hash_fn_;
+
+    Shard& shard_for(const K& key)  {return shards_[shard_index(key)];}
+    const Shard& shard_for(const K& key) const  {return shards_[shard_index(key)];}
+    size_t shard_index(const K& key) const  {return num_shards_ == 1 ? 0 : mixed_hash(hash_fn_, key) >> shard_shift_;}
+};
+
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+size_t ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::default_shards()  {
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    return std::bit_ceil(threads * 4);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::ConcurrentHashMap(size_t num_shards, const Hash& hash, const KeyEqual& key_eq,
+                                                                       const Alloc& alloc)
+    : shards_(nullptr), num_shards_(std::bit_ceil(std::max<size_t>(num_shards, 1))),
+      shard_shift_(static_cast<unsigned>(std::numeric_limits<size_t>::digits - std::countr_zero(num_shards_))), hash_fn_(hash) {
+    // Shard is neither copyable nor movable (the lock), so the shards are constructed in place in raw storage
+    Shard* raw = static_cast<Shard*>(::operator new(num_shards_ * sizeof(Shard), std::align_val_t(alignof(Shard))));
+    size_t built = 0;
+    try {
+        for (; built < num_shards_; ++built)  {
+            new (raw + built) Shard(hash, key_eq, alloc);
+        }
+    } catch (...) {
+        while (built) raw[--built].~Shard();
+        ::operator delete(raw, std::align_val_t(alignof(Shard)));
+        throw;
+    }
+    shards_ = raw;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::~ConcurrentHashMap()  {
+    for (size_t i = 0; i < num_shards_; ++i)  {
+        shards_[i].~Shard();
+    }
+    ::operator delete(shards_, std::align_val_t(alignof(Shard)));
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::insert(const K& key, const V& val)  {
+    Shard& shard = shard_for(key);
+    std::unique_lock lock(shard.mutex);
+    return shard.map.insert_or_assign(key, val).second;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+template <typename... Args>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::try_emplace(const K& key, Args&&... args)  {
+    Shard& shard = shard_for(key);
+    std::unique_lock lock(shard.mutex);
+    return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::erase(const K& key)  {
+    Shard& shard = shard_for(key);
+    std::unique_lock lock(shard.mutex);
+    return shard.map.erase(key);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::contains(const K& key) const  {
+    const Shard& shard = shard_for(key);
+    std::shared_lock lock(shard.mutex);
+    return shard.map.contains(key);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+std::optional<V> ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::find(const K& key) const  {
+    const Shard& shard = shard_for(key);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return std::nullopt;
+    return it->second;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+template <typename F>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::visit(const K& key, F&& f) const  {
+    const Shard& shard = shard_for(key);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return false;
+    f(static_cast<const V&>(it->second));
+    return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+template <typename F, typename... Args>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::upsert(const K& key, F&& update, Args&&... args)  {
+    Shard& shard = shard_for(key);
+    std::unique_lock lock(shard.mutex);
+    auto [it, inserted] = shard.map.try_emplace(key, std::forward<Args>(args)...); // 1 probe either way
+    if (!inserted) update(it->second);
+    return inserted;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+template <typename F>
+V ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::compute_if_absent(const K& key, F&& make)  {
+    Shard& shard = shard_for(key);
+    {
+        std::shared_lock lock(shard.mutex); // the common case, key present, only needs the read lock
+        auto it = shard.map.find(key);
+        if (it != shard.map.end()) return it->second;
+    }
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.map.find(key); // another writer may have been first in between the locks
+    if (it != shard.map.end()) return it->second;
+    return shard.map.try_emplace(key, make()).first->second;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+template <typename Pred>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::erase_if(const K& key, Pred&& pred)  {
+    Shard& shard = shard_for(key);
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end() || !pred(static_cast<const V&>(it->second))) return false;
+    return shard.map.erase(key);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+template <typename Pred>
+size_t ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::erase_if(Pred&& pred)  {
+    size_t erased = 0;
+    Array<K> doomed; // erasing while iterating would skip entries, so collect first
+    for (size_t i = 0; i < num_shards_; ++i)  {
+        std::unique_lock lock(shards_[i].mutex);
+        doomed.clear();
+        for (const auto& entry : shards_[i].map)  {
+            if (pred(entry.first, entry.second)) doomed.push_back(entry.first);
+        }
+        for (const K& key : doomed)  {
+            erased += shards_[i].map.erase(key);
+        }
+    }
+    return erased;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+template <typename F>
+void ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::for_each(F&& f) const  {
+    for (size_t i = 0; i < num_shards_; ++i)  {
+        std::shared_lock lock(shards_[i].mutex);
+        for (const auto& entry : shards_[i].map)  {
+            f(entry.first, entry.second);
+        }
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+size_t ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::size() const  {
+    size_t total = 0;
+    for (size_t i = 0; i < num_shards_; ++i)  {
+        std::shared_lock lock(shards_[i].mutex);
+        total += shards_[i].map.size();
+    }
+    return total;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc, typename Map>
+void ConcurrentHashMap<K, V, Hash, KeyEqual, Alloc, Map>::clear()  {
+    for (size_t i = 0; i < num_shards_; ++i)  {
+        std::unique_lock lock(shards_[i].mutex);
+        shards_[i].map.clear();
+    }
+}
+
+#endif // __CONCURRENTHASHMAP_CONCURRENTHASHMAP_HPP
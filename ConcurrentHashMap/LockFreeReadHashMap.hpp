@@ -0,0 +1,436 @@
+#ifndef __CONCURRENTHASHMAP_LOCKFREEREADHASHMAP_HPP
+#define __CONCURRENTHASHMAP_LOCKFREEREADHASHMAP_HPP
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <bit>
+#include "./../HashMap/HashMap.hpp"
+
+/*
+Epoch based reclamation (EBR): deferring frees until no reader can still hold the memory
+
+    global epoch:   E
+    thread records: [ active @ E ] [ idle ] [ active @ E - 1 ] ...
+
+A reader pins itself before touching shared memory (its record := the current epoch) and unpins after (record := idle).
+A writer that unlinks a block retires it, tagged w/ the current epoch, instead of freeing it.
+The epoch advances from E to E + 1 only once every active record is at E, so by the time it reaches e + 2 every reader that
+could have seen a block retired at e has unpinned: the block is freed then.
+
+Pinning costs a plain store & a fence, unpinning a plain store: readers never run an atomic read-modify-write, so they do not
+bounce a shared cache line between cores. Records are registered once per thread, and reused after the thread exits.
+*/
+class EpochDomain {
+public:
+    static constexpr uint64_t IDLE = 0; // epochs start at 1
+
+    struct Record {
+        std::atomic<uint64_t> epoch{IDLE};
+        std::atomic<bool> in_use{false};
+        Record* next = nullptr; // set before the record is published, never changed after
+        unsigned depth = 0; // nested pins, only touched by the owning thread
+    };
+
+    // RAII pin of the calling thread. Nests
+    class Guard {
+    public:
+        Guard() : record_(EpochDomain::instance().local_record()) {
+            if (record_->depth++ == 0) {
+                record_->epoch.store(EpochDomain::instance().epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                // StoreLoad: the pin must be visible before any shared memory is read, or a writer scanning the records could miss it
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+        ~Guard() {
+            if (--record_->depth == 0) record_->epoch.store(IDLE, std::memory_order_release);
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        Record* record_;
+    };
+
+    static EpochDomain& instance()  {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    uint64_t epoch() const  {return epoch_.load(std::memory_order_acquire);}
+
+    // Advances the epoch if every pinned thread has seen the current one. Returns the (possibly new) epoch
+    uint64_t try_advance()  {
+        std::atomic_thread_fence(std::memory_order_seq_cst); // the writer's unlinking stores go first
+        uint64_t current = epoch_.load(std::memory_order_acquire);
+        for (Record* rec = head_.load(std::memory_order_acquire); rec; rec = rec->next)  {
+            uint64_t pinned = rec->epoch.load(std::memory_order_acquire);
+            if (pinned != IDLE && pinned != current) return current;
+        }
+        epoch_.compare_exchange_strong(current, current + 1, std::memory_order_acq_rel); // on failure, current is reloaded
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    // whether a block retired at retired_epoch can no longer be reached by any reader
+    static bool reclaimable(uint64_t retired_epoch, uint64_t current)  {return current >= retired_epoch + 2;}
+
+private:
+    std::atomic<uint64_t> epoch_{1};
+    std::atomic<Record*> head_{nullptr}; // records are never freed, so readers & writers may walk the list any time
+    std::mutex registry_mutex_;
+
+    EpochDomain() = default;
+
+    struct LocalRecord {
+        Record* record = nullptr;
+        ~LocalRecord() {
+            if (record) record->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    Record* local_record()  {
+        thread_local LocalRecord local;
+        if (!local.record) local.record = acquire_record();
+        return local.record;
+    }
+
+    Record* acquire_record()  {
+        std::lock_guard lock(registry_mutex_);
+        for (Record* rec = head_.load(std::memory_order_acquire); rec; rec = rec->next)  {
+            if (!rec->in_use.load(std::memory_order_acquire)) {
+                rec->in_use.store(true, std::memory_order_relaxed);
+                return rec;
+            }
+        }
+        Record* rec = new Record();
+        rec->in_use.store(true, std::memory_order_relaxed);
+        rec->next = head_.load(std::memory_order_relaxed);
+        head_.store(rec, std::memory_order_release);
+        return rec;
+    }
+};
+
+
+/*
+LockFreeReadHashMap: readers never lock, for read mostly tables (routing tables, configs, caches)
+
+    table_ --> [ capacity | slot: Node* | Node* | TOMBSTONE | null | ... ]     open addressing, linear probing
+                                   |
+                                   v
+                                 [ hash | key | value ]    immutable once published
+
+Readers pin the epoch, load table_ and probe the slots w/ acquire loads only: no locks, no atomic RMWs, no writes to any
+shared line. Since nodes are immutable, a reader always sees a complete entry, old or new.
+Writers are serialized among themselves by a mutex (this map is meant for rare writes) and publish w/ release stores:
+    insert     a new node into an empty or tombstone slot, or, for an existing key, a new node w/ the new value in its place
+    erase      a TOMBSTONE in the key's slot
+    resize     copy on resize: a new table holding the same node ptrs, published by swapping table_
+Replaced nodes & tables are retired to the EpochDomain and freed once no reader can still hold them.
+
+Max fill: 3/4 of the slots, tombstones included. A resize sizes the new table for twice the live keys, so churn at a
+constant size rebuilds the table in place rather than growing it.
+*/
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class LockFreeReadHashMap {
+    struct Node {
+        size_t hash;
+        K key;
+        V val;
+    };
+    struct Table {
+        size_t capacity; // a power of 2
+        std::atomic<Node*>* slots;
+    };
+
+    using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+    using TableAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Table>;
+    using TableTraits = std::allocator_traits<TableAlloc>;
+    using SlotAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::atomic<Node*>>;
+    using SlotTraits = std::allocator_traits<SlotAlloc>;
+
+    static constexpr size_t MIN_CAPACITY = 16;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Alloc;
+
+    LockFreeReadHashMap() : LockFreeReadHashMap(Hash()) {}
+    explicit LockFreeReadHashMap(const Hash& hash, const KeyEqual& key_eq = KeyEqual(), const Alloc& alloc = Alloc());
+    ~LockFreeReadHashMap(); // no reader may be inside the map anymore
+
+    LockFreeReadHashMap(const LockFreeReadHashMap&) = delete;
+    LockFreeReadHashMap& operator=(const LockFreeReadHashMap&) = delete;
+
+    // Readers: wait free apart from the probe itself, safe alongside writers
+    std::optional<V> find(const K& key) const;
+    bool contains(const K& key) const;
+    template <typename F>
+    bool visit(const K& key, F&& f) const; // f(const V&) while the node is pinned. false if key is absent
+    template <typename F>
+    void for_each(F&& f) const; // f(const K&, const V&) over 1 snapshot of the table
+
+    // Writers
+    bool insert(const K& key, const V& val); // insert, or replace the value of an existing key. Returns inserted?
+    bool erase(const K& key);
+    void clear();
+
+    size_t size() const  {return num_keys_.load(std::memory_order_relaxed);}
+    bool empty() const  {return size() == 0;}
+    size_t retired_count() const; // retired blocks not freed yet
+
+private:
+    [[no_unique_address]] Hash hash_fn_;
+    [[no_unique_address]] KeyEqual key_eq_fn_;
+    [[no_unique_address]] NodeAlloc node_alloc_;
+    std::atomic<Table*> table_;
+    std::atomic<size_t> num_keys_; // only written by writers, read by anyone
+    size_t num_tombstones_;
+    mutable std::mutex writer_mutex_;
+
+    struct Retired {
+        void* ptr;
+        bool is_table;
+        uint64_t epoch;
+    };
+    Array<Retired> retired_; // guarded by writer_mutex_
+
+    inline static char tombstone_marker_; // TOMBSTONE's address, never dereferenced
+    static Node* tombstone()  {return reinterpret_cast<Node*>(&tombstone_marker_);}
+
+    size_t hash(const K& key) const  {return mixed_hash(hash_fn_, key);}
+    const Node* find_node(const Table* table, const K& key, size_t hash) const; // caller pins
+
+    Table* allocate_table(size_t capacity);
+    void free_table(Table* table);
+    void free_node(Node* node);
+    void retire(void* ptr, bool is_table);
+    void reclaim(); // frees whatever retired block no reader can reach anymore
+    void resize(size_t new_capacity);
+};
+
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::LockFreeReadHashMap(const Hash& hash, const KeyEqual& key_eq, const Alloc& alloc)
+    : hash_fn_(hash), key_eq_fn_(key_eq), node_alloc_(alloc), table_(nullptr), num_keys_(0), num_tombstones_(0) {
+    table_.store(allocate_table(MIN_CAPACITY), std::memory_order_release);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::~LockFreeReadHashMap()  {
+    Table* table = table_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < table->capacity; ++i)  {
+        Node* node = table->slots[i].load(std::memory_order_relaxed);
+        if (node && node != tombstone()) free_node(node);
+    }
+    free_table(table);
+    for (const Retired& block : retired_)  {
+        if (block.is_table) free_table(static_cast<Table*>(block.ptr));
+        else free_node(static_cast<Node*>(block.ptr));
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+auto LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::allocate_table(size_t capacity) -> Table*  {
+    TableAlloc table_alloc(node_alloc_);
+    SlotAlloc slot_alloc(node_alloc_);
+    Table* table = TableTraits::allocate(table_alloc, 1);
+    std::atomic<Node*>* slots = SlotTraits::allocate(slot_alloc, capacity);
+    for (size_t i = 0; i < capacity; ++i)  {
+        SlotTraits::construct(slot_alloc, slots + i, nullptr);
+    }
+    TableTraits::construct(table_alloc, table, Table{capacity, slots});
+    return table;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::free_table(Table* table)  {
+    TableAlloc table_alloc(node_alloc_);
+    SlotAlloc slot_alloc(node_alloc_);
+    SlotTraits::deallocate(slot_alloc, table->slots, table->capacity); // std::atomic<Node*> is trivially destructible
+    TableTraits::destroy(table_alloc, table);
+    TableTraits::deallocate(table_alloc, table, 1);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::free_node(Node* node)  {
+    NodeTraits::destroy(node_alloc_, node);
+    NodeTraits::deallocate(node_alloc_, node, 1);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+auto LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::find_node(const Table* table, const K& key, size_t hash) const -> const Node*  {
+    size_t mask = table->capacity - 1;
+    for (size_t idx = hash & mask; ; idx = (idx + 1) & mask)  {
+        const Node* node = table->slots[idx].load(std::memory_order_acquire);
+        if (!node) return nullptr; // the max fill guarantees an empty slot
+        if (node != tombstone() && node->hash == hash && key_eq_fn_(node->key, key)) return node;
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+std::optional<V> LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::find(const K& key) const  {
+    EpochDomain::Guard guard;
+    const Node* node = find_node(table_.load(std::memory_order_acquire), key, hash(key));
+    if (!node) return std::nullopt;
+    return node->val;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+bool LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::contains(const K& key) const  {
+    EpochDomain::Guard guard;
+    return find_node(table_.load(std::memory_order_acquire), key, hash(key)) != nullptr;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename F>
+bool LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::visit(const K& key, F&& f) const  {
+    EpochDomain::Guard guard;
+    const Node* node = find_node(table_.load(std::memory_order_acquire), key, hash(key));
+    if (!node) return false;
+    f(node->val);
+    return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename F>
+void LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::for_each(F&& f) const  {
+    EpochDomain::Guard guard;
+    const Table* table = table_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < table->capacity; ++i)  {
+        const Node* node = table->slots[i].load(std::memory_order_acquire);
+        if (node && node != tombstone()) f(node->key, node->val);
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::retire(void* ptr, bool is_table)  {
+    retired_.push_back(Retired{ptr, is_table, EpochDomain::instance().epoch()});
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::reclaim()  {
+    if (retired_.empty()) return;
+    uint64_t current = EpochDomain::instance().try_advance();
+    for (size_t i = 0; i < retired_.size(); )  {
+        if (EpochDomain::reclaimable(retired_[i].epoch, current)) {
+            if (retired_[i].is_table) free_table(static_cast<Table*>(retired_[i].ptr));
+            else free_node(static_cast<Node*>(retired_[i].ptr));
+            retired_.swap_remove(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::resize(size_t new_capacity)  {
+    Table* old_table = table_.load(std::memory_order_relaxed);
+    Table* new_table = allocate_table(new_capacity);
+    size_t mask = new_capacity - 1;
+    for (size_t i = 0; i < old_table->capacity; ++i)  {
+        Node* node = old_table->slots[i].load(std::memory_order_relaxed);
+        if (!node || node == tombstone()) continue;
+        size_t idx = node->hash & mask;
+        while (new_table->slots[idx].load(std::memory_order_relaxed)) idx = (idx + 1) & mask;
+        new_table->slots[idx].store(node, std::memory_order_relaxed); // published below, along w/ the table
+    }
+    table_.store(new_table, std::memory_order_release);
+    num_tombstones_ = 0;
+    retire(old_table, true); // the nodes live on in new_table
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+bool LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::insert(const K& key, const V& val)  {
+    std::lock_guard lock(writer_mutex_);
+    size_t h = hash(key);
+    Node* fresh = NodeTraits::allocate(node_alloc_, 1);
+    try {
+        NodeTraits::construct(node_alloc_, fresh, Node{h, key, val});
+    } catch (...) {
+        NodeTraits::deallocate(node_alloc_, fresh, 1);
+        throw;
+    }
+
+    Table* table = table_.load(std::memory_order_relaxed); // only writers change table_, and we hold their lock
+    size_t mask = table->capacity - 1;
+    size_t idx = h & mask;
+    size_t reuse = static_cast<size_t>(-1);
+    for (; ; idx = (idx + 1) & mask)  {
+        Node* node = table->slots[idx].load(std::memory_order_relaxed);
+        if (!node) break;
+        if (node == tombstone()) {
+            if (reuse == static_cast<size_t>(-1)) reuse = idx;
+        } else if (node->hash == h && key_eq_fn_(node->key, key)) {
+            table->slots[idx].store(fresh, std::memory_order_release); // readers see the old node or the new one
+            retire(node, false);
+            reclaim();
+            return false;
+        }
+    }
+
+    size_t live = num_keys_.load(std::memory_order_relaxed);
+    if (reuse == static_cast<size_t>(-1) && (live + num_tombstones_ + 1) * 4 > table->capacity * 3) {
+        resize(std::max(MIN_CAPACITY, std::bit_ceil((live + 1) * 2))); // copy on resize: readers of the old table carry on
+        table = table_.load(std::memory_order_relaxed);
+        mask = table->capacity - 1;
+        idx = h & mask;
+        while (table->slots[idx].load(std::memory_order_relaxed)) idx = (idx + 1) & mask;
+    } else if (reuse != static_cast<size_t>(-1)) {
+        idx = reuse;
+        --num_tombstones_;
+    }
+    table->slots[idx].store(fresh, std::memory_order_release);
+    num_keys_.store(live + 1, std::memory_order_relaxed);
+    reclaim();
+    return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+bool LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::erase(const K& key)  {
+    std::lock_guard lock(writer_mutex_);
+    size_t h = hash(key);
+    Table* table = table_.load(std::memory_order_relaxed);
+    size_t mask = table->capacity - 1;
+    for (size_t idx = h & mask; ; idx = (idx + 1) & mask)  {
+        Node* node = table->slots[idx].load(std::memory_order_relaxed);
+        if (!node) return false;
+        if (node != tombstone() && node->hash == h && key_eq_fn_(node->key, key)) {
+            table->slots[idx].store(tombstone(), std::memory_order_release);
+            ++num_tombstones_;
+            num_keys_.store(num_keys_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            retire(node, false);
+            reclaim();
+            return true;
+        }
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::clear()  {
+    std::lock_guard lock(writer_mutex_);
+    Table* old_table = table_.load(std::memory_order_relaxed);
+    table_.store(allocate_table(MIN_CAPACITY), std::memory_order_release);
+    for (size_t i = 0; i < old_table->capacity; ++i)  {
+        Node* node = old_table->slots[i].load(std::memory_order_relaxed);
+        if (node && node != tombstone()) retire(node, false);
+    }
+    retire(old_table, true);
+    num_keys_.store(0, std::memory_order_relaxed);
+    num_tombstones_ = 0;
+    reclaim();
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+size_t LockFreeReadHashMap<K, V, Hash, KeyEqual, Alloc>::retired_count() const  {
+    std::lock_guard lock(writer_mutex_);
+    return retired_.size();
+}
+
+#endif // __CONCURRENTHASHMAP_LOCKFREEREADHASHMAP_HPP
@@ -0,0 +1,99 @@
+// Throughput of ConcurrentHashMap & LockFreeReadHashMap vs a HashMap behind 1 global mutex, on 1 to 2x hardware threads.
+// Build w/ optimizations & w/out sanitizers: make bench
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <string>
+#include "ConcurrentHashMap.hpp"
+#include "LockFreeReadHashMap.hpp"
+
+// The baseline: every op serializes on 1 lock
+class MutexHashMap {
+public:
+    void insert(int key, int val) {
+        std::lock_guard lock(mutex_);
+        map_.insert(key, val);
+    }
+    bool contains(int key) const {
+        std::lock_guard lock(mutex_);
+        return map_.contains(key);
+    }
+    bool erase(int key) {
+        std::lock_guard lock(mutex_);
+        return map_.erase(key);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    HashMap<int, int> map_;
+};
+
+constexpr int KEY_RANGE = 1 << 20;
+constexpr int OPS_PER_THREAD = 1 << 20;
+std::atomic<long long> lookup_hits{0}; // the lookups' results go here, so they cannot be optimized out
+
+// Mops/s over num_threads threads, each running OPS_PER_THREAD random ops, read_percent of them lookups
+template <typename MapType>
+double run(MapType& Map, int num_threads, int read_percent) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 gen(t);
+            std::uniform_int_distribution<> keys(0, KEY_RANGE - 1);
+            std::uniform_int_distribution<> percent(0, 99);
+            long long local_hits = 0;
+            while (!go.load(std::memory_order_acquire)) {}
+            for (int i = 0; i < OPS_PER_THREAD; ++i) {
+                int key = keys(gen);
+                int op = percent(gen);
+                if (op < read_percent) local_hits += Map.contains(key);
+                else if (op % 2 == 0) Map.insert(key, i);
+                else Map.erase(key);
+            }
+            lookup_hits += local_hits;
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return num_threads * static_cast<double>(OPS_PER_THREAD) / elapsed.count() / 1e6;
+}
+
+template <typename MapType>
+void prefill(MapType& Map) {
+    for (int key = 0; key < KEY_RANGE; key += 2) {
+        Map.insert(key, key);
+    }
+}
+
+int main() {
+    int max_threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()) * 2);
+    std::cout << "Mops/s, " << KEY_RANGE << " keys, half of them present" << std::endl;
+    std::cout << std::setw(8) << "reads %" << std::setw(9) << "threads" << std::setw(14) << "mutex map" << std::setw(14) << "sharded map"
+              << std::setw(16) << "lock free reads" << std::endl;
+    for (int read_percent : {50, 90, 99, 100}) {
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            MutexHashMap Locked;
+            ConcurrentHashMap<int, int> Sharded;
+            LockFreeReadHashMap<int, int> LockFree;
+            prefill(Locked);
+            prefill(Sharded);
+            prefill(LockFree);
+            double locked = run(Locked, threads, read_percent);
+            double sharded = run(Sharded, threads, read_percent);
+            double lock_free = run(LockFree, threads, read_percent);
+            std::cout << std::setw(8) << read_percent << std::setw(9) << threads << std::fixed << std::setprecision(2)
+                      << std::setw(14) << locked << std::setw(14) << sharded << std::setw(16) << lock_free << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include "ConcurrentHashMap.hpp"
+#include "LockFreeReadHashMap.hpp"
+
+void printTestResult(const std::string& testName, bool passed) {
+    std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+// Runs fn(thread_idx) on num_threads threads at once
+template <typename Fn>
+void runThreads(int num_threads, Fn fn) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back(fn, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+int main() {
+    try {
+        // Test 1: Basic Operations
+        {
+            ConcurrentHashMap<std::string, int> Map(5);
+            printTestResult("Shard Count Rounded To Power Of 2", Map.shard_count() == 8);
+            printTestResult("Initial Empty Check", Map.empty() && Map.size() == 0);
+
+            printTestResult("Insert - New Key", Map.insert("one", 1));
+            printTestResult("Insert - Overwrites", !Map.insert("one", 11) && Map.find("one") == 11);
+            printTestResult("Try Emplace - Keeps Value", Map.try_emplace("two", 2) && !Map.try_emplace("two", 22) && Map.find("two") == 2);
+            printTestResult("Find - Missing Key", !Map.find("three").has_value() && !Map.contains("three"));
+
+            int seen = 0;
+            printTestResult("Visit", Map.visit("two", [&seen](const int& val) { seen = val; }) && seen == 2
+                            && !Map.visit("three", [&seen](const int&) { seen = -1; }));
+
+            printTestResult("Erase", Map.erase("one") && !Map.erase("one") && Map.size() == 1);
+            Map.clear();
+            printTestResult("Clear", Map.empty());
+        }
+
+        // Test 2: Atomic Compound Operations
+        {
+            ConcurrentHashMap<int, int> Map;
+            printTestResult("Upsert - Inserts", Map.upsert(1, [](int& val) { ++val; }, 10) && Map.find(1) == 10);
+            printTestResult("Upsert - Updates", !Map.upsert(1, [](int& val) { ++val; }, 10) && Map.find(1) == 11);
+
+            int calls = 0;
+            auto make = [&calls]() { ++calls; return 42; };
+            printTestResult("Compute If Absent", Map.compute_if_absent(2, make) == 42 && Map.compute_if_absent(2, make) == 42 && calls == 1);
+
+            printTestResult("Erase If - Key", !Map.erase_if(1, [](const int& val) { return val > 100; }) && Map.contains(1)
+                            && Map.erase_if(1, [](const int& val) { return val == 11; }) && !Map.contains(1));
+
+            for (int i = 0; i < 1000; ++i) {
+                Map.insert(i, i);
+            }
+            size_t erased = Map.erase_if([](const int& key, const int&) { return key % 2 == 0; });
+            printTestResult("Erase If - Predicate", erased == 500 && Map.size() == 500 && !Map.contains(10) && Map.contains(11));
+
+            long long sum = 0;
+            Map.for_each([&sum](const int& key, const int& val) { sum += key + val; });
+            printTestResult("For Each", sum == 2LL * 500 * 500);
+        }
+
+        // Test 3: Concurrent Writers And Readers
+        {
+            constexpr int numThreads = 4;
+            constexpr int numKeys = 2000;
+            ConcurrentHashMap<int, long long> Map(4); // few shards: lots of contention
+
+            // every thread increments every counter: no increment may get lost
+            runThreads(numThreads, [&Map](int) {
+                for (int i = 0; i < numKeys; ++i) {
+                    Map.upsert(i, [](long long& val) { ++val; }, 1LL);
+                }
+            });
+            bool allCounted = true;
+            for (int i = 0; i < numKeys; ++i) {
+                if (Map.find(i) != numThreads) allCounted = false;
+            }
+            printTestResult("Concurrent Upsert - No Lost Updates", allCounted && Map.size() == numKeys);
+
+            std::atomic<int> made{0};
+            ConcurrentHashMap<int, int> Lazy(4);
+            runThreads(numThreads, [&Lazy, &made](int) {
+                for (int i = 0; i < numKeys; ++i) {
+                    Lazy.compute_if_absent(i, [&made, i]() { ++made; return i * 2; });
+                }
+            });
+            printTestResult("Concurrent Compute If Absent - Made Once Per Key", made == numKeys && Lazy.find(numKeys - 1) == 2 * (numKeys - 1));
+
+            // writers insert & erase their own key ranges while readers check the keys that are never touched
+            for (int i = 0; i < numKeys; ++i) {
+                Lazy.insert(-1 - i, i);
+            }
+            std::atomic<bool> readsConsistent{true};
+            runThreads(numThreads, [&Lazy, &readsConsistent](int t) {
+                for (int round = 0; round < 5; ++round) {
+                    for (int i = 0; i < numKeys; ++i) {
+                        if (t % 2 == 0) {
+                            Lazy.insert(numKeys * (t + 1) + i, i);
+                            Lazy.erase(numKeys * (t + 1) + i - 1);
+                        } else if (Lazy.find(-1 - i) != i) {
+                            readsConsistent = false;
+                        }
+                    }
+                }
+            });
+            printTestResult("Concurrent Readers And Writers", readsConsistent);
+        }
+
+        // Test 4: Other Per Shard Maps
+        {
+            ConcurrentHashMap<int, int, std::hash<int>, std::equal_to<int>, std::allocator<std::pair<const int, int>>,
+                              RobinHoodHashMap<int, int>> Map(2);
+            runThreads(2, [&Map](int t) {
+                for (int i = 0; i < 1000; ++i) {
+                    Map.insert(t * 1000 + i, i);
+                }
+            });
+            printTestResult("Robin Hood Shards", Map.size() == 2000 && Map.find(1999) == 999);
+        }
+
+        // Test 5: Lock Free Reads
+        {
+            LockFreeReadHashMap<std::string, int> Map;
+            printTestResult("Lock Free - Initial Empty Check", Map.empty() && !Map.find("one").has_value());
+            printTestResult("Lock Free - Insert", Map.insert("one", 1) && Map.find("one") == 1 && Map.contains("one"));
+            printTestResult("Lock Free - Insert Replaces", !Map.insert("one", 11) && Map.find("one") == 11 && Map.size() == 1);
+
+            int seen = 0;
+            printTestResult("Lock Free - Visit", Map.visit("one", [&seen](const int& val) { seen = val; }) && seen == 11
+                            && !Map.visit("two", [&seen](const int&) { seen = -1; }));
+            printTestResult("Lock Free - Erase", Map.erase("one") && !Map.erase("one") && Map.empty() && !Map.contains("one"));
+
+            for (int i = 0; i < 1000; ++i) {
+                Map.insert(std::to_string(i), i); // several copy on resizes
+            }
+            long long sum = 0;
+            Map.for_each([&sum](const std::string&, const int& val) { sum += val; });
+            printTestResult("Lock Free - Resize Keeps Keys", Map.size() == 1000 && Map.find("999") == 999 && sum == 999LL * 1000 / 2);
+
+            // churn at a constant size: tombstones get cleaned up by rebuilding, not by growing the table forever
+            for (int round = 0; round < 20; ++round) {
+                for (int i = 0; i < 1000; ++i) {
+                    Map.erase(std::to_string(i));
+                    Map.insert(std::to_string(i), i + round);
+                }
+            }
+            printTestResult("Lock Free - Churn", Map.size() == 1000 && Map.find("0") == 19);
+            // w/out readers, every retired node & table gets freed within a couple of epochs
+            printTestResult("Lock Free - Retired Blocks Reclaimed", Map.retired_count() < 8);
+            Map.clear();
+            printTestResult("Lock Free - Clear", Map.empty() && !Map.contains("5"));
+        }
+
+        // Test 6: Lock Free Reads Alongside Writers
+        {
+            constexpr int numKeys = 2000;
+            LockFreeReadHashMap<int, std::string> Map;
+            for (int i = 0; i < numKeys; ++i) {
+                Map.insert(-1 - i, std::to_string(i));
+            }
+            // 1 writer churns (resizes, replaces, erases) while readers check the stable keys: a reclaimed node would crash them
+            std::atomic<bool> readsConsistent{true};
+            runThreads(4, [&Map, &readsConsistent](int t) {
+                for (int round = 0; round < 5; ++round) {
+                    for (int i = 0; i < numKeys; ++i) {
+                        if (t == 0) {
+                            Map.insert(i, std::to_string(i + round));
+                            Map.insert(-1 - i, std::to_string(i)); // same value, new node
+                            if (i % 2) Map.erase(i - 1);
+                        } else if (Map.find(-1 - i) != std::to_string(i)) {
+                            readsConsistent = false;
+                        }
+                    }
+                }
+            });
+            printTestResult("Lock Free - Concurrent Readers And Writer", readsConsistent && Map.find(-numKeys) == std::to_string(numKeys - 1));
+        }
+
+        std::cout << "\nAll ConcurrentHashMap tests completed!" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
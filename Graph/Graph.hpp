@@ -5,10 +5,12 @@
 #include <algorithm> // for vector reverse
 
 #include "../Array/Array.hpp"
+#include "../Array/ArraySIMD.hpp"
 #include "../Stack/Stack.hpp"
 #include "../Queue/Queue.hpp"
 #include "../PriorityQueue/PriorityQueue.hpp"
 #include "../HashMap/HashMap.hpp"
+#include "../BitArray/BitArray.hpp"
 /*
 - Three imples
  - Adjacency Matrix O(V^2)
@@ -32,7 +34,7 @@ class Graph {
 private:
 
     Array<int> adjMatrix; // use a 1D array to reduce space complexity by half, as undir graph adjMatrix is symmetric.
-    HashMap<T, size_t> map2index;
+    OrderedHashMap<T, size_t> map2index; // iterates in insertion order, i.e. by ascending index, see removeVertex
     HashMap<size_t, T> map2vertex;
 
     // static const int INF = 0x3f3f3f3f;  don't use this or linker error
@@ -140,7 +142,8 @@ bool Graph<T>::removeVertex(const T& vertex)    {
     if (!map2index.contains(vertex))  return false;
     size_t new_num_vertices = num_vertices - 1;
     size_t new_matrix_size = new_num_vertices * (new_num_vertices + 1) / 2;
-    Array<int> ShrinkedMatrix(new_matrix_size, INF);
+    Array<int> ShrinkedMatrix; // filled below in the new matrix's own order, so it must start out empty
+    ShrinkedMatrix.reserve(new_matrix_size);
 
     size_t rmIndex = map2index[vertex];
 
@@ -153,21 +156,22 @@ bool Graph<T>::removeVertex(const T& vertex)    {
     }
     adjMatrix = std::move(ShrinkedMatrix);
     num_vertices = new_num_vertices;
-    map2index.erase(vertex);
     map2vertex.erase(rmIndex);
 
     // NOTE: after vertex removal, previous vertex<->index relationship becomes invalid and need to be updated.
 
-    for (auto& pair : map2index)    {
+    // Vertices get their index in insertion order and keep their relative order on removal, so map2index iterates by
+    // ascending index: exactly the vertices after the removed one need a new index, w/out scanning the whole table.
+    auto it = map2index.find(vertex);
+    for (++it; it != map2index.end(); ++it)    {
         // key is vertex, val is index
-        if (pair.val() > rmIndex)   {
-            size_t old_idx = pair.val();
-            size_t new_idx = old_idx - 1;
+        size_t old_idx = it->val();
+        size_t new_idx = old_idx - 1;
 
-            pair.val() = new_idx;
-            map2vertex[new_idx] = pair.key();
-        }
+        it->val() = new_idx;
+        map2vertex[new_idx] = it->key();
     }
+    map2index.erase(vertex); // only after the walk, it starts from the vertex's entry
 
     // Remove nullified index after shrinkage
     map2vertex.erase(num_vertices);
@@ -218,10 +222,10 @@ void Graph<T>::dfs(const T& start, const std::function<void(const T&)>& visit) c
     // complete visit of neighbour's neighbours before another neighbour
     if (!map2index.contains(start)) return;
     Stack<size_t> stack; // index as vertex ptr
-    HashMap<size_t, bool> visited;
+    BitArray visited(num_vertices); // vertex idxs are dense, so 1 bit per vertex instead of a hashed entry
     size_t current = map2index[start];
     stack.push(current);
-    visited[current] = true;
+    visited.set(current);
 
     while (!stack.empty())   {
         current = stack.top();
@@ -230,7 +234,7 @@ void Graph<T>::dfs(const T& start, const std::function<void(const T&)>& visit) c
         for (size_t i = 0; i < num_vertices; ++i)  {
             if (hasEdge(current, i) && !visited[i]) {
                 stack.push(i);
-                visited[i] = true;
+                visited.set(i);
                 // DO NOT set visited to true after the visit() call on that vertex!
                 // visited essentially represents whether it has been pushed onto the stack instead of being processed.
             }
@@ -243,10 +247,10 @@ void Graph<T>::bfs(const T& start, const std::function<void(const T&)>& visit) c
     // complete visit of all neighbours before neighbour's neighbours
     if (!map2index.contains(start)) return;
     Queue<size_t> queue; // index as vertex ptr
-    HashMap<size_t, bool> visited;
+    BitArray visited(num_vertices); // vertex idxs are dense, so 1 bit per vertex instead of a hashed entry
     size_t current = map2index[start];
     queue.push(current);
-    visited[current] = true;
+    visited.set(current);
 
     while (!queue.empty())   {
         current = queue.front();
@@ -255,7 +259,7 @@ void Graph<T>::bfs(const T& start, const std::function<void(const T&)>& visit) c
         for (size_t i = 0; i < num_vertices; ++i)  {
             if (hasEdge(current, i) && !visited[i]) {
                 queue.push(i);
-                visited[i] = true;
+                visited.set(i);
             }
         }
     }
@@ -266,18 +270,11 @@ template <typename T>
 std::vector<T> Graph<T>::shortestPath(const T& start, const T& end) const {
     bool isUnweighted = true;
     bool isPositiveDefinite = true;
-    for (auto weight : adjMatrix)   {
-        if (weight < 0) {
-            isPositiveDefinite = false;
-        }   else if (weight != INF && weight != 1)   {
-            isUnweighted = false;
-        }   
-    }
-
-    for (auto weight : adjMatrix)   {
-        if (weight != INF && weight != 1)   {
-            isUnweighted = false;
-        }
+    if (!adjMatrix.empty()) {
+        // vectorized scans over the matrix instead of one bounds checked access per entry
+        isPositiveDefinite = simd_min(adjMatrix) >= 0;
+        // unweighted: every entry is either "no edge" or weight 1
+        isUnweighted = simd_count(adjMatrix, 1) + simd_count(adjMatrix, static_cast<int>(INF)) == adjMatrix.size();
     }
 
     std::vector<T> path;
@@ -288,7 +285,7 @@ std::vector<T> Graph<T>::shortestPath(const T& start, const T& end) const {
         if (!map2index.contains(start) || !map2index.contains(end)) return path;
 
         Queue<size_t> queue; // index as vertex ptr
-        HashMap<size_t, bool> visited;
+        BitArray visited(num_vertices);
         HashMap<size_t, int> distance;
         HashMap<size_t, size_t> parent;
 
@@ -298,17 +295,17 @@ std::vector<T> Graph<T>::shortestPath(const T& start, const T& end) const {
         size_t current = start_idx;
 
         queue.push(current);
-        visited[current] = true;
+        visited.set(current);
         distance[current] = 0;
 
         while (!queue.empty())   {
-            if (visited.contains(end_idx)) break;
+            if (visited.test(end_idx)) break;
             current = queue.front();
             queue.pop();
             for (size_t i = 0; i < num_vertices; ++i)  {
                 if (hasEdge(current, i) && !visited[i]) {
                     queue.push(i);
-                    visited[i] = true;
+                    visited.set(i);
                     distance[i] = distance[current] + 1;
                     parent[i] = current;
                 }
@@ -379,7 +376,7 @@ std::vector<T> Graph<T>::shortestPath(const T& start, const T& end) const {
         if (!map2index.contains(start) || !map2index.contains(end)) return path;
          
         PriorityQueue<std::pair<int, size_t>> pq; // (dist, index). Leverage std::pair default lexicographic ordering.
-        HashMap<size_t, bool> finalized;
+        BitArray finalized(num_vertices);
         HashMap<size_t, int> dist;
         HashMap<size_t, size_t> parent;
 
@@ -402,7 +399,7 @@ std::vector<T> Graph<T>::shortestPath(const T& start, const T& end) const {
         while (!pq.empty()) {
             current = pq.top().second;
             pq.pop();
-            finalized[current] = true;
+            finalized.set(current);
             if (current == end_idx) break;
             for (size_t i = 0; i < num_vertices; ++i)   {
                 if (finalized[i]) continue; // Skip already processed nodes
@@ -440,7 +437,7 @@ template <typename T>
 std::vector<std::vector<T>> Graph<T>::getConnectedComponents() const {
     /*
     Algorithm GetConnectedComponents(graph):
-    Init visited = empty hashmap
+    Init visited = all clear bit arr
     Init components = empty vec of vec
     
     For each vertex in graph:
@@ -454,7 +451,7 @@ std::vector<std::vector<T>> Graph<T>::getConnectedComponents() const {
     Return components
     */
 
-   HashMap<size_t, bool> visited;
+   BitArray visited(num_vertices);
    std::vector<std::vector<T>> components;
 
    for (size_t i = 0; i < num_vertices; ++i)   {
@@ -462,7 +459,7 @@ std::vector<std::vector<T>> Graph<T>::getConnectedComponents() const {
             std::vector<T> current_component;
             auto& start = map2vertex[i]; // Reference safe because map2vertex can't be modified in a const function
             bfs(start, [&visited, &current_component, this](const T& vertex) {
-                visited[map2index[vertex]] = true;
+                visited.set(map2index[vertex]);
                 current_component.push_back(vertex);
             });
             components.push_back(current_component);
@@ -484,13 +481,10 @@ size_t Graph<T>::size() const {
 
 template <typename T>
 size_t Graph<T>::edgeCount() const {
-    size_t count = 0;
-    for (const auto& elem : adjMatrix)  {
-        if (elem != INF) ++count; // upper triangle ensures no double counting
-        // Why we don't maintain a edge count member is because it's tricky to account for
-        // the edge count during vertex removal.
-    }
-    return count;
+    // upper triangle ensures no double counting
+    // Why we don't maintain a edge count member is because it's tricky to account for
+    // the edge count during vertex removal.
+    return adjMatrix.size() - simd_count(adjMatrix, static_cast<int>(INF));
 }
 
 
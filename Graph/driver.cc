@@ -102,6 +102,13 @@ int main() {
             printTestResult("Vertex Removal", !graph.hasVertex(3));
             printTestResult("Size After Vertex Removal", graph.size() == 4);
             printTestResult("Edge Count After Vertex Removal", graph.edgeCount() == 2);
+            // the vertices after the removed one shift down an index: their edges must follow
+            printTestResult("Edges Kept After Vertex Removal", graph.hasEdge(1, 2) && graph.hasEdge(4, 5) && !graph.hasEdge(2, 4));
+            graph.removeVertex(1);
+            graph.addVertex(6);
+            graph.addEdge(5, 6);
+            printTestResult("Edges Kept After Removing The First Vertex", graph.hasEdge(4, 5) && graph.hasEdge(5, 6) && !graph.hasEdge(2, 6)
+                            && graph.size() == 4);
         }
 
         // Test 4: Edge Cases
@@ -3,45 +3,234 @@
 
 #include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <bit>
+#include <string_view>
+#include <span>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#ifdef HASHMAP_STATS
+#include <atomic>
+#include <chrono>
+#endif
 #include "./../Array/Array.hpp"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 
+/*
+Imple toggle: HashMap<K, V> refers to exactly one of the imples below, chosen by defining one of
+    COMPACT_DICT        dense entries in insertion order, indexed by a table of 1 to 8 B slots
+    SEPARATE_CHAIN      buckets of linked nodes, pooled in 1 slab
+    CTRL_BYTES          open addressing w/ a separate 1 B control tag per slot, probed 16 slots at a time w/ SSE2
+    ROBIN_HOOD          open addressing w/ linear probing ordered by probe distance, erase w/out tombstones
+    INCREMENTAL_REHASH  Robin Hood tables, grown a few slots per op instead of all at once
+    OPEN_ADDR           open addressing w/ linear probing and in-entry flags (default)
+before including this header (or w/ -D on the command line). Every imple is also available under its own name
+(OpenAddrHashMap, CtrlByteHashMap, RobinHoodHashMap, IncrementalHashMap, ChainedHashMap, OrderedHashMap), so they can be
+compared side by side regardless of the toggle.
+*/
+// #define COMPACT_DICT
 // #define SEPARATE_CHAIN
+// #define CTRL_BYTES
+// #define ROBIN_HOOD
+// #define INCREMENTAL_REHASH
+#if !defined(COMPACT_DICT) && !defined(SEPARATE_CHAIN) && !defined(CTRL_BYTES) && !defined(ROBIN_HOOD) && !defined(INCREMENTAL_REHASH)
 #define OPEN_ADDR
+#endif
+
+
+// Finalizer of MurmurHash3: spreads every input bit over the whole word. std::hash of integers is the identity,
+// whose low & high bits are far from random, which matters as soon as we slice the hash into parts (or mask it).
+inline size_t hash_mix(size_t h)  {
+    uint64_t x = static_cast<uint64_t>(h);
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+}
 
+/*
+Hash: any std::hash-like functor. Its result goes through hash_mix, unless the functor declares that its output is
+uniformly spread already (e.g. a wyhash or xxh3 wrapper for strings), by
+    struct WyHash { using is_avalanching = void; size_t operator()(const std::string&) const; };
+*/
+template <typename Hash, typename = void>
+struct hash_is_avalanching : std::false_type {};
+template <typename Hash>
+struct hash_is_avalanching<Hash, std::void_t<typename Hash::is_avalanching>> : std::true_type {};
+
+template <typename Hash, typename K>
+size_t mixed_hash(const Hash& hash_fn, const K& key)  {
+    if constexpr (hash_is_avalanching<Hash>::value) return hash_fn(key);
+    else return hash_mix(hash_fn(key));
+}
 
-#ifdef SEPARATE_CHAIN
-
+// Asks the CPU to start loading the cache line at ptr, w/out waiting for it. A hint only: a no-op where unsupported
+inline void prefetch_read(const void* ptr)  {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr, 0, 3);
+#else
+    (void)ptr;
+#endif
+}
 
-#elif defined(OPEN_ADDR)
+// Longest run of consecutive slots i in [0, n) w/ busy(i), wrapping around the end
+template <typename Busy>
+size_t longest_run(size_t n, Busy busy)  {
+    size_t start = 0;
+    while (start < n && busy(start)) ++start;
+    if (start == n) return n;
+    size_t longest = 0, run = 0;
+    for (size_t k = 1; k <= n; ++k)  { // from just past a free slot, all the way around to it
+        if (busy((start + k) % n)) longest = std::max(longest, ++run);
+        else run = 0;
+    }
+    return longest;
+}
 
 /*
-Collision resolution: Open Addressing
+Stats: define HASHMAP_STATS (before including this header, or w/ -D) to have every imple record
+    probe lengths       histograms of the slots examined per lookup (groups for control bytes, nodes for chaining),
+                        for hits & misses apart. Inserts count as the lookup they start w/
+    rehashes            how many, and their total duration
+    peak load factor    the highest load_factor() after any insert
+and hand them out, along w/ a scan of the table for tombstones & the longest cluster (chain for chaining), through
+    HashMapStats stats = Map.stats();   stats.to_json();
+A clustered probe histogram or a huge max cluster points at a bad hash function, a climbing tombstone ratio at churn the
+table never recovers from.
+Without HASHMAP_STATS, the recorder each imple holds is an empty type whose calls compile to nothing, and stats() does
+not exist: no space, no time.
+*/
+struct HashMapStats {
+    static constexpr size_t PROBE_BINS = 16; // probe lengths 0 .. 14, the last bin counts 15 & longer
+
+    uint64_t hit_probes[PROBE_BINS] = {};
+    uint64_t miss_probes[PROBE_BINS] = {};
+    uint64_t rehashes = 0;
+    uint64_t rehash_ns = 0; // total over all rehashes
+    double peak_load_factor = 0.0;
+    size_t tombstones = 0;
+    double tombstone_ratio = 0.0; // tombstones per slot
+    size_t max_cluster_length = 0; // longest run of non empty slots, or longest chain
+
+    std::string to_json() const;
+};
 
-Open as opposed to closed/fixed addressing (chaining)
+inline std::string HashMapStats::to_json() const  {
+    auto histogram = [](const uint64_t* bins) {
+        std::string out = "[";
+        for (size_t i = 0; i < PROBE_BINS; ++i)  {
+            out += (i ? ", " : "") + std::to_string(bins[i]);
+        }
+        return out + "]";
+    };
+    return "{\"hit_probes\": " + histogram(hit_probes) + ", \"miss_probes\": " + histogram(miss_probes)
+         + ", \"rehashes\": " + std::to_string(rehashes) + ", \"rehash_ns\": " + std::to_string(rehash_ns)
+         + ", \"peak_load_factor\": " + std::to_string(peak_load_factor) + ", \"tombstones\": " + std::to_string(tombstones)
+         + ", \"tombstone_ratio\": " + std::to_string(tombstone_ratio)
+         + ", \"max_cluster_length\": " + std::to_string(max_cluster_length) + "}";
+}
 
-in inserting, we attempt key, and if occupied jump according to probing scheme until next empty space is found
-in probing, we start from key and jump according to probing scheme until next empty space is found.
-It is impossible for there to be some empty spaces to be probed before the to-be-found key, as it would contradict the inserting mechanism
+#ifdef HASHMAP_STATS
+// The counters an imple updates as it runs. Lookups are const & may run concurrently (e.g. under a shared lock), hence
+// relaxed atomics for the probe counts
+class StatsRecorder {
+public:
+    StatsRecorder() = default;
+    StatsRecorder(const StatsRecorder& other)  {*this = other;}
+    StatsRecorder& operator=(const StatsRecorder& other)  {
+        for (size_t i = 0; i < HashMapStats::PROBE_BINS; ++i)  {
+            hits_[i].store(other.hits_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            misses_[i].store(other.misses_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        rehashes_ = other.rehashes_;
+        rehash_ns_ = other.rehash_ns_;
+        peak_load_ = other.peak_load_;
+        return *this;
+    }
 
-With open addr, load_factor cannot >= 1.
-Common resizing threshold is .7
+    void probe(bool hit, size_t length) const  {
+        size_t bin = std::min(length, HashMapStats::PROBE_BINS - 1);
+        if (hit) hits_[bin].fetch_add(1, std::memory_order_relaxed);
+        else misses_[bin].fetch_add(1, std::memory_order_relaxed);
+    }
+    void rehashed(uint64_t ns)  {
+        ++rehashes_;
+        rehash_ns_ += ns;
+    }
+    void loaded(double load_factor)  {peak_load_ = std::max(peak_load_, load_factor);}
+    void merge(const StatsRecorder& other)  { // adds up the counts of 2 tables
+        for (size_t i = 0; i < HashMapStats::PROBE_BINS; ++i)  {
+            hits_[i].fetch_add(other.hits_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            misses_[i].fetch_add(other.misses_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        rehashes_ += other.rehashes_;
+        rehash_ns_ += other.rehash_ns_;
+        peak_load_ = std::max(peak_load_, other.peak_load_);
+    }
+    void reset()  {*this = StatsRecorder();}
 
-Resizing: compute new hash arr index by % w/ new num_bucket
-*/
+    HashMapStats recorded() const  {
+        HashMapStats stats;
+        for (size_t i = 0; i < HashMapStats::PROBE_BINS; ++i)  {
+            stats.hit_probes[i] = hits_[i].load(std::memory_order_relaxed);
+            stats.miss_probes[i] = misses_[i].load(std::memory_order_relaxed);
+        }
+        stats.rehashes = rehashes_;
+        stats.rehash_ns = rehash_ns_;
+        stats.peak_load_factor = peak_load_;
+        return stats;
+    }
 
-template <typename K, typename V>
-struct Entry  : public std::pair<K, V>  { // for using pair funcs such as first & second
-    bool occupied = false;
-    bool deleted = false;
+private:
+    mutable std::atomic<uint64_t> hits_[HashMapStats::PROBE_BINS] = {};
+    mutable std::atomic<uint64_t> misses_[HashMapStats::PROBE_BINS] = {};
+    uint64_t rehashes_ = 0;
+    uint64_t rehash_ns_ = 0;
+    double peak_load_ = 0.0;
+};
+
+// Times the scope it lives in as 1 rehash
+class RehashTimer {
+public:
+    explicit RehashTimer(StatsRecorder& recorder) : recorder_(recorder), start_(std::chrono::steady_clock::now()) {}
+    ~RehashTimer()  {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        recorder_.rehashed(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+private:
+    StatsRecorder& recorder_;
+    std::chrono::steady_clock::time_point start_;
+};
+#else
+struct StatsRecorder {
+    void probe(bool, size_t) const {}
+    void rehashed(uint64_t) {}
+    void loaded(double) {}
+    void merge(const StatsRecorder&) {}
+    void reset() {}
+};
+
+struct RehashTimer {
+    explicit RehashTimer(StatsRecorder&) {}
+};
+#endif
 
-    // Default constructor
-    Entry() : std::pair<K, V>(), occupied(false), deleted(false) {}
-    // Parameterized constructor handling both copy and move in 1 imple
-    // Need extra templating or K, V will be fixed by Entry instantiation, rendering below constructor to accept rvalues only
-    // Perfect forwarding requires independent template deduction from factory function
-    template <typename KeyType, typename ValType>
-    Entry(KeyType&& key, ValType&& val, bool occ = false, bool del = false) : std::pair<K, V>(std::forward<KeyType>(key), std::forward<ValType>(val)), occupied(occ), deleted(del)  {}
+
+// A key-value pair w/ named accessors, the elem type all imples hand out through their iters
+template <typename K, typename V>
+struct KeyValue  : public std::pair<K, V>  { // for using pair funcs such as first & second
+    using std::pair<K, V>::pair;
 
     // Accessors for key and value
     K& key() { return this->first; }
@@ -64,90 +253,111 @@ and desired functions such as first & second
 */
 };
 
+
 /*
-Why maintain a deleted bool?
-If we have occupied only and toggle it upon deletion,
-then upon probing there will be unexpected holes rendering the probing to stop prematurely.
+HashMapBase: the interface shared by all imples (CRTP)
+
+Each imple (Derived) stores its slots however it likes and only provides the primitives
+    size_t size() const
+    size_t slot_count() const                     num of slots, live or not
+    bool slot_live(size_t idx) const              whether slot idx holds a key
+    Slot& slot(size_t idx)                        (+ const overload)
+    size_t find_index(const KeyLike& key) const   slot of key, or npos
+    std::pair<size_t, bool> emplace_index(key, args...)
+                                                  slot of key, inserting key w/ V(args...) if absent; second: inserted?
+    void erase_index(size_t idx)                  rm the key in live slot idx
+    size_t hash(const KeyLike& key) const         mixed_hash of key
+    static constexpr bool BATCH_PREFETCH          whether the batched ops prefetch, see below
+    void prefetch(size_t hash) const              starts loading the memory a lookup of hash touches first (if BATCH_PREFETCH)
+    size_t find_index(const KeyLike& key, size_t hash) const
+                                                  find_index w/ the hash computed already
+    size_t tombstone_count() const, size_t max_cluster_length() const
+    HashMapStats recorded_stats() const           the StatsRecorder's counts, w/ HASHMAP_STATS only
+from which everything below is built once. Derived must befriend HashMapBase.
+
+Every op runs a single probe sequence: e.g. operator[] on a missing key finds the slot where the key belongs while
+looking for it, and constructs the key & V() right there. The args of the emplacing ops are only consumed if the key is
+inserted, so try_emplace(key, std::move(v)) leaves v intact when key exists.
+
+Heterogeneous lookup: when Hash & KeyEqual both declare is_transparent, find/contains/at/erase also accept any type they
+can hash & compare, e.g. looking up a std::string_view w/out building a std::string:
+    HashMap<std::string, int, StringHash, std::equal_to<>> Map;
+    Map.contains(std::string_view("key"));
+
+Batched ops: a lookup in a table much larger than the cache stalls on 1 or 2 cache misses, and a loop of lookups takes
+them one after the other. contains_batch, find_batch & insert_batch instead hash & prefetch the home bucket of each key
+PREFETCH_GROUP keys before resolving it, so that up to PREFETCH_GROUP misses are in flight at once. That only pays where
+a miss costs more than the loop's own overlap of independent lookups hides (see bench.cc): open addressing and the
+compact dict. Control bytes & Robin Hood (and so incremental rehashing) find a key w/in 1 or 2 lines the CPU already
+fetches ahead, and chaining can only prefetch the chain's head, so the prefetches just add work: their batched ops run
+the plain loop (BATCH_PREFETCH = false).
 */
+template <typename Map>
+concept transparent_lookup = requires {
+    typename Map::hasher::is_transparent;
+    typename Map::key_equal::is_transparent;
+};
 
-template <typename K, typename V>
-class HashMap {
-private:
-
-Array<Entry<K, V>> arr;
-
-size_t num_keys = 0;
-size_t num_buckets = 50;
-
-size_t hash(const K& key) const  {    
-    if (num_buckets == 0) throw std::runtime_error("Invalid number of buckets.");
-    
-    return std::hash<K>()(key) % num_buckets; // create a std::hash instance then call ()
-}
+// std::hash over std::string & everything that converts to std::string_view, for heterogeneous lookup
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const  {return std::hash<std::string_view>()(str);}
+};
 
+template <typename Derived, typename K, typename V, typename Slot>
+class HashMapBase {
 public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = Slot;
 
 // note that nested class cannot access non static class members (even funcs!) so we have to pass a ref
 template <bool IsConst>
 class Iterator {
-    using HashMapType = typename std::conditional<IsConst, const HashMap<K, V>, HashMap<K, V>>::type;
-    using EntryType = typename std::conditional<IsConst, const Entry<K, V>, Entry<K, V>>::type;
+    using HashMapType = typename std::conditional<IsConst, const Derived, Derived>::type;
+    using EntryType = typename std::conditional<IsConst, const Slot, Slot>::type;
 
 private:
-    HashMapType& Map; // Reference to HashMap (const or non-const)
-    size_t index;         // Current index
-    size_t visited;       // Number of valid elements visited
-    bool is_end;          // Flag to indicate if this is the "end" iterator
+    HashMapType* Map; // ptr rather than ref, so that iters are assignable
+    size_t index;     // Current slot, Map->slot_count() for the "end" iterator
 
-    // Helper function to skip invalid or empty entries
+    // Helper function to skip empty and deleted slots
     void skipInvalidEntries() {
-        while (visited < Map.size()) {
-            if (Map.arr[index].occupied && !Map.arr[index].deleted) {
-                // Found a valid entry, stop skipping
-                return;
-            }
-            // Move to the next bucket
-            index = (index + 1) % Map.num_buckets;
+        while (index < Map->slot_count() && !Map->slot_live(index)) {
+            ++index;
         }
-        // If we reach here, we've visited all valid entries
-        is_end = true;
     }
 
 public:
     // Constructor
     Iterator(HashMapType& Map_ref, size_t start, bool end = false)
-        : Map(Map_ref), index(start), visited(0), is_end(end) {
-        if (end || Map.size() == 0) {
-            // Explicitly mark as "end" if requested or if the Map is empty
-            is_end = true;
-        } else {
-            // Skip to the first valid entry
-            skipInvalidEntries();
-        }
+        : Map(&Map_ref), index(end ? Map_ref.slot_count() : start) {
+        skipInvalidEntries();
     }
 
+    // non const to const conversion
+    operator Iterator<true>() const  {return Iterator<true>(*Map, index);}
+
     // Dereference operator
-    EntryType& operator*() {
-        if (is_end) {
+    EntryType& operator*() const {
+        if (index >= Map->slot_count()) {
             throw std::out_of_range("Dereferencing end iterator");
         }
-        return Map.arr[index];
+        return Map->slot(index);
     }
 
-    const EntryType& operator*() const {
-        if (is_end) {
-            throw std::out_of_range("Dereferencing end iterator");
-        }
-        return Map.arr[index];
+    EntryType* operator->() const {
+        return &**this;
     }
 
     // Pre-increment
     Iterator& operator++() {
-        if (is_end) {
+        if (index >= Map->slot_count()) {
             throw std::out_of_range("Incrementing end iterator");
         }
-        ++visited;
-        index = (index + 1) % Map.num_buckets;
+        ++index;
         skipInvalidEntries();
         return *this;
     }
@@ -161,7 +371,7 @@ public:
 
     // Equality operators
     bool operator==(const Iterator& other) const {
-        return is_end == other.is_end && (is_end || (index == other.index && &Map == &other.Map));
+        return index == other.index && Map == other.Map;
     }
 
     bool operator!=(const Iterator& other) const {
@@ -169,43 +379,421 @@ public:
     }
 };
 
-/*
-    // To declare all specializations of Iterator as friends:
-    template <bool IsConst>
-    friend class Iterator;
-*/
-
 // Begin and end functions
-// MuMap begin() and end()
 Iterator<false> begin() {
-    return Iterator<false>(*this, 0);
+    return Iterator<false>(self(), 0);
 }
 
 Iterator<false> end() {
-    return Iterator<false>(*this, 0, true);
+    return Iterator<false>(self(), 0, true);
 }
 
 // Const begin() and end()
 Iterator<true> begin() const {
-    return Iterator<true>(*this, 0);
+    return Iterator<true>(self(), 0);
 }
 
 Iterator<true> end() const {
-    return Iterator<true>(*this, 0, true);
+    return Iterator<true>(self(), 0, true);
+}
+
+
+using iterator = Iterator<false>;
+using const_iterator = Iterator<true>;
+
+void insert(const K& key, const V& val); // insert, or overwrite the value of an existing key
+void insert(const std::pair<K, V>& pair); // for pair overload
+void insert(std::pair<K, V>&& pair);
+
+// insert key w/ V(args...) if absent, otherwise leave the map (and args) untouched. second: inserted?
+template <typename... Args>
+std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)  {return emplaced(self().emplace_index(key, std::forward<Args>(args)...));}
+template <typename... Args>
+std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)  {return emplaced(self().emplace_index(std::move(key), std::forward<Args>(args)...));}
+// std::pair<K, V>(args...) built first, then moved in if its key is absent
+template <typename... Args>
+std::pair<iterator, bool> emplace(Args&&... args);
+// insert, or assign to the value of an existing key. second: inserted?
+template <typename M>
+std::pair<iterator, bool> insert_or_assign(const K& key, M&& obj);
+template <typename M>
+std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj);
+
+iterator find(const K& key)  {return find<K>(key);} // end() if absent
+const_iterator find(const K& key) const  {return find<K>(key);}
+bool contains(const K& key) const  {return self().find_index(key) != npos;}
+bool erase(const K& key)  {return erase<K>(key);} // false if absent
+bool empty() const  {return self().size() == 0;}
+
+V& operator[](const K& key); // inserts V() if key is absent
+V& operator[](K&& key);
+const V& operator[] (const K& key) const; // throws std::invalid_argument if key is absent
+V& at(const K& key)  {return at<K>(key);} // throws std::out_of_range if key is absent
+const V& at(const K& key) const  {return at<K>(key);}
+
+// heterogeneous overloads, see above
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+iterator find(const KeyLike& key);
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+const_iterator find(const KeyLike& key) const;
+template <typename KeyLike> requires transparent_lookup<Derived>
+bool contains(const KeyLike& key) const  {return self().find_index(key) != npos;}
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+bool erase(const KeyLike& key);
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+V& at(const KeyLike& key);
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+const V& at(const KeyLike& key) const;
+
+double load_factor() const  {return self().slot_count() ? static_cast<double>(self().size()) / self().slot_count() : 0.0;}
+size_t tombstones() const  {return self().tombstone_count();} // erased slots still lengthening probe sequences, see compact()
+
+// batched ops, see above
+static constexpr size_t PREFETCH_GROUP = 16;
+size_t contains_batch(std::span<const K> keys, bool* found) const; // found[i]: whether keys[i] is present. Returns the num found
+size_t find_batch(std::span<const K> keys, V** vals); // vals[i]: the value of keys[i], nullptr if absent. Returns the num found
+size_t find_batch(std::span<const K> keys, const V** vals) const; // the ptrs are valid until the next insert
+size_t insert_batch(std::span<const std::pair<K, V>> pairs); // inserts or overwrites each pair. Returns the num inserted
+
+#ifdef HASHMAP_STATS
+HashMapStats stats() const; // the counts since construction, plus a scan of the table: O(slot_count)
+#endif
+
+private:
+Derived& self()  {return static_cast<Derived&>(*this);}
+const Derived& self() const  {return static_cast<const Derived&>(*this);}
+
+// calls fn(i, hash of key_at(i)) for i in [0, n), having prefetched the buckets of the next PREFETCH_GROUP keys first
+// if Derived::BATCH_PREFETCH
+template <typename KeyAt, typename Fn>
+void prefetched(size_t n, KeyAt key_at, Fn fn) const;
+
+std::pair<iterator, bool> emplaced(std::pair<size_t, bool> result)  {return {iterator(self(), result.first), result.second};}
+};
+
+
+template <typename Derived, typename K, typename V, typename Slot>
+void HashMapBase<Derived, K, V, Slot>::insert(const K& key, const V& val) {
+    insert_or_assign(key, val);
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+void HashMapBase<Derived, K, V, Slot>::insert(const std::pair<K, V>& pair) {
+    insert_or_assign(pair.first, pair.second);
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+void HashMapBase<Derived, K, V, Slot>::insert(std::pair<K, V>&& pair) {
+    insert_or_assign(std::move(pair.first), std::move(pair.second));
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename... Args>
+auto HashMapBase<Derived, K, V, Slot>::emplace(Args&&... args) -> std::pair<iterator, bool> {
+    std::pair<K, V> pair(std::forward<Args>(args)...);
+    return try_emplace(std::move(pair.first), std::move(pair.second));
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename M>
+auto HashMapBase<Derived, K, V, Slot>::insert_or_assign(const K& key, M&& obj) -> std::pair<iterator, bool> {
+    auto [idx, inserted] = self().emplace_index(key, std::forward<M>(obj));
+    if (!inserted) {
+        self().slot(idx).val() = std::forward<M>(obj); // if exists, update. obj was not consumed by the emplace
+    }
+    return {iterator(self(), idx), inserted};
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename M>
+auto HashMapBase<Derived, K, V, Slot>::insert_or_assign(K&& key, M&& obj) -> std::pair<iterator, bool> {
+    auto [idx, inserted] = self().emplace_index(std::move(key), std::forward<M>(obj));
+    if (!inserted) {
+        self().slot(idx).val() = std::forward<M>(obj);
+    }
+    return {iterator(self(), idx), inserted};
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+V& HashMapBase<Derived, K, V, Slot>::operator[](const K& key) {
+    return self().slot(self().emplace_index(key).first).val(); // one probe sequence, whether key exists or not
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+V& HashMapBase<Derived, K, V, Slot>::operator[](K&& key) {
+    return self().slot(self().emplace_index(std::move(key)).first).val();
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+auto HashMapBase<Derived, K, V, Slot>::find(const KeyLike& key) -> iterator {
+    size_t idx = self().find_index(key);
+    return idx == npos ? end() : iterator(self(), idx);
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+auto HashMapBase<Derived, K, V, Slot>::find(const KeyLike& key) const -> const_iterator {
+    size_t idx = self().find_index(key);
+    return idx == npos ? end() : const_iterator(self(), idx);
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+bool HashMapBase<Derived, K, V, Slot>::erase(const KeyLike& key) {
+    size_t idx = self().find_index(key);
+    if (idx == npos) return false;
+    self().erase_index(idx);
+    return true;
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename KeyAt, typename Fn>
+void HashMapBase<Derived, K, V, Slot>::prefetched(size_t n, KeyAt key_at, Fn fn) const {
+    if constexpr (!Derived::BATCH_PREFETCH) {
+        for (size_t i = 0; i < n; ++i) {
+            fn(i, self().hash(key_at(i)));
+        }
+    } else {
+        // a sliding window: key i + PREFETCH_GROUP is prefetched as key i is resolved, so the misses in flight never drain
+        size_t hashes[PREFETCH_GROUP];
+        size_t ahead = std::min(PREFETCH_GROUP, n);
+        for (size_t i = 0; i < ahead; ++i) {
+            hashes[i] = self().hash(key_at(i));
+            self().prefetch(hashes[i]);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            size_t hash = hashes[i % PREFETCH_GROUP];
+            if (i + PREFETCH_GROUP < n) {
+                hashes[i % PREFETCH_GROUP] = self().hash(key_at(i + PREFETCH_GROUP));
+                self().prefetch(hashes[i % PREFETCH_GROUP]);
+            }
+            fn(i, hash);
+        }
+    }
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+size_t HashMapBase<Derived, K, V, Slot>::contains_batch(std::span<const K> keys, bool* found) const {
+    size_t num_found = 0;
+    prefetched(keys.size(), [&keys](size_t i) -> const K& { return keys[i]; }, [&](size_t i, size_t hash) {
+        found[i] = self().find_index(keys[i], hash) != npos;
+        num_found += found[i];
+    });
+    return num_found;
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+size_t HashMapBase<Derived, K, V, Slot>::find_batch(std::span<const K> keys, V** vals) {
+    size_t num_found = 0;
+    prefetched(keys.size(), [&keys](size_t i) -> const K& { return keys[i]; }, [&](size_t i, size_t hash) {
+        size_t idx = self().find_index(keys[i], hash);
+        vals[i] = idx == npos ? nullptr : &self().slot(idx).val();
+        num_found += idx != npos;
+    });
+    return num_found;
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+size_t HashMapBase<Derived, K, V, Slot>::find_batch(std::span<const K> keys, const V** vals) const {
+    size_t num_found = 0;
+    prefetched(keys.size(), [&keys](size_t i) -> const K& { return keys[i]; }, [&](size_t i, size_t hash) {
+        size_t idx = self().find_index(keys[i], hash);
+        vals[i] = idx == npos ? nullptr : &self().slot(idx).val();
+        num_found += idx != npos;
+    });
+    return num_found;
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+size_t HashMapBase<Derived, K, V, Slot>::insert_batch(std::span<const std::pair<K, V>> pairs) {
+    size_t num_inserted = 0;
+    // the insert hashes its key again: cheap next to the cache miss the prefetch saves. A growth in the middle of a
+    // group only wastes the rest of the group's prefetches
+    prefetched(pairs.size(), [&pairs](size_t i) -> const K& { return pairs[i].first; }, [&](size_t i, size_t) {
+        num_inserted += insert_or_assign(pairs[i].first, pairs[i].second).second;
+    });
+    return num_inserted;
+}
+
+#ifdef HASHMAP_STATS
+template <typename Derived, typename K, typename V, typename Slot>
+HashMapStats HashMapBase<Derived, K, V, Slot>::stats() const {
+    HashMapStats stats = self().recorded_stats();
+    stats.tombstones = self().tombstone_count();
+    stats.tombstone_ratio = self().slot_count() ? static_cast<double>(stats.tombstones) / self().slot_count() : 0.0;
+    stats.max_cluster_length = self().max_cluster_length();
+    return stats;
+}
+#endif
+
+template <typename Derived, typename K, typename V, typename Slot>
+const V& HashMapBase<Derived, K, V, Slot>::operator[](const K& key) const {
+    size_t idx = self().find_index(key);
+    if (idx == npos) throw std::invalid_argument("accessing nonexistent key through const []");
+    return self().slot(idx).val();
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+V& HashMapBase<Derived, K, V, Slot>::at(const KeyLike& key) {
+    size_t idx = self().find_index(key);
+    if (idx == npos) throw std::out_of_range("Key is not present.\n");
+    return self().slot(idx).val();
+}
+
+template <typename Derived, typename K, typename V, typename Slot>
+template <typename KeyLike> requires (std::is_same_v<KeyLike, K> || transparent_lookup<Derived>)
+const V& HashMapBase<Derived, K, V, Slot>::at(const KeyLike& key) const {
+    size_t idx = self().find_index(key);
+    if (idx == npos) throw std::out_of_range("Key is not present.\n");
+    return self().slot(idx).val();
+}
+
+
+/*
+Collision resolution: Open Addressing
+
+Open as opposed to closed/fixed addressing (chaining)
+
+in inserting, we attempt key, and if occupied jump according to probing scheme until next empty space is found
+in probing, we start from key and jump according to probing scheme until next empty space is found.
+It is impossible for there to be some empty spaces to be probed before the to-be-found key, as it would contradict the inserting mechanism
+
+With open addr, load_factor cannot >= 1.
+Common resizing threshold is .7
+
+num_buckets is a power of 2, so hash % num_buckets is hash & (num_buckets - 1): no integer division per probe.
+The mask keeps only the low bits of the hash, hence the hash is mixed first (see hash_mix), or sequential int keys
+would fill consecutive buckets & form 1 long cluster.
+
+Resizing: compute new hash arr index by masking w/ new num_bucket
+*/
+
+template <typename K, typename V>
+struct Entry  : public KeyValue<K, V>  {
+    bool occupied = false;
+    bool deleted = false;
+
+    // Default constructor
+    Entry() : KeyValue<K, V>(), occupied(false), deleted(false) {}
+    // Parameterized constructor handling both copy and move in 1 imple
+    // Need extra templating or K, V will be fixed by Entry instantiation, rendering below constructor to accept rvalues only
+    // Perfect forwarding requires independent template deduction from factory function
+    template <typename KeyType, typename ValType>
+    Entry(KeyType&& key, ValType&& val, bool occ = false, bool del = false) : KeyValue<K, V>(std::forward<KeyType>(key), std::forward<ValType>(val)), occupied(occ), deleted(del)  {}
+};
+
+/*
+Why maintain a deleted bool?
+If we have occupied only and toggle it upon deletion,
+then upon probing there will be unexpected holes rendering the probing to stop prematurely.
+
+The price: deleted entries (tombstones) lengthen every probe sequence passing them just like keys do, until an insert
+happens to reuse them. So the .7 threshold counts keys + tombstones, i.e. every slot that is not never used. Reaching it
+doubles the table, unless tombstones make up the bulk of it (keys < .35 of the buckets): then they are purged in place.
+Hence churn at a constant size gets fresh-table probe lengths back w/out growing the table.
+compact() purges the tombstones on demand, e.g. after a mass erase.
+
+Purging in place: the tombstones are cleared, the keys marked unplaced (!occupied && deleted, a state found nowhere
+else), then every unplaced key goes to the first slot from its home not holding a placed key: that is its own slot at
+the latest. Moving it there may mean swapping w/ another unplaced key, which is placed next. No 2nd arr is allocated;
+only if Entry moves may throw is the table rebuilt in a fresh arr instead (peak: 2 arrs), as a throw half way through
+would strand keys.
+*/
+
+/*
+Alloc: any standard allocator, rebound internally to Entry<K, V> for the bucket arr.
+Use std::pmr::polymorphic_allocator (or the PmrHashMap alias) to draw buckets from an arena, e.g. request-scoped maps
+that are dropped all at once w/ the arena.
+*/
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class OpenAddrHashMap : public HashMapBase<OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>, K, V, Entry<K, V>> {
+    friend class HashMapBase<OpenAddrHashMap, K, V, Entry<K, V>>;
+    using Base = HashMapBase<OpenAddrHashMap, K, V, Entry<K, V>>;
+public:
+using allocator_type = Alloc;
+using hasher = Hash;
+using key_equal = KeyEqual;
+using Base::npos;
+
+private:
+using EntryAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Entry<K, V>>;
+
+static constexpr size_t INITIAL_BUCKETS = 64; // a power of 2, as is every later num_buckets
+
+Array<Entry<K, V>, EntryAlloc> arr;
+[[no_unique_address]] Hash hash_fn;
+[[no_unique_address]] KeyEqual key_eq_fn;
+
+size_t num_keys = 0;
+size_t num_deleted = 0; // tombstones
+size_t num_buckets = INITIAL_BUCKETS;
+[[no_unique_address]] StatsRecorder recorder;
+
+static constexpr double MAX_LOAD = 0.7; // keys + tombstones per bucket
+
+template <typename KeyLike>
+size_t hash(const KeyLike& key) const  {return mixed_hash(hash_fn, key);}
+static constexpr bool BATCH_PREFETCH = true;
+void prefetch(size_t hash) const  {
+    if (num_buckets) prefetch_read(arr.data() + (hash & (num_buckets - 1)));
 }
 
+size_t slot_count() const  {return num_buckets;}
+bool slot_live(size_t idx) const  {return arr[idx].occupied && !arr[idx].deleted;}
+Entry<K, V>& slot(size_t idx)  {return arr[idx];}
+const Entry<K, V>& slot(size_t idx) const  {return arr[idx];}
+
+template <typename KeyLike>
+std::pair<size_t, bool> probe(const KeyLike& key) const  {return probe(key, hash(key));}
+template <typename KeyLike>
+std::pair<size_t, bool> probe(const KeyLike& key, size_t hash) const; // {slot of key, true}, or {slot a new key goes to (npos if none), false}
+template <typename KeyLike>
+size_t find_index(const KeyLike& key) const  {return find_index(key, hash(key));}
+template <typename KeyLike>
+size_t find_index(const KeyLike& key, size_t hash) const;
+template <typename KeyType, typename... Args>
+std::pair<size_t, bool> emplace_index(KeyType&& key, Args&&... args);
+void erase_index(size_t idx);
+void rehash(size_t new_num_buckets);
+void purge_tombstones(); // rehash at the same size, in place, see above
+
+size_t tombstone_count() const  {return num_deleted;}
+size_t max_cluster_length() const  {return longest_run(num_buckets, [this](size_t i) { return arr[i].occupied; });}
+#ifdef HASHMAP_STATS
+HashMapStats recorded_stats() const  {return recorder.recorded();}
+#endif
 
-HashMap()  {
+public:
+
+OpenAddrHashMap() : OpenAddrHashMap(Hash()) {}
+
+explicit OpenAddrHashMap(const Alloc& alloc) : OpenAddrHashMap(Hash(), KeyEqual(), alloc) {}
+
+explicit OpenAddrHashMap(const Hash& hash, const KeyEqual& key_eq = KeyEqual(), const Alloc& alloc = Alloc())
+    : arr(EntryAlloc(alloc)), hash_fn(hash), key_eq_fn(key_eq)  {
     arr.resize(num_buckets, Entry<K, V>());
 }
 
-HashMap(const HashMap& other) : arr(other.arr), num_keys(other.num_keys), num_buckets(other.num_buckets) {}
+allocator_type get_allocator() const  {return allocator_type(arr.get_allocator());}
+hasher hash_function() const  {return hash_fn;}
+key_equal key_eq() const  {return key_eq_fn;}
 
-HashMap& operator=(const HashMap& other)    {
+OpenAddrHashMap(const OpenAddrHashMap& other)
+    : Base(), arr(other.arr), hash_fn(other.hash_fn), key_eq_fn(other.key_eq_fn), num_keys(other.num_keys), num_deleted(other.num_deleted),
+      num_buckets(other.num_buckets), recorder(other.recorder) {}
+
+OpenAddrHashMap& operator=(const OpenAddrHashMap& other)    {
     if (this != &other) {
         arr = other.arr;
+        hash_fn = other.hash_fn;
+        key_eq_fn = other.key_eq_fn;
         num_keys = other.num_keys;
+        num_deleted = other.num_deleted;
         num_buckets = other.num_buckets;
+        recorder = other.recorder;
     }
     return *this;
 }
@@ -213,43 +801,41 @@ HashMap& operator=(const HashMap& other)    {
 // Moving an int does not zero out the source value. The source value remains unchanged after the move operation.
 // So we have to handle the move op explicitly to set the int attrs of the src.
 
-HashMap(HashMap&& other) : arr(std::move(other.arr)), num_keys(other.num_keys), num_buckets(other.num_buckets)    {
+OpenAddrHashMap(OpenAddrHashMap&& other)
+    : Base(), arr(std::move(other.arr)), hash_fn(other.hash_fn), key_eq_fn(other.key_eq_fn), num_keys(other.num_keys), num_deleted(other.num_deleted),
+      num_buckets(other.num_buckets), recorder(other.recorder)    {
     other.num_keys = 0;
+    other.num_deleted = 0;
     other.num_buckets = 0;
 }
 
 
-HashMap& operator=(HashMap&& other)    {
+OpenAddrHashMap& operator=(OpenAddrHashMap&& other)    {
     if (this != &other) {
         arr = std::move(other.arr);
+        hash_fn = other.hash_fn;
+        key_eq_fn = other.key_eq_fn;
         num_keys = other.num_keys;
+        num_deleted = other.num_deleted;
         num_buckets = other.num_buckets;
+        recorder = other.recorder;
 
         other.num_keys = 0;
+        other.num_deleted = 0;
         other.num_buckets = 0;
     }
     return *this;
 }
 
 
-void insert(const K& key, const V& val);
-void insert(const std::pair<K, V>& pair); // for pair overload
-bool erase(const K& key);
-void clear() {arr.clear(); num_keys = num_buckets = 0;}
-
-bool contains(const K& key) const;
-bool empty() const;
-size_t size() const;
-
-V& operator[](const K& key);
-const V& operator[] (const K& key) const;
-V& at(const K& key);
+void clear(); // rm all keys, keeps the buckets
+void compact(); // purges the tombstones, keeps the buckets
 
-double load_factor() {return static_cast<double>(num_keys)/num_buckets;}
+size_t size() const  {return num_keys;}
 
 /*
 The following imple for begin and end will NOT work as it doesn't acnum_keys for wrap around in open addressing
-auto begin() const -> decltype(arr.begin()) { 
+auto begin() const -> decltype(arr.begin()) {
     auto begin = arr.begin();
     while  ( (*begin).deleted || !(*begin).occupied )   {
         ++begin;
@@ -268,195 +854,1618 @@ auto end() const -> decltype(arr.end()) {
 };
 
 
-template <typename K, typename V>
-void HashMap<K, V>::insert(const K& key, const V& val) {
-    if (load_factor() > 0.7)    {
-        
-        auto old_arr = std::move(arr); 
-        // saving old arr goes first
-        // involves adjustment of arr so we cannot use arr as src
-
-        arr.resize(num_buckets*2, Entry<K, V>()); // not exception safe so goes second
-        num_buckets = arr.size();
-        num_keys = 0;
-
-        for (const auto& entry : old_arr)   {
-            if (entry.occupied && !entry.deleted) {
-                insert(entry.key(), entry.val());
-            }
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>::rehash(size_t new_num_buckets) {
+    RehashTimer timer(recorder);
+    auto old_arr = std::move(arr);
+    // saving old arr goes first
+    // involves adjustment of arr so we cannot use arr as src
+
+    arr.resize(new_num_buckets, Entry<K, V>()); // not exception safe so goes second
+    num_buckets = arr.size();
+    num_keys = 0;
+    num_deleted = 0;
+
+    for (auto& entry : old_arr)   {
+        if (entry.occupied && !entry.deleted) {
+            // all keys are distinct & there are no tombstones yet: the first never used slot is the key's, no compares needed
+            size_t idx = hash(entry.key()) & (num_buckets - 1);
+            while (arr[idx].occupied) idx = (idx + 1) & (num_buckets - 1);
+            arr[idx] = std::move(entry);
+            ++num_keys;
         }
-
     }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyLike>
+std::pair<size_t, bool> OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>::probe(const KeyLike& key, size_t hash) const {
+    if (num_buckets == 0) throw std::runtime_error("Invalid number of buckets.");
 
-try
-{
-    auto idx = hash(key);
+    auto idx = hash & (num_buckets - 1);
     auto start_idx = idx;
+    size_t reuse = npos; // first deleted slot passed, where a new key goes once we know it is absent
 
-    while (1) {
+    for (size_t visited = 1; ; ++visited) {
         auto& entry = arr[idx];
-        if (entry.occupied && !entry.deleted && entry.key() == key)    {
-            entry.val() = val; // if exists, update
-            return;
-        }
-        if (!entry.occupied || entry.deleted) {
-            entry.key() = key; 
-            entry.val() = val;
-            entry.occupied = true;
-            if (entry.deleted) entry.deleted = false; // reactivated
-            ++num_keys;
-            break;
+        if (!entry.occupied) {
+            // Stop searching if a never used slot is found (key does not exist, as linear probing keys are contiguous)
+            recorder.probe(false, visited);
+            return {reuse != npos ? reuse : idx, false}; // reactivate a deleted slot if we passed one
+        }
+        if (!entry.deleted && key_eq_fn(entry.key(), key)) {
+            recorder.probe(true, visited);
+            return {idx, true};
+        }
+        if (entry.deleted && reuse == npos) reuse = idx;
+        idx = (idx + 1) & (num_buckets - 1); // wrap around
+        if (idx == start_idx) {
+            recorder.probe(false, visited);
+            return {reuse, false};
         }
-        idx = (idx + 1) % num_buckets; // wrap around
-        if (idx == start_idx) throw std::runtime_error("Map is full.\n");
     }
 }
-catch(const std::exception& e)
-{
-    std::cout << "insert failed" << '\n';
-}
 
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyLike>
+size_t OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>::find_index(const KeyLike& key, size_t hash) const {
+    if (num_buckets == 0) return npos; // moved-from
+    auto [idx, found] = probe(key, hash);
+    return found ? idx : npos;
 }
 
-template <typename K, typename V>
-void HashMap<K, V>::insert(const std::pair<K, V>& pair) {
-    if (load_factor() > 0.7)    {
-        auto old_arr = std::move(arr); 
-        // saving old arr goes first
-        // involves adjustment of arr so we cannot use arr as src
-
-        arr.resize(num_buckets*2, Entry<K, V>()); // not exception safe so goes second
-        num_buckets = arr.size();
-        num_keys = 0;
-
-        for (const auto& entry : old_arr)   {
-            if (entry.occupied && !entry.deleted) {
-                insert(entry.key(), entry.val());
-            }
-        }
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyType, typename... Args>
+std::pair<size_t, bool> OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>::emplace_index(KeyType&& key, Args&&... args) {
+    if (num_buckets == 0) rehash(INITIAL_BUCKETS); // moved-from
+
+    auto [idx, found] = probe(key);
+    if (found) return {idx, false};
 
+    // reusing a tombstone takes no never used slot, so only filling a never used slot can hit the max load
+    if (idx == npos || (!arr[idx].occupied && num_keys + num_deleted > MAX_LOAD * num_buckets))    {
+        // Build the new entry first: the args may refer into the arr we are about to rehash
+        Entry<K, V> fresh(std::forward<KeyType>(key), V(std::forward<Args>(args)...), true);
+        if (num_keys < MAX_LOAD / 2 * num_buckets) {
+            purge_tombstones(); // mostly tombstones: purge them at the same size
+        } else {
+            rehash(num_buckets * 2);
+        }
+        idx = probe(fresh.key()).first;
+        arr[idx] = std::move(fresh);
+    } else {
+        auto& entry = arr[idx];
+        if (entry.deleted) --num_deleted;
+        entry.val() = V(std::forward<Args>(args)...);
+        entry.key() = std::forward<KeyType>(key);
+        entry.occupied = true;
+        entry.deleted = false;
     }
+    ++num_keys;
+    recorder.loaded(this->load_factor());
+    return {idx, true};
+}
 
-    auto idx = hash(pair.first);
-    auto start_idx = idx;
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>::erase_index(size_t idx) {
+    arr[idx].deleted = true;
+    --num_keys;
+    ++num_deleted;
+}
 
-while (1) {
-    auto& entry = arr[idx];
-    if (entry.occupied && !entry.deleted && entry.key() == pair.first) {
-        entry.val() = pair.second; // if exists, update
-        return;
-    }
-    if (!entry.occupied || entry.deleted) {
-        entry.key() = pair.first;
-        entry.val() = pair.second;
-        entry.occupied = true;
-        if (entry.deleted) entry.deleted = false; // reactivated
-        ++num_keys;
-        break;
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>::clear() {
+    if (num_buckets == 0) return;
+    for (size_t i = 0; i < num_buckets; ++i)  {
+        arr[i] = Entry<K, V>();
     }
-    idx = (idx + 1) % num_buckets; // wrap around
-    if (idx == start_idx) throw std::runtime_error("Map is full.\n");
+    num_keys = 0;
+    num_deleted = 0;
 }
 
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>::compact() {
+    if (num_deleted) purge_tombstones();
 }
 
-template <typename K, typename V>
-bool HashMap<K, V>::erase(const K& key) {
-    auto idx = hash(key);
-    auto start_idx = idx;
-    while (1) {
-        auto& entry = arr[idx];
-        if (entry.key() == key && entry.occupied && !entry.deleted) {
-            entry.deleted = true;
-            --num_keys;
-            return true;
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>::purge_tombstones() {
+    if constexpr (!std::is_nothrow_move_assignable_v<Entry<K, V>> || !std::is_nothrow_swappable_v<Entry<K, V>>) {
+        rehash(num_buckets);
+    } else {
+        RehashTimer timer(recorder);
+        size_t mask = num_buckets - 1;
+        for (auto& entry : arr)   {
+            if (!entry.occupied) continue;
+            if (entry.deleted) {
+                entry = Entry<K, V>(); // tombstone -> never used
+            } else {
+                entry.occupied = false; // key -> unplaced
+                entry.deleted = true;
+            }
         }
-        if (!entry.occupied) {
-            // Stop searching if an empty slot is found (key does not exist, as linear probing keys are contiguous)
-            return false;
+        for (size_t i = 0; i < num_buckets; ++i)   {
+            while (arr[i].deleted) { // an unplaced key: place it, then the key swapped in for it, if any
+                size_t idx = hash(arr[i].key()) & mask;
+                while (arr[idx].occupied) idx = (idx + 1) & mask;
+                if (idx != i) {
+                    if (arr[idx].deleted) {
+                        std::swap(arr[i], arr[idx]);
+                    } else {
+                        arr[idx] = std::move(arr[i]);
+                        arr[i] = Entry<K, V>();
+                    }
+                }
+                arr[idx].occupied = true;
+                arr[idx].deleted = false;
+            }
         }
-        idx = (idx + 1) % num_buckets; // wrap around
-        if (idx == start_idx) return false;
+        num_deleted = 0;
     }
-    return false;
 }
 
-template <typename K, typename V>
-bool HashMap<K, V>::contains(const K& key) const {
-    auto idx = hash(key);
-    auto start_idx = idx;
-    while (1) {
-        auto& entry = arr[idx];
-        if (entry.key() == key && !entry.deleted && entry.occupied) {
-            return true;
+
+/*
+Control bytes: open addressing w/ the metadata split off the entries (the layout of Abseil's Swiss tables)
+
+    ctrl:   [ 0x13 | EMPTY | 0x7a | DELETED | 0x13 | ... ]   1 B per slot
+    slots:  [ k,v  |       | k,v  |         | k,v  | ... ]   raw storage, only live slots hold objects
+
+mixed_hash(key) is split into
+    h1 = hash >> 7     picks the group (16 slots) where probing starts
+    h2 = hash & 0x7f   7 bit tag stored in the control byte of the key's slot
+A control byte is EMPTY (0x80), DELETED (0xfe) or, for a live slot, the key's h2 (0x00 - 0x7f).
+
+Lookup loads a whole group of 16 control bytes into one SSE2 register and compares all of them against h2 at once,
+giving a bitmask of candidate slots. Only those (on average 16 / 128 false candidates per group) have their keys compared.
+A group that contains an EMPTY byte ends the probe. Hence a miss usually costs 1 load of 16 B + 2 compares, and
+never touches key memory unless a 7 bit tag collides. Groups are probed in triangular order (g, g + 1, g + 3, g + 6, ...),
+which visits every group once since the num of groups is a power of 2.
+
+Tombstones: an erased slot becomes EMPTY if its group still has an EMPTY (no probe ever continued past that group),
+and DELETED otherwise. DELETED slots are reused by inserts and purged by rehashing.
+Max load: 7/8 of the slots, counting DELETED ones. Reaching it either doubles the table, or, when mostly tombstones
+are to blame, purges them in place, as compact() does: DELETED bytes become EMPTY and live ones DELETED, then every
+DELETED slot's key goes to the first EMPTY or DELETED slot of its probe sequence, unless that is in its own group. Taking
+a DELETED slot swaps the 2 keys, and the one swapped in is placed next. No 2nd table is allocated; only if slots may
+throw when moved is the table rebuilt in a fresh one instead (peak: 2 tables), as a throw half way would strand keys.
+
+Without SSE2 (non x86 targets), groups are matched byte by byte, giving the same semantics.
+*/
+inline constexpr int8_t CTRL_EMPTY = static_cast<int8_t>(0x80);
+inline constexpr int8_t CTRL_DELETED = static_cast<int8_t>(0xfe);
+
+struct CtrlGroup {
+    static constexpr size_t WIDTH = 16;
+
+#if defined(__SSE2__)
+    __m128i ctrl;
+    explicit CtrlGroup(const int8_t* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    // bit i set <=> slot i of the group has control byte h2
+    uint32_t match(int8_t h2) const  {return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))));}
+    uint32_t match_empty() const  {return match(CTRL_EMPTY);}
+    // EMPTY and DELETED are the only negative bytes, so the sign bits alone tell them apart from live slots
+    uint32_t match_empty_or_deleted() const  {return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));}
+#else
+    const int8_t* ctrl;
+    explicit CtrlGroup(const int8_t* pos) : ctrl(pos) {}
+
+    uint32_t match(int8_t h2) const  {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < WIDTH; ++i)  {
+            if (ctrl[i] == h2) mask |= uint32_t(1) << i;
         }
-        idx = (idx + 1) % num_buckets; // wrap around
-        if (idx == start_idx)   return false;
+        return mask;
     }
-    return false;
-}
-
-template <typename K, typename V>
-V& HashMap<K, V>::operator[](const K& key) {
-    auto idx = hash(key);
-    auto start_idx = idx;
-    while (1) {
-        auto& entry = arr[idx];
-        if (entry.key() == key && entry.occupied && !entry.deleted) { // check occupied -- map is initialized w/ default keys w/ occupied = false
-            return entry.val();
+    uint32_t match_empty() const  {return match(CTRL_EMPTY);}
+    uint32_t match_empty_or_deleted() const  {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < WIDTH; ++i)  {
+            if (ctrl[i] < 0) mask |= uint32_t(1) << i;
         }
+        return mask;
+    }
+#endif
+};
 
-        if (!entry.occupied || entry.deleted)  {
-            insert(key, V());
-            return this->operator[](key);
-        }
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class CtrlByteHashMap : public HashMapBase<CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>, K, V, KeyValue<K, V>> {
+    friend class HashMapBase<CtrlByteHashMap, K, V, KeyValue<K, V>>;
+    using Base = HashMapBase<CtrlByteHashMap, K, V, KeyValue<K, V>>;
+    using Slot = KeyValue<K, V>;
+    using SlotAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+    using SlotTraits = std::allocator_traits<SlotAlloc>;
+    using CtrlAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<int8_t>;
 
-        idx = (idx + 1) % num_buckets; // wrap around
-        if (idx == start_idx) {throw std::runtime_error("Map is full.");}
-    }
+    static constexpr size_t MIN_CAPACITY = CtrlGroup::WIDTH;
+
+public:
+    using allocator_type = Alloc;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using Base::npos;
+
+    CtrlByteHashMap() : CtrlByteHashMap(Hash()) {}
+    explicit CtrlByteHashMap(const Alloc& alloc) : CtrlByteHashMap(Hash(), KeyEqual(), alloc) {}
+    explicit CtrlByteHashMap(const Hash& hash, const KeyEqual& key_eq = KeyEqual(), const Alloc& alloc = Alloc());
+    ~CtrlByteHashMap();
+    CtrlByteHashMap(const CtrlByteHashMap& other);
+    CtrlByteHashMap& operator=(const CtrlByteHashMap& other);
+    CtrlByteHashMap(CtrlByteHashMap&& other) noexcept;
+    CtrlByteHashMap& operator=(CtrlByteHashMap&& other) noexcept;
+
+    allocator_type get_allocator() const  {return allocator_type(slot_alloc_);}
+    hasher hash_function() const  {return hash_fn_;}
+    key_equal key_eq() const  {return key_eq_fn_;}
+
+    void clear(); // rm all keys, keeps the capacity
+    void compact()  {if (num_deleted) purge_tombstones();} // keeps the capacity
+
+    size_t size() const  {return num_keys;}
+    size_t capacity() const  {return capacity_;}
+
+private:
+    [[no_unique_address]] SlotAlloc slot_alloc_;
+    [[no_unique_address]] Hash hash_fn_;
+    [[no_unique_address]] KeyEqual key_eq_fn_;
+    Array<int8_t, CtrlAlloc> ctrl_; // capacity_ control bytes
+    Slot* slots_; // capacity_ slots of raw storage
+    size_t capacity_; // a power of 2 >= 16, or 0 for a moved-from map
+    size_t num_keys;
+    size_t num_deleted;
+    size_t growth_left; // EMPTY slots we may still fill before hitting the max load
+    [[no_unique_address]] StatsRecorder recorder_;
+
+    static size_t max_load(size_t capacity)  {return capacity - capacity / 8;}
+    template <typename KeyLike>
+    size_t hash(const KeyLike& key) const  {return mixed_hash(hash_fn_, key);}
+    static int8_t h2(size_t hash)  {return static_cast<int8_t>(hash & 0x7f);}
+
+    size_t slot_count() const  {return capacity_;}
+    bool slot_live(size_t idx) const  {return ctrl_.data()[idx] >= 0;}
+    Slot& slot(size_t idx)  {return slots_[idx];}
+    const Slot& slot(size_t idx) const  {return slots_[idx];}
+
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key) const  {return find_index(key, hash(key));}
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key, size_t hash) const  {return capacity_ ? find_with_hash(key, hash) : npos;}
+    template <typename KeyLike>
+    size_t find_with_hash(const KeyLike& key, size_t hash) const;
+    static constexpr bool BATCH_PREFETCH = false; // slower than the plain loop, even fetching the control bytes only
+    size_t find_insert_slot(size_t hash) const; // first EMPTY or DELETED slot on key's probe sequence
+    template <typename KeyType, typename... Args>
+    std::pair<size_t, bool> emplace_index(KeyType&& key, Args&&... args);
+    void erase_index(size_t idx);
+
+    void allocate_table(size_t capacity); // fresh all EMPTY table, the old one must have been released
+    void destroy_slots();
+    void release(); // destroys all keys and frees the table, leaving a moved-from (capacity 0) map
+    void rehash(size_t new_capacity);
+    void purge_tombstones(); // rehash at the same capacity, in place, see above
+    void steal(CtrlByteHashMap& other) noexcept;
+
+    size_t tombstone_count() const  {return num_deleted;}
+    size_t max_cluster_length() const  {return longest_run(capacity_, [this](size_t i) { return ctrl_.data()[i] != CTRL_EMPTY; });}
+#ifdef HASHMAP_STATS
+    HashMapStats recorded_stats() const  {return recorder_.recorded();}
+#endif
+};
+
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::allocate_table(size_t capacity)  {
+    ctrl_.clear();
+    ctrl_.resize(capacity, CTRL_EMPTY);
+    slots_ = SlotTraits::allocate(slot_alloc_, capacity);
+    capacity_ = capacity;
+    num_keys = 0;
+    num_deleted = 0;
+    growth_left = max_load(capacity);
 }
 
-template <typename K, typename V>
-const V& HashMap<K, V>::operator[](const K& key) const {
-    auto idx = hash(key);
-    auto start_idx = idx;
-    while (1) {
-        auto& entry = arr[idx];
-        if (entry.key() == key && entry.occupied && !entry.deleted) {
-            return entry.val();
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::destroy_slots()  {
+    if constexpr (!std::is_trivially_destructible_v<Slot>) {
+        for (size_t i = 0; i < capacity_; ++i)  {
+            if (slot_live(i)) SlotTraits::destroy(slot_alloc_, slots_ + i);
         }
-        idx = (idx + 1) % num_buckets; // wrap around
-        if (idx == start_idx) throw std::invalid_argument("accessing nonexistent key through const []");
     }
 }
 
-template <typename K, typename V>
-V& HashMap<K, V>::at(const K& key) {
-    auto idx = hash(key);
-    auto start_idx = idx;
-    while (1) {
-        auto& entry = arr[idx];
-        if (entry.key() == key && entry.occupied && !entry.deleted) {
-            return entry.val();
-        }
-        idx = (idx + 1) % num_buckets; // wrap around
-        if (idx == start_idx) throw std::out_of_range("Key is not present.\n");
-    }
-    throw std::runtime_error("Key is not present.\n");
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::release()  {
+    destroy_slots();
+    if (slots_) SlotTraits::deallocate(slot_alloc_, slots_, capacity_);
+    slots_ = nullptr;
+    ctrl_.clear();
+    capacity_ = num_keys = num_deleted = growth_left = 0;
 }
 
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::steal(CtrlByteHashMap& other) noexcept  {
+    hash_fn_ = other.hash_fn_;
+    key_eq_fn_ = other.key_eq_fn_;
+    ctrl_ = std::move(other.ctrl_);
+    slots_ = other.slots_;
+    capacity_ = other.capacity_;
+    num_keys = other.num_keys;
+    num_deleted = other.num_deleted;
+    growth_left = other.growth_left;
+    recorder_ = other.recorder_;
+    other.slots_ = nullptr;
+    other.capacity_ = other.num_keys = other.num_deleted = other.growth_left = 0;
+    other.recorder_.reset();
+}
 
-template <typename K, typename V>
-bool HashMap<K, V>::empty() const {
-    return num_keys == 0;
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::CtrlByteHashMap(const Hash& hash, const KeyEqual& key_eq, const Alloc& alloc)
+    : slot_alloc_(alloc), hash_fn_(hash), key_eq_fn_(key_eq), ctrl_(CtrlAlloc(alloc)), slots_(nullptr), capacity_(0), num_keys(0), num_deleted(0), growth_left(0) {
+    allocate_table(MIN_CAPACITY);
 }
 
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::~CtrlByteHashMap()  {
+    release();
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::CtrlByteHashMap(const CtrlByteHashMap& other)
+    : Base(), slot_alloc_(SlotTraits::select_on_container_copy_construction(other.slot_alloc_)),
+      hash_fn_(other.hash_fn_), key_eq_fn_(other.key_eq_fn_),
+      ctrl_(other.ctrl_), slots_(nullptr), capacity_(0), num_keys(0), num_deleted(0), growth_left(0), recorder_(other.recorder_) {
+    // same capacity and same positions: a slot by slot copy, no rehashing
+    if (other.capacity_ == 0) return;
+    slots_ = SlotTraits::allocate(slot_alloc_, other.capacity_);
+    size_t i = 0;
+    try {
+        for (; i < other.capacity_; ++i)  {
+            if (other.slot_live(i)) SlotTraits::construct(slot_alloc_, slots_ + i, other.slots_[i]);
+        }
+    } catch (...) {
+        for (size_t j = 0; j < i; ++j)  {
+            if (other.slot_live(j)) SlotTraits::destroy(slot_alloc_, slots_ + j);
+        }
+        SlotTraits::deallocate(slot_alloc_, slots_, other.capacity_);
+        throw;
+    }
+    capacity_ = other.capacity_;
+    num_keys = other.num_keys;
+    num_deleted = other.num_deleted;
+    growth_left = other.growth_left;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>& CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::operator=(const CtrlByteHashMap& other)  {
+    if (this != &other) {
+        CtrlByteHashMap copy(other); // copy & swap: *this stays intact if copying throws
+        release();
+        steal(copy);
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::CtrlByteHashMap(CtrlByteHashMap&& other) noexcept
+    : Base(), slot_alloc_(std::move(other.slot_alloc_)), hash_fn_(other.hash_fn_), key_eq_fn_(other.key_eq_fn_),
+      ctrl_(CtrlAlloc(slot_alloc_)), slots_(nullptr), capacity_(0), num_keys(0), num_deleted(0), growth_left(0) {
+    steal(other);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>& CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::operator=(CtrlByteHashMap&& other) noexcept  {
+    if (this != &other) {
+        release();
+        steal(other);
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyLike>
+size_t CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::find_with_hash(const KeyLike& key, size_t hash) const  {
+    size_t group_mask = capacity_ / CtrlGroup::WIDTH - 1;
+    size_t group = (hash >> 7) & group_mask;
+    for (size_t step = 1; ; ++step)  {
+        size_t base = group * CtrlGroup::WIDTH;
+        CtrlGroup g(ctrl_.data() + base);
+        for (uint32_t candidates = g.match(h2(hash)); candidates; candidates &= candidates - 1)  {
+            size_t idx = base + static_cast<size_t>(std::countr_zero(candidates));
+            if (key_eq_fn_(slots_[idx].key(), key)) { // key memory is only touched on a tag match
+                recorder_.probe(true, step);
+                return idx;
+            }
+        }
+        // a miss ends at a group w/ an EMPTY slot, or once every group was probed (only w/out any EMPTY slot left)
+        if (g.match_empty() || step > group_mask) {
+            recorder_.probe(false, step);
+            return npos;
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+size_t CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::find_insert_slot(size_t hash) const  {
+    size_t group_mask = capacity_ / CtrlGroup::WIDTH - 1;
+    size_t group = (hash >> 7) & group_mask;
+    for (size_t step = 1; ; ++step)  {
+        size_t base = group * CtrlGroup::WIDTH;
+        uint32_t free = CtrlGroup(ctrl_.data() + base).match_empty_or_deleted();
+        if (free) return base + static_cast<size_t>(std::countr_zero(free));
+        group = (group + step) & group_mask; // the max load guarantees a free slot somewhere
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyType, typename... Args>
+std::pair<size_t, bool> CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::emplace_index(KeyType&& key, Args&&... args)  {
+    size_t h = hash(key);
+    if (capacity_) {
+        size_t idx = find_with_hash(key, h);
+        if (idx != npos) return {idx, false};
+    }
+
+    size_t idx = capacity_ ? find_insert_slot(h) : npos;
+    if (idx == npos || (ctrl_.data()[idx] == CTRL_EMPTY && growth_left == 0)) {
+        // out of EMPTY slots. Build the new elem first: the args may refer into the table we are about to rehash
+        Slot fresh(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyType>(key)),
+                   std::forward_as_tuple(std::forward<Args>(args)...));
+        if (capacity_ && num_keys < max_load(capacity_) / 2) {
+            purge_tombstones(); // mostly tombstones: purge them at the same size
+        } else {
+            rehash(capacity_ ? capacity_ * 2 : MIN_CAPACITY);
+        }
+        idx = find_insert_slot(h);
+        SlotTraits::construct(slot_alloc_, slots_ + idx, std::move(fresh));
+    } else {
+        SlotTraits::construct(slot_alloc_, slots_ + idx, std::piecewise_construct,
+                              std::forward_as_tuple(std::forward<KeyType>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    if (ctrl_.data()[idx] == CTRL_EMPTY) --growth_left;
+    else --num_deleted; // reusing a tombstone costs no growth
+    ctrl_.data()[idx] = h2(h);
+    ++num_keys;
+    recorder_.loaded(this->load_factor());
+    return {idx, true};
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::rehash(size_t new_capacity)  {
+    RehashTimer timer(recorder_);
+    CtrlByteHashMap old(std::move(*this)); // *this is left w/out a table
+    recorder_ = old.recorder_; // the counts stay w/ *this
+    allocate_table(new_capacity);
+    for (size_t i = 0; i < old.capacity_; ++i)  {
+        if (!old.slot_live(i)) continue;
+        size_t h = hash(old.slots_[i].key());
+        size_t idx = find_insert_slot(h); // all keys are distinct: no lookup needed
+        SlotTraits::construct(slot_alloc_, slots_ + idx, std::move_if_noexcept(old.slots_[i]));
+        ctrl_.data()[idx] = h2(h);
+        ++num_keys;
+        --growth_left;
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::purge_tombstones()  {
+    if constexpr (!std::is_nothrow_move_constructible_v<Slot>) {
+        rehash(capacity_);
+    } else {
+        RehashTimer timer(recorder_);
+        int8_t* ctrl = ctrl_.data();
+        for (size_t i = 0; i < capacity_; ++i)  {
+            if (ctrl[i] == CTRL_DELETED) ctrl[i] = CTRL_EMPTY;
+            else if (ctrl[i] >= 0) ctrl[i] = CTRL_DELETED; // a key still to be placed
+        }
+        for (size_t i = 0; i < capacity_; ++i)  {
+            while (ctrl[i] == CTRL_DELETED) {
+                size_t h = hash(slots_[i].key());
+                size_t idx = find_insert_slot(h); // in i's group at the latest, as i is free
+                if (idx / CtrlGroup::WIDTH == i / CtrlGroup::WIDTH) { // probing reaches no other free slot first: stay
+                    ctrl[i] = h2(h);
+                    break;
+                }
+                if (ctrl[idx] == CTRL_EMPTY) {
+                    SlotTraits::construct(slot_alloc_, slots_ + idx, std::move(slots_[i]));
+                    SlotTraits::destroy(slot_alloc_, slots_ + i);
+                    ctrl[i] = CTRL_EMPTY;
+                } else { // swap w/ the unplaced key there, placed next
+                    Slot displaced(std::move(slots_[idx]));
+                    SlotTraits::destroy(slot_alloc_, slots_ + idx);
+                    SlotTraits::construct(slot_alloc_, slots_ + idx, std::move(slots_[i]));
+                    SlotTraits::destroy(slot_alloc_, slots_ + i);
+                    SlotTraits::construct(slot_alloc_, slots_ + i, std::move(displaced));
+                }
+                ctrl[idx] = h2(h);
+            }
+        }
+        num_deleted = 0;
+        growth_left = max_load(capacity_) - num_keys;
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::erase_index(size_t idx)  {
+    SlotTraits::destroy(slot_alloc_, slots_ + idx);
+    size_t base = idx & ~(CtrlGroup::WIDTH - 1);
+    if (CtrlGroup(ctrl_.data() + base).match_empty()) {
+        ctrl_.data()[idx] = CTRL_EMPTY; // no probe sequence continues past this group, so no tombstone is needed
+        ++growth_left;
+    } else {
+        ctrl_.data()[idx] = CTRL_DELETED;
+        ++num_deleted;
+    }
+    --num_keys;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>::clear()  {
+    destroy_slots();
+    for (size_t i = 0; i < capacity_; ++i)  {
+        ctrl_.data()[i] = CTRL_EMPTY;
+    }
+    num_keys = num_deleted = 0;
+    growth_left = max_load(capacity_);
+}
+
+
+/*
+Robin Hood: linear probing w/ the keys of a cluster kept sorted by home slot, so no key sits further from home than needed
+
+    slots: [ a  | b  | c  |    | d  ]      dist: [ 1 | 1 | 2 | 0 | 1 ]      dist = probe distance + 1, 0 for an empty slot
+             ^h(a) ^h(b),h(c)   ^h(d)
+
+Insert walks from the home slot and takes the first slot whose key is "richer" (closer to its own home) than the new key,
+shifting the rest of the cluster one slot up, so long probe sequences are shared out evenly among all keys.
+Lookup stops as soon as it passes a slot whose key is richer than the sought one would be there: the key cannot be further.
+Erase shifts the following keys of the cluster one slot back (backward shift deletion) instead of leaving a tombstone, so
+the table never degrades under churn: probe lengths only depend on the load, never on the history.
+
+Max load: 7/8 of the slots. Distances are stored in 2 B: a probe sequence that would exceed 65534 slots, only possible w/ a hash
+that maps that many keys to one slot, throws std::length_error, since no table size would help.
+*/
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class RobinHoodHashMap : public HashMapBase<RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>, K, V, KeyValue<K, V>> {
+    friend class HashMapBase<RobinHoodHashMap, K, V, KeyValue<K, V>>;
+    template <typename, typename, typename, typename, typename>
+    friend class IncrementalHashMap; // drives 2 Robin Hood tables
+    using Base = HashMapBase<RobinHoodHashMap, K, V, KeyValue<K, V>>;
+    using Slot = KeyValue<K, V>;
+    using SlotAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+    using SlotTraits = std::allocator_traits<SlotAlloc>;
+    using DistAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<uint16_t>;
+
+    static constexpr size_t MIN_CAPACITY = 16;
+    static constexpr uint16_t MAX_DIST = 0xffff;
+
+public:
+    using allocator_type = Alloc;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using Base::npos;
+
+    RobinHoodHashMap() : RobinHoodHashMap(Hash()) {}
+    explicit RobinHoodHashMap(const Alloc& alloc) : RobinHoodHashMap(Hash(), KeyEqual(), alloc) {}
+    explicit RobinHoodHashMap(const Hash& hash, const KeyEqual& key_eq = KeyEqual(), const Alloc& alloc = Alloc());
+    ~RobinHoodHashMap();
+    RobinHoodHashMap(const RobinHoodHashMap& other);
+    RobinHoodHashMap& operator=(const RobinHoodHashMap& other);
+    RobinHoodHashMap(RobinHoodHashMap&& other) noexcept;
+    RobinHoodHashMap& operator=(RobinHoodHashMap&& other) noexcept;
+
+    allocator_type get_allocator() const  {return allocator_type(slot_alloc_);}
+    hasher hash_function() const  {return hash_fn_;}
+    key_equal key_eq() const  {return key_eq_fn_;}
+
+    void clear(); // rm all keys, keeps the capacity
+    void compact()  {} // no tombstones to purge
+
+    size_t size() const  {return num_keys;}
+    size_t capacity() const  {return capacity_;}
+    size_t max_probe_length() const; // longest probe sequence of any key present, O(capacity)
+
+private:
+    [[no_unique_address]] SlotAlloc slot_alloc_;
+    [[no_unique_address]] Hash hash_fn_;
+    [[no_unique_address]] KeyEqual key_eq_fn_;
+    Array<uint16_t, DistAlloc> dist_; // capacity_ probe distances + 1, 0 for an empty slot
+    Slot* slots_; // capacity_ slots of raw storage
+    size_t capacity_; // a power of 2 >= 16, or 0 for a moved-from map
+    size_t num_keys;
+    [[no_unique_address]] StatsRecorder recorder_;
+
+    static size_t max_load(size_t capacity)  {return capacity - capacity / 8;}
+    template <typename KeyLike>
+    size_t hash(const KeyLike& key) const  {return mixed_hash(hash_fn_, key);}
+
+    size_t slot_count() const  {return capacity_;}
+    bool slot_live(size_t idx) const  {return dist_.data()[idx] != 0;}
+    Slot& slot(size_t idx)  {return slots_[idx];}
+    const Slot& slot(size_t idx) const  {return slots_[idx];}
+
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key) const  {return find_index(key, hash(key));}
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key, size_t hash) const  {return capacity_ ? find_with_hash(key, hash) : npos;}
+    template <typename KeyLike>
+    size_t find_with_hash(const KeyLike& key, size_t hash) const;
+    static constexpr bool BATCH_PREFETCH = false; // slower than the plain loop, even fetching the distances only
+    template <typename KeyType, typename... Args>
+    std::pair<size_t, bool> emplace_index(KeyType&& key, Args&&... args);
+    void erase_index(size_t idx);
+    size_t place(size_t hash); // opens up the slot where a new key of hash belongs
+    size_t adopt_slot(Slot& src); // moves src in, its key must be absent & the table below max load. Returns its slot
+    void relocate_slot(size_t dst, size_t src); // dst must be empty, src is left destroyed
+
+    void allocate_table(size_t capacity);
+    void destroy_slots();
+    void release();
+    void rehash(size_t new_capacity);
+    void steal(RobinHoodHashMap& other) noexcept;
+
+    size_t tombstone_count() const  {return 0;} // backward shift deletion
+    size_t max_cluster_length() const  {return longest_run(capacity_, [this](size_t i) { return slot_live(i); });}
+#ifdef HASHMAP_STATS
+    HashMapStats recorded_stats() const  {return recorder_.recorded();}
+#endif
+};
+
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::allocate_table(size_t capacity)  {
+    dist_.clear();
+    dist_.resize(capacity, 0);
+    slots_ = SlotTraits::allocate(slot_alloc_, capacity);
+    capacity_ = capacity;
+    num_keys = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::destroy_slots()  {
+    if constexpr (!std::is_trivially_destructible_v<Slot>) {
+        for (size_t i = 0; i < capacity_; ++i)  {
+            if (slot_live(i)) SlotTraits::destroy(slot_alloc_, slots_ + i);
+        }
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::release()  {
+    destroy_slots();
+    if (slots_) SlotTraits::deallocate(slot_alloc_, slots_, capacity_);
+    slots_ = nullptr;
+    dist_.clear();
+    capacity_ = num_keys = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::steal(RobinHoodHashMap& other) noexcept  {
+    hash_fn_ = other.hash_fn_;
+    key_eq_fn_ = other.key_eq_fn_;
+    dist_ = std::move(other.dist_);
+    slots_ = other.slots_;
+    capacity_ = other.capacity_;
+    num_keys = other.num_keys;
+    recorder_ = other.recorder_;
+    other.slots_ = nullptr;
+    other.capacity_ = other.num_keys = 0;
+    other.recorder_.reset();
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::RobinHoodHashMap(const Hash& hash, const KeyEqual& key_eq, const Alloc& alloc)
+    : slot_alloc_(alloc), hash_fn_(hash), key_eq_fn_(key_eq), dist_(DistAlloc(alloc)), slots_(nullptr), capacity_(0), num_keys(0) {
+    allocate_table(MIN_CAPACITY);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::~RobinHoodHashMap()  {
+    release();
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::RobinHoodHashMap(const RobinHoodHashMap& other)
+    : Base(), slot_alloc_(SlotTraits::select_on_container_copy_construction(other.slot_alloc_)),
+      hash_fn_(other.hash_fn_), key_eq_fn_(other.key_eq_fn_),
+      dist_(other.dist_), slots_(nullptr), capacity_(0), num_keys(0), recorder_(other.recorder_) {
+    if (other.capacity_ == 0) return;
+    slots_ = SlotTraits::allocate(slot_alloc_, other.capacity_);
+    size_t i = 0;
+    try {
+        for (; i < other.capacity_; ++i)  {
+            if (other.slot_live(i)) SlotTraits::construct(slot_alloc_, slots_ + i, other.slots_[i]);
+        }
+    } catch (...) {
+        for (size_t j = 0; j < i; ++j)  {
+            if (other.slot_live(j)) SlotTraits::destroy(slot_alloc_, slots_ + j);
+        }
+        SlotTraits::deallocate(slot_alloc_, slots_, other.capacity_);
+        throw;
+    }
+    capacity_ = other.capacity_;
+    num_keys = other.num_keys;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>& RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::operator=(const RobinHoodHashMap& other)  {
+    if (this != &other) {
+        RobinHoodHashMap copy(other);
+        release();
+        steal(copy);
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::RobinHoodHashMap(RobinHoodHashMap&& other) noexcept
+    : Base(), slot_alloc_(std::move(other.slot_alloc_)), hash_fn_(other.hash_fn_), key_eq_fn_(other.key_eq_fn_),
+      dist_(DistAlloc(slot_alloc_)), slots_(nullptr), capacity_(0), num_keys(0) {
+    steal(other);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>& RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::operator=(RobinHoodHashMap&& other) noexcept  {
+    if (this != &other) {
+        release();
+        steal(other);
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyLike>
+size_t RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::find_with_hash(const KeyLike& key, size_t hash) const  {
+    size_t mask = capacity_ - 1;
+    size_t idx = hash & mask;
+    for (size_t dist = 1; ; ++dist)  {
+        // the key would have been placed here at the latest, ahead of any key richer than it
+        if (dist_.data()[idx] < dist) {
+            recorder_.probe(false, dist);
+            return npos;
+        }
+        if (key_eq_fn_(slots_[idx].key(), key)) {
+            recorder_.probe(true, dist);
+            return idx;
+        }
+        idx = (idx + 1) & mask;
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::relocate_slot(size_t dst, size_t src)  {
+    SlotTraits::construct(slot_alloc_, slots_ + dst, std::move(slots_[src]));
+    SlotTraits::destroy(slot_alloc_, slots_ + src);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+size_t RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::place(size_t hash)  {
+    size_t mask = capacity_ - 1;
+    size_t pos = hash & mask;
+    size_t dist = 1;
+    while (dist_.data()[pos] >= dist) { // skip the keys at least as poor as the new one
+        pos = (pos + 1) & mask;
+        if (++dist == MAX_DIST) throw std::length_error("Probe distance overflow, check the hash function.");
+    }
+    // pos is where the new key goes. The rest of the cluster, up to the next empty slot, shifts one slot up
+    size_t empty = pos;
+    while (dist_.data()[empty] != 0) {
+        if (dist_.data()[empty] == MAX_DIST - 1) throw std::length_error("Probe distance overflow, check the hash function.");
+        empty = (empty + 1) & mask;
+    }
+    for (size_t idx = empty; idx != pos; ) {
+        size_t prev = (idx - 1) & mask;
+        relocate_slot(idx, prev);
+        dist_.data()[idx] = static_cast<uint16_t>(dist_.data()[prev] + 1);
+        idx = prev;
+    }
+    dist_.data()[pos] = static_cast<uint16_t>(dist);
+    return pos;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyType, typename... Args>
+std::pair<size_t, bool> RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::emplace_index(KeyType&& key, Args&&... args)  {
+    size_t h = hash(key);
+    size_t idx = capacity_ ? find_with_hash(key, h) : npos;
+    if (idx != npos) return {idx, false};
+
+    // Build the new elem first: shifting or rehashing moves keys around, and the args may refer into the table
+    Slot fresh(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyType>(key)),
+               std::forward_as_tuple(std::forward<Args>(args)...));
+    if (capacity_ == 0 || num_keys >= max_load(capacity_)) {
+        rehash(capacity_ ? capacity_ * 2 : MIN_CAPACITY);
+    }
+    idx = place(h);
+    SlotTraits::construct(slot_alloc_, slots_ + idx, std::move(fresh));
+    ++num_keys;
+    recorder_.loaded(this->load_factor());
+    return {idx, true};
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::rehash(size_t new_capacity)  {
+    RehashTimer timer(recorder_);
+    RobinHoodHashMap old(std::move(*this)); // *this is left w/out a table
+    recorder_ = old.recorder_; // the counts stay w/ *this
+    allocate_table(new_capacity);
+    for (size_t i = 0; i < old.capacity_; ++i)  {
+        if (!old.slot_live(i)) continue;
+        adopt_slot(old.slots_[i]); // all keys are distinct: no lookup needed
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+size_t RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::adopt_slot(Slot& src)  {
+    size_t idx = place(hash(src.key()));
+    SlotTraits::construct(slot_alloc_, slots_ + idx, std::move_if_noexcept(src));
+    ++num_keys;
+    return idx;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::erase_index(size_t idx)  {
+    SlotTraits::destroy(slot_alloc_, slots_ + idx);
+    size_t mask = capacity_ - 1;
+    // backward shift: pull the rest of the cluster one slot closer to home, until a key already home or an empty slot
+    for (size_t next = (idx + 1) & mask; dist_.data()[next] > 1; next = (next + 1) & mask)  {
+        relocate_slot(idx, next);
+        dist_.data()[idx] = static_cast<uint16_t>(dist_.data()[next] - 1);
+        idx = next;
+    }
+    dist_.data()[idx] = 0;
+    --num_keys;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::clear()  {
+    destroy_slots();
+    for (size_t i = 0; i < capacity_; ++i)  {
+        dist_.data()[i] = 0;
+    }
+    num_keys = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+size_t RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>::max_probe_length() const  {
+    size_t longest = 0;
+    for (size_t i = 0; i < capacity_; ++i)  {
+        longest = std::max<size_t>(longest, dist_.data()[i]);
+    }
+    return longest;
+}
+
+
+/*
+Incremental rehashing: growth w/out a stop the world rehash
+
+    current_:  [ 2x capacity, receives every new key ]
+    old_:      [ . . . . . | k  v | k  v | ... ]      the table before the last growth, drained left to right
+                           ^ cursor_
+
+When current_ reaches its max load, it becomes old_ and an empty table twice its size takes its place. Every later
+insert or erase then moves the keys of at most MIGRATE_STEP slots of old_ (starting at cursor_) into current_, so no single
+op pays for more than a bounded slice of the rehash. Until old_ is drained, lookups consult both tables.
+Both tables are Robin Hood tables: erasing a migrated key from old_ shifts the rest of its cluster back, but never
+past cursor_, since every slot left of cursor_ was emptied already.
+
+Migration always finishes long before current_ fills up again: old_ has capacity C, current_ 2C slots of which 1.75C may
+be used, so the C / MIGRATE_STEP ops that drain old_ come first. Should the rare table w/ a lot of erases get there
+anyway, the rest of old_ is drained at once.
+Const ops (lookups, iteration) never migrate.
+*/
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class IncrementalHashMap : public HashMapBase<IncrementalHashMap<K, V, Hash, KeyEqual, Alloc>, K, V, KeyValue<K, V>> {
+    friend class HashMapBase<IncrementalHashMap, K, V, KeyValue<K, V>>;
+    using Base = HashMapBase<IncrementalHashMap, K, V, KeyValue<K, V>>;
+    using Slot = KeyValue<K, V>;
+    using Table = RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>;
+
+public:
+    using allocator_type = Alloc;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using Base::npos;
+
+    static constexpr size_t MIGRATE_STEP = 32; // old_ slots visited per mutating op
+
+    IncrementalHashMap() : IncrementalHashMap(Hash()) {}
+    explicit IncrementalHashMap(const Alloc& alloc) : IncrementalHashMap(Hash(), KeyEqual(), alloc) {}
+    explicit IncrementalHashMap(const Hash& hash, const KeyEqual& key_eq = KeyEqual(), const Alloc& alloc = Alloc())
+        : current_(hash, key_eq, alloc), old_(hash, key_eq, alloc), cursor_(0)  {
+        Table unused(std::move(old_)); // old_ only has a table while rehashing
+    }
+
+    allocator_type get_allocator() const  {return current_.get_allocator();}
+    hasher hash_function() const  {return current_.hash_function();}
+    key_equal key_eq() const  {return current_.key_eq();}
+
+    void clear(); // rm all keys, keeps the capacity of current_
+    void compact()  {migrate(static_cast<size_t>(-1));} // no tombstones, but finishes the migration & frees old_
+
+    size_t size() const  {return current_.size() + old_.size();}
+    size_t capacity() const  {return current_.capacity();}
+    bool rehashing() const  {return old_.capacity() != 0;} // whether old_ still holds keys to migrate
+
+private:
+    Table current_;
+    Table old_;
+    size_t cursor_; // slots of old_ below cursor_ are empty
+    [[no_unique_address]] StatsRecorder recorder_; // the counts of the tables dropped so far. Both tables keep their own
+
+    size_t slot_count() const  {return current_.slot_count() + old_.slot_count();}
+    // current_'s slots first, then old_'s
+    bool slot_live(size_t idx) const  {
+        return idx < current_.slot_count() ? current_.slot_live(idx) : old_.slot_live(idx - current_.slot_count());
+    }
+    Slot& slot(size_t idx)  {return idx < current_.slot_count() ? current_.slot(idx) : old_.slot(idx - current_.slot_count());}
+    const Slot& slot(size_t idx) const  {
+        return idx < current_.slot_count() ? current_.slot(idx) : old_.slot(idx - current_.slot_count());
+    }
+
+    template <typename KeyLike>
+    size_t hash(const KeyLike& key) const  {return current_.hash(key);} // both tables share the hasher
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key) const  {return find_index(key, hash(key));}
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key, size_t hash) const;
+    static constexpr bool BATCH_PREFETCH = Table::BATCH_PREFETCH;
+    template <typename KeyType, typename... Args>
+    std::pair<size_t, bool> emplace_index(KeyType&& key, Args&&... args);
+    void erase_index(size_t idx);
+
+    void migrate(size_t max_slots); // moves the keys of up to max_slots slots of old_ into current_
+    void grow(); // current_ becomes old_, once the previous old_ is drained
+
+    size_t tombstone_count() const  {return 0;}
+    size_t max_cluster_length() const  {return std::max(current_.max_cluster_length(), old_.max_cluster_length());}
+#ifdef HASHMAP_STATS
+    // during migration, a lookup missing current_ counts as a probe of each table
+    HashMapStats recorded_stats() const  {
+        StatsRecorder all = recorder_;
+        all.merge(current_.recorder_);
+        all.merge(old_.recorder_);
+        return all.recorded();
+    }
+#endif
+};
+
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void IncrementalHashMap<K, V, Hash, KeyEqual, Alloc>::migrate(size_t max_slots)  {
+    if (!rehashing()) return;
+    for (size_t visited = 0; visited < max_slots && cursor_ < old_.capacity_; ++visited)  {
+        if (!old_.slot_live(cursor_)) {
+            ++cursor_;
+            continue;
+        }
+        current_.adopt_slot(old_.slots_[cursor_]);
+        old_.erase_index(cursor_); // shifts the rest of the cluster into cursor_, so cursor_ is checked again
+    }
+    if (cursor_ == old_.capacity_) {
+        Table drained(std::move(old_)); // frees the old table, leaving old_ w/out one
+        recorder_.merge(drained.recorder_);
+        cursor_ = 0;
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void IncrementalHashMap<K, V, Hash, KeyEqual, Alloc>::grow()  {
+    migrate(static_cast<size_t>(-1)); // only ever needed after lots of erases, see above
+    old_ = std::move(current_);
+    current_.rehash(old_.capacity_ * 2); // on a moved-from table: just allocates
+    cursor_ = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyLike>
+size_t IncrementalHashMap<K, V, Hash, KeyEqual, Alloc>::find_index(const KeyLike& key, size_t hash) const  {
+    size_t idx = current_.find_index(key, hash);
+    if (idx != npos) return idx;
+    idx = old_.find_index(key, hash);
+    return idx == npos ? npos : current_.slot_count() + idx;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyType, typename... Args>
+std::pair<size_t, bool> IncrementalHashMap<K, V, Hash, KeyEqual, Alloc>::emplace_index(KeyType&& key, Args&&... args)  {
+    migrate(MIGRATE_STEP);
+    if (rehashing()) {
+        size_t idx = old_.find_index(key);
+        if (idx != npos) return {current_.slot_count() + idx, false};
+    }
+    if (current_.capacity_ && current_.num_keys >= Table::max_load(current_.capacity_)) {
+        size_t idx = current_.find_index(key);
+        if (idx != npos) return {idx, false};
+        // Build the new elem first: growing drains old_, and the args may refer into it
+        Slot fresh(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyType>(key)),
+                   std::forward_as_tuple(std::forward<Args>(args)...));
+        grow();
+        return {current_.adopt_slot(fresh), true};
+    }
+    return current_.emplace_index(std::forward<KeyType>(key), std::forward<Args>(args)...); // never grows now
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void IncrementalHashMap<K, V, Hash, KeyEqual, Alloc>::erase_index(size_t idx)  {
+    if (idx < current_.slot_count()) current_.erase_index(idx);
+    else old_.erase_index(idx - current_.slot_count());
+    migrate(MIGRATE_STEP);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void IncrementalHashMap<K, V, Hash, KeyEqual, Alloc>::clear()  {
+    current_.clear();
+    Table dropped(std::move(old_));
+    recorder_.merge(dropped.recorder_);
+    cursor_ = 0;
+}
+
+
+/*
+Separate chaining: keys live in a pool of nodes, each bucket heads a linked list of the nodes hashing to it
+
+    buckets_:  [ 3 | NIL | 0 | ... ]                   index of the first node of each chain
+    nodes_:    [ h,k,v -> NIL | h,k,v -> 2 | h,k,v -> NIL | h,k,v -> 1 | free -> NIL ]
+                                                         ^ free_
+
+Nodes are drawn from one slab (an Array) and linked by 4 B indices rather than ptrs: no allocation per insert, and erased
+nodes go on a free list reused by later inserts. Each node stores its full hash, so walking a chain compares keys only
+when the hashes match, and growing the table relinks the nodes w/out rehashing a single key or moving a node.
+
+Unlike open addressing, the load factor (keys per bucket) may exceed 1: max_load_factor() defaults to 1 and can be raised
+(e.g. to 4) to trade a few extra compares per lookup for a much smaller bucket arr, w/out the collapse of open addressing
+near a full table. A node costs its key, value, hash and link, so large values are cheaper than in open addressing,
+whose empty slots hold default constructed values.
+
+Slot indices are node indices: iteration walks the slab, its length being the most nodes ever live at once.
+*/
+template <typename K, typename V>
+struct ChainNode  : public KeyValue<K, V>  {
+    static constexpr uint32_t NIL = static_cast<uint32_t>(-1);
+
+    size_t hash = 0;
+    uint32_t next = NIL; // next node of the chain, or of the free list
+    bool live = false;
+
+    ChainNode() = default;
+    template <typename KeyType, typename... Args>
+    ChainNode(size_t h, KeyType&& key, Args&&... args)
+        : KeyValue<K, V>(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyType>(key)),
+                         std::forward_as_tuple(std::forward<Args>(args)...)), hash(h), live(true)  {}
+};
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class ChainedHashMap : public HashMapBase<ChainedHashMap<K, V, Hash, KeyEqual, Alloc>, K, V, ChainNode<K, V>> {
+    friend class HashMapBase<ChainedHashMap, K, V, ChainNode<K, V>>;
+    using Base = HashMapBase<ChainedHashMap, K, V, ChainNode<K, V>>;
+    using Node = ChainNode<K, V>;
+    using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using BucketAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<uint32_t>;
+
+    static constexpr size_t INITIAL_BUCKETS = 16;
+    static constexpr uint32_t NIL = Node::NIL;
+
+public:
+    using allocator_type = Alloc;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using Base::npos;
+
+    ChainedHashMap() : ChainedHashMap(Hash()) {}
+    explicit ChainedHashMap(const Alloc& alloc) : ChainedHashMap(Hash(), KeyEqual(), alloc) {}
+    explicit ChainedHashMap(const Hash& hash, const KeyEqual& key_eq = KeyEqual(), const Alloc& alloc = Alloc())
+        : buckets_(BucketAlloc(alloc)), nodes_(NodeAlloc(alloc)), hash_fn_(hash), key_eq_fn_(key_eq)  {
+        buckets_.resize(INITIAL_BUCKETS, NIL);
+    }
+    ChainedHashMap(const ChainedHashMap& other) = default;
+    ChainedHashMap& operator=(const ChainedHashMap& other) = default;
+    ChainedHashMap(ChainedHashMap&& other) noexcept;
+    ChainedHashMap& operator=(ChainedHashMap&& other) noexcept;
+
+    allocator_type get_allocator() const  {return allocator_type(nodes_.get_allocator());}
+    hasher hash_function() const  {return hash_fn_;}
+    key_equal key_eq() const  {return key_eq_fn_;}
+
+    void clear(); // rm all keys, keeps the buckets
+    void compact()  {} // erased nodes are unlinked right away, nothing to purge
+
+    size_t size() const  {return num_keys_;}
+    size_t bucket_count() const  {return buckets_.size();}
+    double load_factor() const  {return bucket_count() ? static_cast<double>(num_keys_) / bucket_count() : 0.0;} // keys per bucket
+    float max_load_factor() const  {return max_load_factor_;}
+    void max_load_factor(float ml); // > 0. Grows the buckets right away if the load exceeds it
+
+private:
+    Array<uint32_t, BucketAlloc> buckets_; // a power of 2 of chain heads, none for a moved-from map
+    Array<Node, NodeAlloc> nodes_;
+    [[no_unique_address]] Hash hash_fn_;
+    [[no_unique_address]] KeyEqual key_eq_fn_;
+    uint32_t free_ = NIL; // head of the free list
+    size_t num_keys_ = 0;
+    float max_load_factor_ = 1.0f;
+    [[no_unique_address]] StatsRecorder recorder_;
+
+    template <typename KeyLike>
+    size_t hash(const KeyLike& key) const  {return mixed_hash(hash_fn_, key);}
+    size_t bucket(size_t hash) const  {return hash & (buckets_.size() - 1);}
+
+    size_t slot_count() const  {return nodes_.size();}
+    bool slot_live(size_t idx) const  {return nodes_[idx].live;}
+    Node& slot(size_t idx)  {return nodes_[idx];}
+    const Node& slot(size_t idx) const  {return nodes_[idx];}
+
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key) const  {return find_index(key, hash(key));}
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key, size_t hash) const  {return buckets_.empty() ? npos : find_with_hash(key, hash);}
+    // the chain's head would be the only line to prefetch: where its first node is, is only known once that arrives
+    static constexpr bool BATCH_PREFETCH = false;
+    template <typename KeyLike>
+    size_t find_with_hash(const KeyLike& key, size_t hash) const;
+    template <typename KeyType, typename... Args>
+    std::pair<size_t, bool> emplace_index(KeyType&& key, Args&&... args);
+    void erase_index(size_t idx);
+    void rehash(size_t new_bucket_count); // relinks every node, keys are neither hashed nor moved
+    bool over_max_load(size_t num_keys) const  {return num_keys > max_load_factor_ * buckets_.size();}
+
+    size_t tombstone_count() const  {return 0;} // erased nodes leave their chain right away
+    size_t max_cluster_length() const; // the longest chain
+#ifdef HASHMAP_STATS
+    HashMapStats recorded_stats() const  {return recorder_.recorded();}
+#endif
+};
+
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::ChainedHashMap(ChainedHashMap&& other) noexcept
+    : Base(), buckets_(std::move(other.buckets_)), nodes_(std::move(other.nodes_)), hash_fn_(other.hash_fn_),
+      key_eq_fn_(other.key_eq_fn_), free_(other.free_), num_keys_(other.num_keys_), max_load_factor_(other.max_load_factor_),
+      recorder_(other.recorder_)  {
+    other.free_ = NIL;
+    other.num_keys_ = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+ChainedHashMap<K, V, Hash, KeyEqual, Alloc>& ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::operator=(ChainedHashMap&& other) noexcept  {
+    if (this != &other) {
+        buckets_ = std::move(other.buckets_);
+        nodes_ = std::move(other.nodes_);
+        hash_fn_ = other.hash_fn_;
+        key_eq_fn_ = other.key_eq_fn_;
+        free_ = other.free_;
+        num_keys_ = other.num_keys_;
+        max_load_factor_ = other.max_load_factor_;
+        recorder_ = other.recorder_;
+        other.free_ = NIL;
+        other.num_keys_ = 0;
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyLike>
+size_t ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::find_with_hash(const KeyLike& key, size_t hash) const  {
+    size_t visited = 0;
+    for (uint32_t idx = buckets_[bucket(hash)]; idx != NIL; idx = nodes_[idx].next)  {
+        const Node& node = nodes_[idx];
+        ++visited;
+        if (node.hash == hash && key_eq_fn_(node.key(), key)) {
+            recorder_.probe(true, visited);
+            return idx;
+        }
+    }
+    recorder_.probe(false, visited);
+    return npos;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyType, typename... Args>
+std::pair<size_t, bool> ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::emplace_index(KeyType&& key, Args&&... args)  {
+    if (buckets_.empty()) buckets_.resize(INITIAL_BUCKETS, NIL); // moved-from
+    size_t h = hash(key);
+    size_t found = find_with_hash(key, h);
+    if (found != npos) return {found, false};
+
+    // Build the new node first: growing the slab moves the nodes, and the args may refer into it
+    Node fresh(h, std::forward<KeyType>(key), std::forward<Args>(args)...);
+    uint32_t idx = free_;
+    if (idx != NIL) {
+        free_ = nodes_[idx].next;
+        nodes_[idx] = std::move(fresh);
+    } else {
+        if (nodes_.size() >= NIL) throw std::length_error("ChainedHashMap holds at most 2^32 - 1 nodes.");
+        idx = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back(std::move(fresh));
+    }
+    ++num_keys_;
+    if (over_max_load(num_keys_)) {
+        rehash(buckets_.size() * 2); // links the new node too
+    } else {
+        size_t b = bucket(h);
+        nodes_[idx].next = buckets_[b];
+        buckets_[b] = idx;
+    }
+    recorder_.loaded(load_factor());
+    return {idx, true};
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::erase_index(size_t idx)  {
+    Node& node = nodes_[idx];
+    uint32_t* link = &buckets_[bucket(node.hash)];
+    while (*link != idx) link = &nodes_[*link].next;
+    *link = node.next;
+
+    static_cast<KeyValue<K, V>&>(node) = KeyValue<K, V>(); // releases what the key & value hold, e.g. large values
+    node.live = false;
+    node.next = free_;
+    free_ = static_cast<uint32_t>(idx);
+    --num_keys_;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::rehash(size_t new_bucket_count)  {
+    RehashTimer timer(recorder_);
+    while (over_max_load(num_keys_) || buckets_.size() < new_bucket_count) {
+        buckets_.resize(buckets_.size() * 2, NIL);
+    }
+    for (size_t b = 0; b < buckets_.size(); ++b)  {
+        buckets_[b] = NIL;
+    }
+    for (size_t idx = 0; idx < nodes_.size(); ++idx)  {
+        Node& node = nodes_[idx];
+        if (!node.live) continue;
+        size_t b = bucket(node.hash);
+        node.next = buckets_[b];
+        buckets_[b] = static_cast<uint32_t>(idx);
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::max_load_factor(float ml)  {
+    if (!(ml > 0)) throw std::invalid_argument("max_load_factor must be positive.");
+    max_load_factor_ = ml;
+    if (!buckets_.empty() && over_max_load(num_keys_)) rehash(buckets_.size());
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+size_t ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::max_cluster_length() const  {
+    size_t longest = 0;
+    for (size_t b = 0; b < buckets_.size(); ++b)  {
+        size_t length = 0;
+        for (uint32_t idx = buckets_[b]; idx != NIL; idx = nodes_[idx].next)  {
+            ++length;
+        }
+        longest = std::max(longest, length);
+    }
+    return longest;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void ChainedHashMap<K, V, Hash, KeyEqual, Alloc>::clear()  {
+    nodes_.clear();
+    for (size_t b = 0; b < buckets_.size(); ++b)  {
+        buckets_[b] = NIL;
+    }
+    free_ = NIL;
+    num_keys_ = 0;
+}
+
+
+/*
+Compact dict (CPython's layout): the entries live in 1 dense arr in insertion order, the hash table only holds their indices
+
+    indices_:  [ -1 | 1 | -2 | 0 | -1 | 2 | -1 | -1 ]      capacity_ slots of 1, 2, 4 or 8 B: an entry index, EMPTY or DUMMY
+    entries_:  [ h,k,v | h,k,v | dead | h,k,v ]            <= 2/3 capacity_, appended to
+
+Lookup probes indices_ linearly (the mixed hash spreads keys well enough) and compares the key of each entry it points to
+whose hash matches. Erase marks the index slot DUMMY, so that the probe sequences passing it carry on, and leaves a dead
+entry behind; an insert probing past a DUMMY reuses it, so tombstones() (the DUMMY slots) can be fewer than the dead
+entries. Once entries_ is full the table is rebuilt for 3x the live keys: the dead entries are squeezed out (the
+order of the others kept) and indices_ is refilled from the stored hashes, so no key is rehashed. Under churn at a
+constant size that rebuild keeps the capacity.
+
+Iteration walks entries_: O(size + dead entries) over contiguous memory, in insertion order (an overwrite keeps the
+position, an erase + insert moves the key to the end), whatever the capacity. The index slots are as narrow as the
+capacity allows, 1 B up to 128 slots, 2 B up to 32K, then 4 B (8 B past 2^31), and no empty slot holds a key or value,
+so a table of large values costs little more than the values themselves.
+
+Slot indices are entry indices: they stay put until the next rebuild, i.e. erase invalidates no iterator.
+*/
 template <typename K, typename V>
-size_t HashMap<K, V>::size() const {
-    return num_keys;
+struct OrderedEntry  : public KeyValue<K, V>  {
+    size_t hash = 0;
+    bool live = false;
+
+    OrderedEntry() = default;
+    template <typename KeyType, typename... Args>
+    OrderedEntry(size_t h, KeyType&& key, Args&&... args)
+        : KeyValue<K, V>(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyType>(key)),
+                         std::forward_as_tuple(std::forward<Args>(args)...)), hash(h), live(true)  {}
+};
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class OrderedHashMap : public HashMapBase<OrderedHashMap<K, V, Hash, KeyEqual, Alloc>, K, V, OrderedEntry<K, V>> {
+    friend class HashMapBase<OrderedHashMap, K, V, OrderedEntry<K, V>>;
+    using Base = HashMapBase<OrderedHashMap, K, V, OrderedEntry<K, V>>;
+    using Entry = OrderedEntry<K, V>;
+    using EntryAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Entry>;
+    using ByteAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<uint8_t>;
+
+    static constexpr size_t MIN_CAPACITY = 8;
+    static constexpr int64_t EMPTY = -1; // never used
+    static constexpr int64_t DUMMY = -2; // erased, probing carries on
+
+public:
+    using allocator_type = Alloc;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using Base::npos;
+
+    OrderedHashMap() : OrderedHashMap(Hash()) {}
+    explicit OrderedHashMap(const Alloc& alloc) : OrderedHashMap(Hash(), KeyEqual(), alloc) {}
+    explicit OrderedHashMap(const Hash& hash, const KeyEqual& key_eq = KeyEqual(), const Alloc& alloc = Alloc())
+        : indices_(ByteAlloc(alloc)), entries_(EntryAlloc(alloc)), hash_fn_(hash), key_eq_fn_(key_eq)  {
+        rebuild(MIN_CAPACITY);
+    }
+    OrderedHashMap(const OrderedHashMap& other) = default;
+    OrderedHashMap& operator=(const OrderedHashMap& other) = default;
+    OrderedHashMap(OrderedHashMap&& other) noexcept;
+    OrderedHashMap& operator=(OrderedHashMap&& other) noexcept;
+
+    allocator_type get_allocator() const  {return allocator_type(entries_.get_allocator());}
+    hasher hash_function() const  {return hash_fn_;}
+    key_equal key_eq() const  {return key_eq_fn_;}
+
+    void clear(); // rm all keys, keeps the capacity
+    void compact()  {if (entries_.size() != num_keys_) rebuild(capacity_);} // squeezes out the dead entries & DUMMYs, keeps the capacity
+
+    size_t size() const  {return num_keys_;}
+    size_t capacity() const  {return capacity_;} // num of index slots
+    size_t index_width() const  {return width_;} // B per index slot
+    double load_factor() const  {return capacity_ ? static_cast<double>(num_keys_) / capacity_ : 0.0;} // keys per index slot
+
+private:
+    Array<uint8_t, ByteAlloc> indices_; // capacity_ slots of width_ B each, none for a moved-from map
+    Array<Entry, EntryAlloc> entries_; // live & dead entries, in insertion order
+    [[no_unique_address]] Hash hash_fn_;
+    [[no_unique_address]] KeyEqual key_eq_fn_;
+    size_t capacity_ = 0; // a power of 2
+    size_t width_ = 0;
+    size_t num_keys_ = 0;
+    size_t num_dummies_ = 0; // DUMMY index slots; can be fewer than the dead entries, as inserts reuse DUMMY slots
+    [[no_unique_address]] StatsRecorder recorder_;
+
+    static size_t usable(size_t capacity)  {return capacity * 2 / 3;} // entries per table, dead ones included
+    static size_t width_for(size_t capacity)  { // EMPTY & DUMMY are negative, so slot values must fit in a signed int
+        if (capacity <= (size_t{1} << 7)) return 1;
+        if (capacity <= (size_t{1} << 15)) return 2;
+        if (capacity <= (size_t{1} << 31)) return 4;
+        return 8;
+    }
+    int64_t index_at(size_t i) const;
+    void set_index(size_t i, int64_t entry);
+
+    template <typename KeyLike>
+    size_t hash(const KeyLike& key) const  {return mixed_hash(hash_fn_, key);}
+
+    size_t slot_count() const  {return entries_.size();}
+    bool slot_live(size_t idx) const  {return entries_[idx].live;}
+    Entry& slot(size_t idx)  {return entries_[idx];}
+    const Entry& slot(size_t idx) const  {return entries_[idx];}
+
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key) const  {return find_index(key, hash(key));}
+    template <typename KeyLike>
+    size_t find_index(const KeyLike& key, size_t hash) const  {return capacity_ ? find_with_hash(key, hash) : npos;}
+    static constexpr bool BATCH_PREFETCH = true;
+    void prefetch(size_t hash) const  { // the index slot only: which entry it points to is only known once that arrives
+        if (capacity_) prefetch_read(indices_.data() + (hash & (capacity_ - 1)) * width_);
+    }
+    template <typename KeyLike>
+    size_t find_with_hash(const KeyLike& key, size_t hash) const;
+    template <typename KeyType, typename... Args>
+    std::pair<size_t, bool> emplace_index(KeyType&& key, Args&&... args);
+    void erase_index(size_t idx);
+    void rebuild(size_t new_capacity); // drops the dead entries & refills indices_, keys are not rehashed
+    size_t free_index_slot(size_t hash) const; // 1st EMPTY or DUMMY slot of hash's probe sequence
+
+    size_t tombstone_count() const  {return num_dummies_;}
+    size_t max_cluster_length() const  {return longest_run(capacity_, [this](size_t i) { return index_at(i) != EMPTY; });}
+#ifdef HASHMAP_STATS
+    HashMapStats recorded_stats() const  {return recorder_.recorded();}
+#endif
+};
+
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::OrderedHashMap(OrderedHashMap&& other) noexcept
+    : Base(), indices_(std::move(other.indices_)), entries_(std::move(other.entries_)), hash_fn_(other.hash_fn_),
+      key_eq_fn_(other.key_eq_fn_), capacity_(other.capacity_), width_(other.width_), num_keys_(other.num_keys_),
+      num_dummies_(other.num_dummies_), recorder_(other.recorder_)  {
+    other.capacity_ = other.width_ = other.num_keys_ = other.num_dummies_ = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+OrderedHashMap<K, V, Hash, KeyEqual, Alloc>& OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::operator=(OrderedHashMap&& other) noexcept  {
+    if (this != &other) {
+        indices_ = std::move(other.indices_);
+        entries_ = std::move(other.entries_);
+        hash_fn_ = other.hash_fn_;
+        key_eq_fn_ = other.key_eq_fn_;
+        capacity_ = other.capacity_;
+        width_ = other.width_;
+        num_keys_ = other.num_keys_;
+        num_dummies_ = other.num_dummies_;
+        recorder_ = other.recorder_;
+        other.capacity_ = other.width_ = other.num_keys_ = other.num_dummies_ = 0;
+    }
+    return *this;
+}
+
+// memcpy rather than a cast of the byte arr: no aliasing UB, and it compiles down to 1 load or store
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+int64_t OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::index_at(size_t i) const  {
+    const uint8_t* ptr = indices_.data() + i * width_;
+    switch (width_) {
+        case 1: {int8_t val; std::memcpy(&val, ptr, 1); return val;}
+        case 2: {int16_t val; std::memcpy(&val, ptr, 2); return val;}
+        case 4: {int32_t val; std::memcpy(&val, ptr, 4); return val;}
+        default: {int64_t val; std::memcpy(&val, ptr, 8); return val;}
+    }
 }
 
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::set_index(size_t i, int64_t entry)  {
+    uint8_t* ptr = indices_.data() + i * width_;
+    switch (width_) {
+        case 1: {int8_t val = static_cast<int8_t>(entry); std::memcpy(ptr, &val, 1); break;}
+        case 2: {int16_t val = static_cast<int16_t>(entry); std::memcpy(ptr, &val, 2); break;}
+        case 4: {int32_t val = static_cast<int32_t>(entry); std::memcpy(ptr, &val, 4); break;}
+        default: std::memcpy(ptr, &entry, 8);
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyLike>
+size_t OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::find_with_hash(const KeyLike& key, size_t hash) const  {
+    size_t mask = capacity_ - 1;
+    size_t visited = 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask, ++visited)  {
+        int64_t entry = index_at(i);
+        if (entry == EMPTY) break; // usable() < capacity_ guarantees an EMPTY slot
+        if (entry == DUMMY) continue;
+        const Entry& candidate = entries_[static_cast<size_t>(entry)];
+        if (candidate.hash == hash && key_eq_fn_(candidate.key(), key)) {
+            recorder_.probe(true, visited);
+            return static_cast<size_t>(entry);
+        }
+    }
+    recorder_.probe(false, visited);
+    return npos;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+size_t OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::free_index_slot(size_t hash) const  {
+    size_t mask = capacity_ - 1;
+    size_t i = hash & mask;
+    while (index_at(i) >= 0) i = (i + 1) & mask;
+    return i;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+template <typename KeyType, typename... Args>
+std::pair<size_t, bool> OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::emplace_index(KeyType&& key, Args&&... args)  {
+    if (!capacity_) rebuild(MIN_CAPACITY); // moved-from
+    size_t h = hash(key);
+    size_t found = find_with_hash(key, h);
+    if (found != npos) return {found, false};
+
+    // Build the new entry first: the rebuild moves the entries, and the args may refer into them
+    Entry fresh(h, std::forward<KeyType>(key), std::forward<Args>(args)...);
+    if (entries_.size() == usable(capacity_)) {
+        // 3x the live keys: doubles a table w/out dead entries, keeps the capacity of one that churned
+        rebuild(std::max(MIN_CAPACITY, std::bit_ceil(num_keys_ * 3)));
+    }
+    size_t idx = entries_.size();
+    entries_.push_back(std::move(fresh));
+    size_t slot = free_index_slot(h);
+    if (index_at(slot) == DUMMY) --num_dummies_;
+    set_index(slot, static_cast<int64_t>(idx));
+    ++num_keys_;
+    recorder_.loaded(load_factor());
+    return {idx, true};
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::erase_index(size_t idx)  {
+    Entry& entry = entries_[idx];
+    size_t mask = capacity_ - 1;
+    size_t i = entry.hash & mask;
+    while (index_at(i) != static_cast<int64_t>(idx)) i = (i + 1) & mask;
+    set_index(i, DUMMY);
+    ++num_dummies_;
+
+    static_cast<KeyValue<K, V>&>(entry) = KeyValue<K, V>(); // releases what the key & value hold, e.g. large values
+    entry.live = false;
+    --num_keys_;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::rebuild(size_t new_capacity)  {
+    RehashTimer timer(recorder_);
+    entries_.remove_if([](const Entry& entry) { return !entry.live; }); // keeps the order of the live ones
+    entries_.reserve(usable(new_capacity));
+    width_ = width_for(new_capacity);
+    capacity_ = new_capacity;
+    num_dummies_ = 0;
+    indices_.clear();
+    indices_.resize(capacity_ * width_, 0xff); // all bytes 0xff: EMPTY in every width
+    for (size_t idx = 0; idx < entries_.size(); ++idx)  {
+        set_index(free_index_slot(entries_[idx].hash), static_cast<int64_t>(idx));
+    }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+void OrderedHashMap<K, V, Hash, KeyEqual, Alloc>::clear()  {
+    entries_.clear();
+    for (size_t i = 0; i < indices_.size(); ++i)  {
+        indices_[i] = 0xff;
+    }
+    num_keys_ = 0;
+    num_dummies_ = 0;
+}
+
+
+#ifdef COMPACT_DICT
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+using HashMap = OrderedHashMap<K, V, Hash, KeyEqual, Alloc>;
+
+#elif defined(SEPARATE_CHAIN)
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+using HashMap = ChainedHashMap<K, V, Hash, KeyEqual, Alloc>;
+
+#elif defined(CTRL_BYTES)
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+using HashMap = CtrlByteHashMap<K, V, Hash, KeyEqual, Alloc>;
+
+#elif defined(ROBIN_HOOD)
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+using HashMap = RobinHoodHashMap<K, V, Hash, KeyEqual, Alloc>;
+
+#elif defined(INCREMENTAL_REHASH)
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+using HashMap = IncrementalHashMap<K, V, Hash, KeyEqual, Alloc>;
+
+#elif defined(OPEN_ADDR)
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+using HashMap = OpenAddrHashMap<K, V, Hash, KeyEqual, Alloc>;
 
 #endif // imple toggle
 
-#endif // __HASHMap_HASHMap_HPP
\ No newline at end of file
+
+// HashMap drawing its buckets from a std::pmr::memory_resource
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+using PmrHashMap = HashMap<K, V, Hash, KeyEqual, std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+
+#endif // __HASHMap_HASHMap_HPP
@@ -0,0 +1,190 @@
+// Separate chaining vs open addressing, w/ chaining run at max load factors 0.5 to 4,
+// then contains_batch vs contains() in a loop, on tables larger than the cache,
+// then iterating tables that grew large & were mostly erased again.
+// Build w/ optimizations & w/out sanitizers: make bench
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <memory>
+#include "HashMap.hpp"
+
+// Counts the bytes a map holds, to set the load factors' memory savings against their lookup costs
+inline size_t bytes_in_use = 0;
+
+template <typename T>
+struct CountingAlloc {
+    using value_type = T;
+    CountingAlloc() = default;
+    template <typename U>
+    CountingAlloc(const CountingAlloc<U>&) {}
+    T* allocate(size_t n) {
+        bytes_in_use += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* ptr, size_t n) {
+        bytes_in_use -= n * sizeof(T);
+        std::allocator<T>().deallocate(ptr, n);
+    }
+    template <typename U>
+    bool operator==(const CountingAlloc<U>&) const { return true; }
+};
+
+using Key = uint64_t;
+using Val = uint64_t;
+using Alloc = CountingAlloc<std::pair<const Key, Val>>;
+
+constexpr size_t BUCKETS = 1 << 18; // chaining's bucket count at every load factor
+volatile size_t sink; // the lookups' results go here, so they cannot be optimized out
+
+struct Result {
+    double insert_ns, hit_ns, miss_ns, bytes_per_key, load;
+};
+
+template <typename Clock = std::chrono::steady_clock>
+double ns_per_op(typename Clock::time_point start, size_t ops) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+}
+
+template <typename MapType>
+Result run(MapType& Map, const std::vector<Key>& keys, const std::vector<Key>& missing) {
+    size_t before = bytes_in_use;
+    auto start = std::chrono::steady_clock::now();
+    for (Key key : keys) {
+        Map.insert(key, key);
+    }
+    Result result;
+    result.insert_ns = ns_per_op(start, keys.size());
+    result.bytes_per_key = static_cast<double>(bytes_in_use - before) / keys.size();
+    result.load = Map.load_factor();
+
+    size_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (Key key : keys) {
+        found += Map.contains(key);
+    }
+    result.hit_ns = ns_per_op(start, keys.size());
+    start = std::chrono::steady_clock::now();
+    for (Key key : missing) {
+        found += Map.contains(key);
+    }
+    result.miss_ns = ns_per_op(start, missing.size());
+    sink = found;
+    return result;
+}
+
+void print(const std::string& name, const Result& result) {
+    std::cout << std::setw(22) << name << std::fixed << std::setprecision(2) << std::setw(8) << result.load << std::setprecision(1)
+              << std::setw(12) << result.insert_ns << std::setw(10) << result.hit_ns << std::setw(10) << result.miss_ns
+              << std::setw(12) << result.bytes_per_key << std::endl;
+}
+
+constexpr size_t BIG_TABLE_KEYS = 1 << 23;
+constexpr size_t LOOKUPS = 1 << 22;
+
+// ns per lookup of half present, half missing keys: 1 by 1, then batched
+template <typename MapType>
+void batch_vs_loop(const std::string& name, const std::vector<Key>& keys, const std::vector<Key>& lookups) {
+    MapType Map;
+    for (Key key : keys) {
+        Map.insert(key, key);
+    }
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (Key key : lookups) {
+        found += Map.contains(key);
+    }
+    double loop_ns = ns_per_op(start, lookups.size());
+    std::unique_ptr<bool[]> results(new bool[lookups.size()]);
+    start = std::chrono::steady_clock::now();
+    found += Map.contains_batch(lookups, results.get());
+    double batch_ns = ns_per_op(start, lookups.size());
+    sink = found;
+    std::cout << std::setw(22) << name << std::fixed << std::setprecision(1) << std::setw(10) << loop_ns << std::setw(10) << batch_ns
+              << std::setw(10) << loop_ns / batch_ns << "x" << std::endl;
+}
+
+void bench_batches(std::mt19937_64& gen) {
+    std::vector<Key> keys(BIG_TABLE_KEYS), lookups(LOOKUPS);
+    for (Key& key : keys) {
+        key = gen();
+    }
+    for (size_t i = 0; i < lookups.size(); ++i) {
+        lookups[i] = i % 2 ? keys[gen() % keys.size()] : gen();
+    }
+    std::cout << "\nns per lookup, " << BIG_TABLE_KEYS << " keys, " << HashMap<Key, Val>::PREFETCH_GROUP << " keys per prefetch group" << std::endl;
+    std::cout << std::setw(22) << "map" << std::setw(10) << "loop" << std::setw(10) << "batch" << std::setw(11) << "speedup" << std::endl;
+    batch_vs_loop<OpenAddrHashMap<Key, Val>>("open addressing", keys, lookups);
+    batch_vs_loop<CtrlByteHashMap<Key, Val>>("control bytes", keys, lookups);
+    batch_vs_loop<RobinHoodHashMap<Key, Val>>("robin hood", keys, lookups);
+    batch_vs_loop<ChainedHashMap<Key, Val>>("chaining", keys, lookups);
+    batch_vs_loop<OrderedHashMap<Key, Val>>("compact dict", keys, lookups);
+}
+
+constexpr size_t PEAK_KEYS = 1 << 21;
+constexpr size_t KEPT_KEYS = 1 << 14;
+
+// ns per key kept of 1 iteration over a table that held PEAK_KEYS keys, all but KEPT_KEYS of them erased, then compacted
+template <typename MapType>
+void iterate_sparse(const std::string& name, const std::vector<Key>& keys) {
+    MapType Map;
+    for (Key key : keys) {
+        Map.insert(key, key);
+    }
+    for (size_t i = KEPT_KEYS; i < keys.size(); ++i) {
+        Map.erase(keys[i]);
+    }
+    Map.compact();
+    size_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& elem : Map) {
+        sum += elem.second;
+    }
+    double iterate_ns = ns_per_op(start, KEPT_KEYS);
+    sink = sum;
+    std::cout << std::setw(22) << name << std::fixed << std::setprecision(1) << std::setw(10) << iterate_ns << std::endl;
+}
+
+void bench_iteration(std::mt19937_64& gen) {
+    std::vector<Key> keys(PEAK_KEYS);
+    for (Key& key : keys) {
+        key = gen();
+    }
+    std::cout << "\nns per key of 1 iteration, " << KEPT_KEYS << " keys left of " << PEAK_KEYS << std::endl;
+    std::cout << std::setw(22) << "map" << std::setw(10) << "iterate" << std::endl;
+    iterate_sparse<OpenAddrHashMap<Key, Val>>("open addressing", keys);
+    iterate_sparse<RobinHoodHashMap<Key, Val>>("robin hood", keys);
+    iterate_sparse<ChainedHashMap<Key, Val>>("chaining", keys);
+    iterate_sparse<OrderedHashMap<Key, Val>>("compact dict", keys);
+}
+
+int main() {
+    std::mt19937_64 gen(42);
+    std::cout << "ns per op, 8 B keys & values, chaining w/ " << BUCKETS << " buckets" << std::endl;
+    std::cout << std::setw(22) << "map" << std::setw(8) << "load" << std::setw(12) << "insert" << std::setw(10) << "hit"
+              << std::setw(10) << "miss" << std::setw(12) << "bytes/key" << std::endl;
+    for (double max_load : {0.5, 1.0, 2.0, 4.0}) {
+        // exactly max_load keys per bucket: the most chaining holds before growing
+        std::vector<Key> keys(static_cast<size_t>(max_load * BUCKETS)), missing(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            keys[i] = gen();
+            missing[i] = gen();
+        }
+        std::cout << keys.size() << " keys" << std::endl;
+
+        ChainedHashMap<Key, Val, std::hash<Key>, std::equal_to<Key>, Alloc> Chained;
+        Chained.max_load_factor(static_cast<float>(max_load));
+        print("chaining", run(Chained, keys, missing));
+        // open addressing picks its own load, <= .7 (7/8 for Robin Hood), for the same keys
+        OpenAddrHashMap<Key, Val, std::hash<Key>, std::equal_to<Key>, Alloc> OpenAddr;
+        print("open addressing", run(OpenAddr, keys, missing));
+        RobinHoodHashMap<Key, Val, std::hash<Key>, std::equal_to<Key>, Alloc> RobinHood;
+        print("robin hood", run(RobinHood, keys, missing));
+    }
+    bench_batches(gen);
+    bench_iteration(gen);
+    return 0;
+}
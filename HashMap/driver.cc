@@ -5,12 +5,248 @@
 #include <set>
 #include <random>
 #include <algorithm>
+#include <unordered_map>
+#include <cctype>
+#include <string_view>
+#include <span>
+#include <memory>
 #include "HashMap.hpp"
 
 void printTestResult(const std::string& testName, bool passed) {
     std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
 }
 
+// Case insensitive ASCII keys, to plug into Hash & KeyEqual
+struct CaseInsensitiveHash {
+    size_t operator()(const std::string& key) const {
+        std::string lower = key;
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+        return std::hash<std::string>()(lower);
+    }
+};
+struct CaseInsensitiveEqual {
+    bool operator()(const std::string& a, const std::string& b) const {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+                                                  [](unsigned char x, unsigned char y) { return std::tolower(x) == std::tolower(y); });
+    }
+};
+
+// Worst possible hash: every key collides. Declared avalanching so that not even hash_mix can spread it
+struct ConstantHash {
+    using is_avalanching = void;
+    size_t operator()(int) const { return 42; }
+};
+
+template <typename MapType>
+bool customFunctorsWork() {
+    MapType Map;
+    Map.insert("Hello", 1);
+    Map["HELLO"] += 1;
+    Map.insert("World", 3);
+    return Map.size() == 2 && Map.at("hello") == 2 && Map.contains("wORLD") && !Map.contains("word");
+}
+
+template <typename MapType>
+bool collidingKeysWork() {
+    MapType Map;
+    for (int i = 0; i < 200; ++i) {
+        Map.insert(i, -i);
+    }
+    for (int i = 0; i < 200; i += 2) {
+        Map.erase(i);
+    }
+    bool allFound = true;
+    for (int i = 0; i < 200; ++i) {
+        if (Map.contains(i) != (i % 2 == 1) || (i % 2 == 1 && Map.at(i) != -i)) allFound = false;
+    }
+    return allFound && Map.size() == 100;
+}
+
+// Counts its copies, to check that the emplacing ops move or construct in place
+struct CopyCounter {
+    static int copies;
+    int value = 0;
+    CopyCounter() = default;
+    CopyCounter(int v) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&&) = default;
+    CopyCounter& operator=(const CopyCounter& other) { value = other.value; ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&&) = default;
+};
+int CopyCounter::copies = 0;
+
+template <template <typename...> class MapTemplate>
+bool emplacingApiWorks() {
+    MapTemplate<std::string, CopyCounter> Map;
+    CopyCounter::copies = 0;
+    auto [it, inserted] = Map.try_emplace("alpha", 1);
+    bool ok = inserted && it->first == "alpha" && it->second.value == 1;
+
+    CopyCounter kept(2);
+    auto [again, insertedAgain] = Map.try_emplace("alpha", std::move(kept));
+    ok = ok && !insertedAgain && again == it && again->second.value == 1;
+
+    std::string key = "beta";
+    Map.try_emplace(std::move(key), CopyCounter(3));
+    auto [assigned, insertedByAssign] = Map.insert_or_assign("beta", CopyCounter(4));
+    ok = ok && !insertedByAssign && assigned->second.value == 4 && Map.insert_or_assign("gamma", 5).second;
+    Map.emplace(std::string("delta"), 6);
+    Map.emplace(std::make_pair(std::string("delta"), CopyCounter(7))); // key exists: no effect
+    ok = ok && CopyCounter::copies == 0 && Map.at("delta").value == 6;
+
+    Map["epsilon"] = 8;
+    ok = ok && Map.find("epsilon")->second.value == 8 && Map.find("zeta") == Map.end();
+    const auto& ConstMap = Map;
+    ok = ok && ConstMap.find("gamma")->second.value == 5 && ConstMap.find("zeta") == ConstMap.end();
+    return ok && Map.size() == 5 && Map.erase("beta") && !Map.erase("beta") && Map.size() == 4;
+}
+
+template <template <typename...> class MapTemplate>
+bool heterogeneousLookupWorks() {
+    MapTemplate<std::string, int, StringHash, std::equal_to<>> Map;
+    Map.insert("routing", 1);
+    Map.insert("table", 2);
+    std::string_view view = "routing table";
+    bool ok = Map.contains(view.substr(0, 7)) && Map.at(view.substr(8)) == 2 && !Map.contains(view);
+    ok = ok && Map.find(view.substr(8))->second == 2 && Map.find(view) == Map.end();
+    return ok && Map.erase(view.substr(0, 7)) && Map.size() == 1;
+}
+
+// Batches spanning several prefetch groups, and growth in the middle of insert_batch
+template <template <typename...> class MapTemplate>
+bool batchedOpsWork() {
+    MapTemplate<int, int> Map;
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 1000; ++i) {
+        pairs.emplace_back(i * 2, i);
+    }
+    bool ok = Map.insert_batch(pairs) == 1000 && Map.size() == 1000;
+    pairs[0].second = -1;
+    ok = ok && Map.insert_batch(std::span(pairs.data(), 1)) == 0 && Map.at(0) == -1; // overwrites
+
+    std::vector<int> keys;
+    for (int i = 0; i < 2001; ++i) {
+        keys.push_back(i);
+    }
+    std::unique_ptr<bool[]> found(new bool[keys.size()]);
+    ok = ok && Map.contains_batch(keys, found.get()) == 1000;
+    std::vector<int*> vals(keys.size());
+    ok = ok && Map.find_batch(keys, vals.data()) == 1000;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        bool present = i % 2 == 0 && i < 2000;
+        if (found[i] != present || (vals[i] != nullptr) != present) ok = false;
+        if (present && i > 0 && *vals[i] != int(i / 2)) ok = false;
+    }
+    const auto& ConstMap = Map;
+    std::vector<const int*> constVals(keys.size());
+    ok = ok && ConstMap.find_batch(keys, constVals.data()) == 1000 && constVals[4] == &Map.at(4);
+    MapTemplate<int, int> Empty;
+    return ok && Empty.contains_batch(std::span(keys.data(), 3), found.get()) == 0 && !found[0];
+}
+
+#ifdef HASHMAP_STATS
+uint64_t probeCount(const uint64_t* bins) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < HashMapStats::PROBE_BINS; ++i) {
+        total += bins[i];
+    }
+    return total;
+}
+
+// Every lookup lands in exactly 1 histogram, growth is counted & the peak load stays below the max load
+template <typename MapType>
+bool statsRecorded(double max_load) {
+    MapType Map;
+    for (int i = 0; i < 1000; ++i) {
+        Map.insert(i, i);
+    }
+    HashMapStats before = Map.stats();
+    for (int i = 0; i < 1000; ++i) {
+        Map.contains(i);
+        Map.contains(-1 - i);
+    }
+    HashMapStats after = Map.stats();
+    bool ok = probeCount(after.hit_probes) - probeCount(before.hit_probes) == 1000
+              && probeCount(after.miss_probes) - probeCount(before.miss_probes) == 1000;
+    ok = ok && after.rehashes > 0 && after.peak_load_factor > 0.3 && after.peak_load_factor <= max_load;
+
+    MapType Copy = Map;
+    return ok && Copy.stats().rehashes == after.rehashes && Copy.stats().max_cluster_length == after.max_cluster_length;
+}
+#endif
+
+// Random inserts, erases & lookups on MapType, checked against std::unordered_map after every op
+template <typename MapType>
+bool churnMatchesReference(unsigned seed, int num_ops, int key_range) {
+    MapType Map;
+    std::unordered_map<int, int> reference;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> keys(0, key_range - 1);
+    for (int i = 0; i < num_ops; ++i) {
+        int key = keys(gen);
+        switch (i % 3) {
+            case 0:
+                Map.insert(key, i);
+                reference[key] = i;
+                break;
+            case 1:
+                if (Map.erase(key) != (reference.erase(key) == 1)) return false;
+                break;
+            case 2:
+                if (Map.contains(key) != reference.count(key)) return false;
+                if (Map.contains(key) && Map.at(key) != reference[key]) return false;
+                break;
+        }
+    }
+    size_t iterated = 0;
+    for (const auto& elem : Map) {
+        if (reference.count(elem.first) == 0 || reference[elem.first] != elem.second) return false;
+        ++iterated;
+    }
+    return Map.size() == reference.size() && iterated == reference.size();
+}
+
+// std::allocator counting the allocations made through it & its rebinds
+inline size_t allocations = 0;
+template <typename T>
+struct CountingAllocator : std::allocator<T> {
+    using value_type = T;
+    template <typename U> struct rebind { using other = CountingAllocator<U>; };
+    CountingAllocator() = default;
+    template <typename U> CountingAllocator(const CountingAllocator<U>&) {}
+    T* allocate(size_t n) {
+        ++allocations;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+// Only 8 distinct hashes: long clusters, so purging the tombstones has to move & swap keys
+struct ClusteringHash {
+    size_t operator()(int key) const { return std::hash<int>()(key % 8); }
+};
+
+// compact() purges the tombstones w/out allocating, and every key is found again, then & after more inserts
+template <template <typename...> class MapTemplate>
+bool purgesInPlace() {
+    MapTemplate<int, std::string, ClusteringHash, std::equal_to<int>, CountingAllocator<std::pair<const int, std::string>>> Map;
+    for (int i = 0; i < 300; ++i) {
+        Map.insert(i, std::to_string(i));
+    }
+    for (int i = 0; i < 300; i += 3) {
+        Map.erase(i);
+    }
+    size_t tombstones = Map.tombstones(), before = allocations;
+    Map.compact();
+    bool kept = tombstones > 0 && Map.tombstones() == 0 && allocations == before && Map.size() == 200;
+    for (int i = 0; i < 300; ++i) {
+        if (Map.contains(i) != (i % 3 != 0) || (i % 3 && Map.at(i) != std::to_string(i))) kept = false;
+    }
+    for (int i = 0; i < 300; i += 3) {
+        Map.insert(i, "again");
+    }
+    return kept && Map.size() == 300 && Map.at(0) == "again" && Map.at(299) == "299";
+}
+
 int main() {
     try {
         // Test 1: Basic Operations
@@ -214,6 +450,350 @@ int main() {
             printTestResult("Stress Test - Size Consistency", Map.size() == reference.size());
         }
 
+        // Test 8: Every Imple, Regardless Of The Toggle
+        {
+            printTestResult("Open Addressing - Churn", churnMatchesReference<OpenAddrHashMap<int, int>>(1, 30000, 500));
+            printTestResult("Control Bytes - Churn", churnMatchesReference<CtrlByteHashMap<int, int>>(1, 30000, 500));
+            printTestResult("Control Bytes - Large Churn", churnMatchesReference<CtrlByteHashMap<int, int>>(2, 60000, 20000));
+
+            // keys inserted & erased in a sliding window: tombstones pile up, but are purged w/out growing the table
+            CtrlByteHashMap<int, std::string> Map;
+            for (int i = 0; i < 100000; ++i) {
+                Map.insert(i, std::to_string(i));
+                if (i >= 50) Map.erase(i - 50);
+            }
+            printTestResult("Control Bytes - Tombstones Do Not Grow The Table", Map.size() == 50 && Map.capacity() <= 128
+                            && Map.at(99999) == "99999" && !Map.contains(99949));
+
+            CtrlByteHashMap<int, std::string> Copy = Map;
+            CtrlByteHashMap<int, std::string> Moved = std::move(Map);
+            printTestResult("Control Bytes - Copy And Move", Copy.size() == 50 && Moved.at(99950) == "99950"
+                            && Map.empty() && Map.begin() == Map.end());
+            Map.insert(1, "one"); // a moved-from map is usable again
+            printTestResult("Control Bytes - Reuse After Move", Map.size() == 1 && Map[1] == "one");
+        }
+
+        // Test 9: Robin Hood
+        {
+            printTestResult("Robin Hood - Churn", churnMatchesReference<RobinHoodHashMap<int, int>>(1, 30000, 500));
+            printTestResult("Robin Hood - Large Churn", churnMatchesReference<RobinHoodHashMap<int, int>>(2, 60000, 20000));
+
+            // erase leaves no tombstones: hours of churn at a constant size keep the table & probe lengths of a fresh one
+            RobinHoodHashMap<int, std::string> Map;
+            for (int i = 0; i < 1000; ++i) {
+                Map.insert(i, std::to_string(i));
+            }
+            size_t freshCapacity = Map.capacity();
+            size_t freshProbe = Map.max_probe_length();
+            for (int i = 1000; i < 200000; ++i) {
+                Map.erase(i - 1000);
+                Map.insert(i, std::to_string(i));
+            }
+            printTestResult("Robin Hood - Churn Keeps Capacity", Map.size() == 1000 && Map.capacity() == freshCapacity
+                            && Map.at(199999) == "199999" && !Map.contains(198999));
+            printTestResult("Robin Hood - Churn Keeps Probe Lengths Bounded", Map.max_probe_length() <= freshProbe + 8);
+
+            // values that refer into the map itself survive the shifting & rehashing they trigger
+            RobinHoodHashMap<int, std::string> Self;
+            Self.insert(0, std::string(40, 'x'));
+            for (int i = 1; i < 100; ++i) {
+                Self.insert(i, Self.at(i - 1));
+            }
+            printTestResult("Robin Hood - Self Referencing Insert", Self.size() == 100 && Self.at(99) == std::string(40, 'x'));
+        }
+
+        // Test 10: Hash And KeyEqual Parameters
+        {
+            printTestResult("Custom Functors - Open Addressing",
+                            customFunctorsWork<OpenAddrHashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual>>());
+            printTestResult("Custom Functors - Control Bytes",
+                            customFunctorsWork<CtrlByteHashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual>>());
+            printTestResult("Custom Functors - Robin Hood",
+                            customFunctorsWork<RobinHoodHashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual>>());
+            printTestResult("Colliding Hash - Open Addressing", collidingKeysWork<OpenAddrHashMap<int, int, ConstantHash>>());
+            printTestResult("Colliding Hash - Control Bytes", collidingKeysWork<CtrlByteHashMap<int, int, ConstantHash>>());
+            printTestResult("Colliding Hash - Robin Hood", collidingKeysWork<RobinHoodHashMap<int, int, ConstantHash>>());
+
+            // power of 2 bucket counts: 44 keys fit the initial 64 buckets, 45 push the load past .7 and double them
+            OpenAddrHashMap<int, int> Map;
+            for (int i = 0; i < 45; ++i) {
+                Map.insert(i, i);
+            }
+            printTestResult("Power Of Two Buckets", Map.load_factor() == 45.0 / 64);
+            Map.insert(45, 45);
+            printTestResult("Power Of Two Buckets - Doubling", Map.load_factor() == 46.0 / 128);
+        }
+
+        // Test 11: Single Probe API
+        {
+            printTestResult("try_emplace / insert_or_assign / emplace - Open Addressing", emplacingApiWorks<OpenAddrHashMap>());
+            printTestResult("try_emplace / insert_or_assign / emplace - Control Bytes", emplacingApiWorks<CtrlByteHashMap>());
+            printTestResult("try_emplace / insert_or_assign / emplace - Robin Hood", emplacingApiWorks<RobinHoodHashMap>());
+            printTestResult("Heterogeneous Lookup - Open Addressing", heterogeneousLookupWorks<OpenAddrHashMap>());
+            printTestResult("Heterogeneous Lookup - Control Bytes", heterogeneousLookupWorks<CtrlByteHashMap>());
+            printTestResult("Heterogeneous Lookup - Robin Hood", heterogeneousLookupWorks<RobinHoodHashMap>());
+        }
+
+        // Test 12: Incremental Rehashing
+        {
+            printTestResult("Incremental - Churn", churnMatchesReference<IncrementalHashMap<int, int>>(1, 30000, 500));
+            printTestResult("Incremental - Large Churn", churnMatchesReference<IncrementalHashMap<int, int>>(2, 60000, 20000));
+            printTestResult("Incremental - API", emplacingApiWorks<IncrementalHashMap>() && heterogeneousLookupWorks<IncrementalHashMap>());
+
+            IncrementalHashMap<int, int> Map;
+            int key = 0;
+            for (; key < 10000 || Map.rehashing(); ++key) {
+                Map.insert(key, key);
+            }
+            while (!Map.rehashing()) {
+                Map.insert(key, key);
+                ++key;
+            }
+            // growth only swapped the tables: all keys but the newest still sit in the old one, and are found there
+            bool allFound = true;
+            size_t iterated = 0;
+            for (int i = 0; i < key; ++i) {
+                if (Map.at(i) != i) allFound = false;
+            }
+            for (const auto& elem : Map) {
+                iterated += elem.first == elem.second;
+            }
+            printTestResult("Incremental - Lookups During Migration", allFound && iterated == Map.size() && Map.size() == size_t(key));
+
+            int opsToDrain = 0;
+            while (Map.rehashing()) {
+                Map.insert(key, key);
+                ++key;
+                ++opsToDrain;
+            }
+            // every op visits MIGRATE_STEP slots of the old table (half the capacity), a slot w/ a key twice
+            printTestResult("Incremental - Bounded Migration Per Op",
+                            opsToDrain > 1 && size_t(opsToDrain) <= Map.capacity() / IncrementalHashMap<int, int>::MIGRATE_STEP + 1);
+            allFound = true;
+            for (int i = 0; i < key; ++i) {
+                if (Map.at(i) != i) allFound = false;
+            }
+            printTestResult("Incremental - All Keys Migrated", allFound && Map.size() == size_t(key));
+        }
+
+        // Test 13: Separate Chaining
+        {
+            printTestResult("Chaining - Churn", churnMatchesReference<ChainedHashMap<int, int>>(1, 30000, 500));
+            printTestResult("Chaining - Large Churn", churnMatchesReference<ChainedHashMap<int, int>>(2, 60000, 20000));
+            printTestResult("Chaining - API", emplacingApiWorks<ChainedHashMap>() && heterogeneousLookupWorks<ChainedHashMap>());
+            printTestResult("Chaining - Custom Functors",
+                            customFunctorsWork<ChainedHashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual>>());
+            printTestResult("Chaining - Colliding Hash", collidingKeysWork<ChainedHashMap<int, int, ConstantHash>>());
+
+            // loads above 1: 4 keys per bucket on average, the buckets only grow past that
+            ChainedHashMap<int, std::string> Map;
+            Map.max_load_factor(4.0f);
+            for (int i = 0; i < 4096; ++i) {
+                Map.insert(i, std::to_string(i));
+            }
+            bool allFound = true;
+            for (int i = 0; i < 4096; ++i) {
+                if (Map.at(i) != std::to_string(i)) allFound = false;
+            }
+            printTestResult("Chaining - High Load Factor", allFound && Map.bucket_count() == 1024 && Map.load_factor() == 4.0);
+            Map.max_load_factor(1.0f);
+            printTestResult("Chaining - Lowering Max Load Factor Grows", Map.bucket_count() == 4096 && Map.at(4095) == "4095");
+
+            // erased nodes are reused: churn at a constant size does not grow the slab we iterate over
+            for (int round = 0; round < 10; ++round) {
+                for (int i = 0; i < 4096; i += 2) {
+                    Map.erase(i);
+                }
+                for (int i = 0; i < 4096; i += 2) {
+                    Map.insert(i, std::to_string(-i));
+                }
+            }
+            size_t iterated = 0;
+            for (const auto& elem : Map) {
+                iterated += elem.second == std::to_string(elem.first % 2 ? elem.first : -elem.first);
+            }
+            printTestResult("Chaining - Free List Reuse", Map.size() == 4096 && iterated == 4096);
+
+            ChainedHashMap<int, std::string> Moved = std::move(Map);
+            printTestResult("Chaining - Moved From Is Usable", Moved.size() == 4096 && !Map.contains(1) && Map.try_emplace(1, "1").second
+                            && Map.at(1) == "1");
+
+            ChainedHashMap<int, std::string> Self;
+            Self.insert(0, std::string(40, 'x'));
+            for (int i = 1; i < 100; ++i) {
+                Self.insert(i, Self.at(i - 1)); // the arg refers into the slab, which grows
+            }
+            printTestResult("Chaining - Self Referencing Insert", Self.size() == 100 && Self.at(99) == std::string(40, 'x'));
+        }
+
+        // Test 14: Batched Ops
+        {
+            printTestResult("Batched Ops - Open Addressing", batchedOpsWork<OpenAddrHashMap>());
+            printTestResult("Batched Ops - Control Bytes", batchedOpsWork<CtrlByteHashMap>());
+            printTestResult("Batched Ops - Robin Hood", batchedOpsWork<RobinHoodHashMap>());
+            printTestResult("Batched Ops - Incremental", batchedOpsWork<IncrementalHashMap>());
+            printTestResult("Batched Ops - Chaining", batchedOpsWork<ChainedHashMap>());
+            printTestResult("Batched Ops - Compact Dict", batchedOpsWork<OrderedHashMap>());
+        }
+
+        // Test 15: Stats
+        {
+#ifdef HASHMAP_STATS
+            printTestResult("Stats - Open Addressing", statsRecorded<OpenAddrHashMap<int, int>>(0.71));
+            printTestResult("Stats - Control Bytes", statsRecorded<CtrlByteHashMap<int, int>>(0.875));
+            printTestResult("Stats - Robin Hood", statsRecorded<RobinHoodHashMap<int, int>>(0.875));
+            printTestResult("Stats - Chaining", statsRecorded<ChainedHashMap<int, int>>(1.0));
+            printTestResult("Stats - Compact Dict", statsRecorded<OrderedHashMap<int, int>>(0.67));
+
+            // 64 buckets doubled 5 times for 1000 keys, half of them erased into tombstones
+            OpenAddrHashMap<int, int> Map;
+            for (int i = 0; i < 1000; ++i) {
+                Map.insert(i, i);
+            }
+            for (int i = 0; i < 1000; i += 2) {
+                Map.erase(i);
+            }
+            HashMapStats stats = Map.stats();
+            printTestResult("Stats - Rehashes & Tombstones", stats.rehashes == 5 && stats.tombstones == 500 && stats.tombstone_ratio == 500.0 / 2048);
+            printTestResult("Stats - JSON", stats.to_json().find("\"rehashes\": 5, ") != std::string::npos
+                            && stats.to_json().find("\"tombstones\": 500, ") != std::string::npos);
+
+            // a constant hash piles every key into 1 cluster
+            OpenAddrHashMap<int, int, ConstantHash> Colliding;
+            ChainedHashMap<int, int, ConstantHash> CollidingChains;
+            for (int i = 0; i < 40; ++i) {
+                Colliding.insert(i, i);
+                CollidingChains.insert(i, i);
+            }
+            printTestResult("Stats - Max Cluster Length", Colliding.stats().max_cluster_length == 40
+                            && CollidingChains.stats().max_cluster_length == 40 && Colliding.stats().hit_probes[HashMapStats::PROBE_BINS - 1] == 0
+                            && Colliding.stats().miss_probes[HashMapStats::PROBE_BINS - 1] == 40 - 14);
+
+            IncrementalHashMap<int, int> Incremental;
+            for (int i = 0; i < 1000; ++i) {
+                Incremental.insert(i, i);
+            }
+            printTestResult("Stats - Incremental", Incremental.stats().rehashes > 0 && Incremental.stats().max_cluster_length > 0);
+#else
+            // disabled: the recorder every imple holds takes no space
+            printTestResult("Stats - Disabled Recorder Is Empty", std::is_empty_v<StatsRecorder>);
+#endif
+        }
+
+        // Test 16: Tombstones & Compaction
+        {
+            // 20 keys in 64 buckets: churn fills the table w/ tombstones, purged in place
+            OpenAddrHashMap<int, int> Map;
+            for (int i = 0; i < 20; ++i) {
+                Map.insert(i, i);
+            }
+            bool bounded = true;
+            for (int i = 20; i < 5000; ++i) {
+                Map.erase(i - 20);
+                Map.insert(i, i);
+                if (Map.size() + Map.tombstones() > 45) bounded = false;
+            }
+            printTestResult("Tombstones - Churn Keeps The Buckets", Map.load_factor() == 20.0 / 64 && bounded);
+            for (int i = 4980; i < 4990; ++i) {
+                Map.erase(i);
+            }
+            size_t before = Map.tombstones();
+            Map.compact();
+            bool kept = true;
+            for (int i = 4990; i < 5000; ++i) {
+                if (Map.at(i) != i) kept = false;
+            }
+            printTestResult("Tombstones - Compact", before >= 10 && Map.tombstones() == 0 && Map.load_factor() == 10.0 / 64 && kept
+                            && !Map.contains(4980));
+
+            // every imple compacts, w/ or w/out tombstones
+            HashMap<int, int> Any;
+            for (int i = 0; i < 1000; ++i) {
+                Any.insert(i, i);
+            }
+            for (int i = 0; i < 1000; i += 2) {
+                Any.erase(i);
+            }
+            Any.compact();
+            printTestResult("Tombstones - Compact Keeps Keys", Any.tombstones() == 0 && Any.size() == 500 && Any.at(999) == 999 && !Any.contains(998));
+
+            printTestResult("Tombstones - Open Addressing Purges In Place", purgesInPlace<OpenAddrHashMap>());
+            printTestResult("Tombstones - Control Bytes Purge In Place", purgesInPlace<CtrlByteHashMap>());
+        }
+
+        // Test 17: Compact Dict
+        {
+            printTestResult("Compact Dict - Churn", churnMatchesReference<OrderedHashMap<int, int>>(1, 30000, 500));
+            printTestResult("Compact Dict - Large Churn", churnMatchesReference<OrderedHashMap<int, int>>(2, 60000, 20000));
+            printTestResult("Compact Dict - API", emplacingApiWorks<OrderedHashMap>() && heterogeneousLookupWorks<OrderedHashMap>());
+            printTestResult("Compact Dict - Custom Functors",
+                            customFunctorsWork<OrderedHashMap<std::string, int, CaseInsensitiveHash, CaseInsensitiveEqual>>());
+            printTestResult("Compact Dict - Colliding Hash", collidingKeysWork<OrderedHashMap<int, int, ConstantHash>>());
+
+            // iteration follows insertion: an overwrite keeps the position, an erase + insert moves the key to the end
+            OrderedHashMap<int, std::string> Map;
+            std::vector<int> order;
+            for (int i = 0; i < 1000; ++i) {
+                order.push_back(i * 7919 % 1000);
+                Map.insert(order.back(), std::to_string(order.back()));
+            }
+            Map.insert(order[0], "overwritten");
+            Map.erase(order[1]);
+            Map.insert(order[1], "moved");
+            order.push_back(order[1]);
+            order.erase(order.begin() + 1);
+            std::vector<int> iterated;
+            for (const auto& elem : Map) {
+                iterated.push_back(elem.first);
+            }
+            printTestResult("Compact Dict - Insertion Order", iterated == order && Map.at(order[0]) == "overwritten"
+                            && Map.at(order.back()) == "moved");
+
+            // slots as narrow as the capacity allows
+            OrderedHashMap<int, int> Small, Medium, Large;
+            for (int i = 0; i < 40000; ++i) {
+                if (i < 40) Small.insert(i, i);
+                if (i < 4000) Medium.insert(i, i);
+                Large.insert(i, i);
+            }
+            printTestResult("Compact Dict - Index Widths", Small.index_width() == 1 && Medium.index_width() == 2 && Large.index_width() == 4
+                            && Large.at(39999) == 39999);
+
+            // an erased key inserted again takes its DUMMY slot back, though its old entry stays dead
+            OrderedHashMap<int, int> Reuse;
+            for (int i = 0; i < 10; ++i) Reuse.insert(i, i);
+            for (int i = 0; i < 5; ++i) Reuse.erase(i);
+            size_t dummies = Reuse.tombstones();
+            for (int i = 0; i < 5; ++i) Reuse.insert(i, -i);
+            printTestResult("Compact Dict - DUMMY Slots Are Reused", dummies == 5 && Reuse.tombstones() == 0 && Reuse.size() == 10
+                            && Reuse.at(4) == -4 && Reuse.begin()->first == 5);
+
+            // keys inserted & erased in a sliding window: the dead entries are squeezed out w/out growing the table
+            OrderedHashMap<int, int> Window;
+            size_t capacity = 0;
+            for (int i = 0; i < 20000; ++i) {
+                Window.insert(i, i);
+                if (i >= 50) Window.erase(i - 50);
+                if (i == 1000) capacity = Window.capacity(); // sized for 3x the live keys by then
+            }
+            printTestResult("Compact Dict - Churn Keeps The Capacity", Window.size() == 50 && Window.capacity() == capacity
+                            && Window.tombstones() < capacity && Window.begin()->first == 19950);
+            Window.compact();
+            printTestResult("Compact Dict - Compact", Window.tombstones() == 0 && Window.capacity() == capacity
+                            && Window.begin()->first == 19950 && Window.at(19999) == 19999);
+
+            OrderedHashMap<int, std::string> Moved = std::move(Map);
+            printTestResult("Compact Dict - Moved From Is Usable", Moved.size() == 1000 && !Map.contains(1) && Map.try_emplace(1, "1").second
+                            && Map.at(1) == "1" && Map.begin()->second == "1");
+
+            OrderedHashMap<int, std::string> Self;
+            Self.insert(0, std::string(40, 'x'));
+            for (int i = 1; i < 100; ++i) {
+                Self.insert(i, Self.at(i - 1)); // the arg refers into the entries, which the rebuilds move
+            }
+            printTestResult("Compact Dict - Self Referencing Insert", Self.size() == 100 && Self.at(99) == std::string(40, 'x'));
+        }
+
         std::cout << "\nAll HashMap tests completed!" << std::endl;
 
     } catch (const std::exception& e) {
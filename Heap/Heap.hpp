@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 #include "./../Array/Array.hpp"
+#include "./../Array/ArraySIMD.hpp"
 
 /* 
 Heap is essentially a binary tree, but it's normally implemented as an array!
@@ -24,15 +25,20 @@ arr[(i-1)/2] (note that cpp int division auto floors)
 */
 
 // Min-heap
-template <typename T, typename Comparator = std::less<T>>
+// Alloc is handed to the underlying Array, e.g. std::pmr::polymorphic_allocator<T> for arena backed heaps (PmrHeap).
+template <typename T, typename Comparator = std::less<T>, typename Alloc = std::allocator<T>>
 class Heap
 {
 private:
-    Array<T> arr;
+    Array<T, Alloc> arr;
     Comparator comp;
 public:
+    using allocator_type = Alloc;
+
     Heap() = default;
     Heap(Comparator custom_comp) : arr(), comp(custom_comp)    {}
+    explicit Heap(const Alloc& alloc) : arr(alloc), comp()    {}
+    Heap(Comparator custom_comp, const Alloc& alloc) : arr(alloc), comp(custom_comp)    {}
     ~Heap() noexcept = default;
 
     Heap(Heap&& other) = default;
@@ -49,6 +55,7 @@ public:
 
     size_t size() const noexcept;
     bool empty() const noexcept;
+    allocator_type get_allocator() const  {return arr.get_allocator();}
 
     
     void heapifyUp(size_t idx); // restoring heap property after push
@@ -56,31 +63,37 @@ public:
 };
 
 
-template <typename T, typename Comparator>
-size_t Heap<T, Comparator>::find(const T& input)    {
-    for (auto it = arr.begin(); it != arr.end(); ++it)  {
-        if (*it == input) return std::distance(arr.begin(), it); 
+template <typename T, typename Comparator, typename Alloc>
+size_t Heap<T, Comparator, Alloc>::find(const T& input)    {
+    if constexpr (std::is_arithmetic_v<T>) {
+        // vectorized linear scan straight over the storage
+        size_t idx = simd_find(arr.data(), arr.size(), input);
+        if (idx != arr.size()) return idx;
+    } else {
+        for (auto it = arr.begin(); it != arr.end(); ++it)  {
+            if (*it == input) return std::distance(arr.begin(), it);
+        }
     }
     throw std::runtime_error("Value is not present.\n");
 }
 
 
-template <typename T, typename Comparator>
-T& Heap<T, Comparator>::at(size_t idx)    {
+template <typename T, typename Comparator, typename Alloc>
+T& Heap<T, Comparator, Alloc>::at(size_t idx)    {
     return arr[idx];
 }
 
 
-template <typename T, typename Comparator>
-void Heap<T, Comparator>::heapifyUp(size_t idx) {// restoring heap property after push 
+template <typename T, typename Comparator, typename Alloc>
+void Heap<T, Comparator, Alloc>::heapifyUp(size_t idx) {// restoring heap property after push 
     while (idx > 0 && comp(arr[idx], arr[(idx - 1) / 2]) /* i.e. !(arr[(idx - 1) / 2] <= arr[idx]) */) { // check > 0 or have issues when reaching the root
         std::swap(arr[idx], arr[(idx - 1) / 2]);
         idx = (idx - 1) / 2;
     }
 }
 
-template <typename T, typename Comparator>
-void Heap<T, Comparator>::heapifyDown(size_t idx) {// ... after pop
+template <typename T, typename Comparator, typename Alloc>
+void Heap<T, Comparator, Alloc>::heapifyDown(size_t idx) {// ... after pop
     size_t leftIdx, rightIdx, minIdx;
 
     while (1)  {
@@ -103,35 +116,39 @@ void Heap<T, Comparator>::heapifyDown(size_t idx) {// ... after pop
     }
 }
 
-template <typename T, typename Comparator>
-void Heap<T, Comparator>::push(const T& input)  {
+template <typename T, typename Comparator, typename Alloc>
+void Heap<T, Comparator, Alloc>::push(const T& input)  {
     arr.push_back(input);
     heapifyUp(arr.size()-1);
 }
 
-template <typename T, typename Comparator>
-const T& Heap<T, Comparator>::top()  {
+template <typename T, typename Comparator, typename Alloc>
+const T& Heap<T, Comparator, Alloc>::top()  {
     if (arr.empty()) throw std::runtime_error("Heap is empty, cannot top.");
     return arr[0]; // this cannot be const as the arr [] op is not marked const
 }
 
-template <typename T, typename Comparator>
-void Heap<T, Comparator>::pop() {
+template <typename T, typename Comparator, typename Alloc>
+void Heap<T, Comparator, Alloc>::pop() {
     if (arr.empty()) throw std::runtime_error("Heap is empty, cannot pop.");
     std::swap(arr[0], arr[arr.size()-1]);
-    arr.remove(arr.size()-1);
+    arr.pop_back(); // O(1), no shifting
     heapifyDown(0);
 }
 
-template <typename T, typename Comparator>
-size_t Heap<T, Comparator>::size() const noexcept {
+template <typename T, typename Comparator, typename Alloc>
+size_t Heap<T, Comparator, Alloc>::size() const noexcept {
     return arr.size();
 }
 
-template <typename T, typename Comparator>
-bool Heap<T, Comparator>::empty() const noexcept    {
+template <typename T, typename Comparator, typename Alloc>
+bool Heap<T, Comparator, Alloc>::empty() const noexcept    {
     return arr.empty();
 }
 
 
+template <typename T, typename Comparator = std::less<T>>
+using PmrHeap = Heap<T, Comparator, std::pmr::polymorphic_allocator<T>>;
+
+
 #endif // __HEAP_HEAP_HPP
\ No newline at end of file
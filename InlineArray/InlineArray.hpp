@@ -0,0 +1,317 @@
+#ifndef __INLINEARRAY_INLINEARRAY_HPP
+#define __INLINEARRAY_INLINEARRAY_HPP
+#include <stdexcept>
+#include <memory>
+#include <new>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "./../Array/Array.hpp" // for is_trivially_relocatable and the shared iterator
+
+/*
+InlineArray: Array w/ small buffer optimization (SBO)
+
+The first N elems live inside the object itself, so a default constructed InlineArray owns no heap mem at all.
+Only when it grows past N does it spill to the heap, from then on behaving exactly like Array (geometric growth).
+
+    InlineArray<int, 4> arr;        [ 1 | 2 | 3 | 4 ]  <- inline_buf_, arr_ points here
+    arr.push_back(5);               [ 1 | 2 | 3 | 4 | 5 | _ | _ | _ ]  <- heap, arr_ points here, inline_buf_ unused
+
+Trade-off: sizeof(InlineArray) grows by N * sizeof(T), and moving an inline InlineArray is O(N) instead of O(1),
+as the elems cannot be stolen by ptr. Hence only worth it for short-lived, tiny arrs.
+*/
+
+template <typename T, size_t N = 16>
+class InlineArray {
+    static_assert(N > 0, "InlineArray requires a nonzero inline capacity, use Array instead");
+public:
+    using iterator = typename Array<T>::iterator; // iter is a plain ptr wrapper, so the Array one fits as is
+    using const_iterator = typename Array<T>::const_iterator;
+
+    // Moving an inline InlineArray relocates its elems one by one, which copies them if moving T may throw
+    static constexpr bool NOTHROW_RELOCATE = std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>;
+
+    InlineArray(); // default constructor: empty w/ capacity N, no allocation
+    InlineArray(size_t count, const T& other = T()); // fill constructor
+    ~InlineArray();
+    InlineArray(const InlineArray& other); // copy constructor
+    InlineArray& operator=(const InlineArray& other); // copy assignment
+    InlineArray(InlineArray&& other) noexcept(NOTHROW_RELOCATE); // move constructor
+    InlineArray& operator=(InlineArray&& other) noexcept(NOTHROW_RELOCATE); // move assignment, *this is left empty if it throws
+
+    T& operator[](size_t index);
+    const T& operator[](size_t index) const;
+
+    void push_back(const T& input);
+    void push_back(T&& input);
+
+    void remove(size_t index); // rm elem @ idx, size--
+    void clear(); // destroys all elems, keeps capacity
+
+    size_t size() const   {return size_;}
+    size_t capacity() const   {return capacity_;}
+    bool empty() const  {return size_ == 0;}
+    bool is_inline() const  {return arr_ == inline_data();} // true while no heap mem is owned
+
+    void resize(size_t new_size, const T& filler = T());
+    void reserve(size_t new_capacity);
+
+    iterator begin()  {return iterator(arr_);}
+    iterator end()  {return iterator(arr_ + size_);}
+
+    const_iterator begin() const  {return const_iterator(arr_);}
+    const_iterator end() const  {return const_iterator(arr_ + size_);}
+
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+
+private:
+    alignas(T) unsigned char inline_buf_[N * sizeof(T)]; // raw storage, no T is constructed until pushed
+    T* arr_; // either inline_data() or a heap buffer
+    size_t size_;
+    size_t capacity_;
+
+    T* inline_data()  {return reinterpret_cast<T*>(inline_buf_);}
+    const T* inline_data() const  {return reinterpret_cast<const T*>(inline_buf_);}
+
+    static void relocate(T* dst, T* src, size_t n); // dst must be uninitialized; src is left uninitialized
+    static void destroy(T* first, T* last);
+
+    void release(); // destroys elems and frees the heap buffer if any, leaving raw storage behind
+    void steal(InlineArray& other) noexcept(NOTHROW_RELOCATE); // takes over other's elems, other is left empty & inline
+    void reallocate(size_t new_capacity);
+
+    template <typename... Args>
+    void emplace_back_realloc(Args&&... args);
+};
+
+
+template <typename T, size_t N>
+void InlineArray<T, N>::relocate(T* dst, T* src, size_t n)  {
+    if (n == 0) return;
+    if constexpr (is_trivially_relocatable_v<T>) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+    } else {
+        // a throwing copy leaves src intact: destroy whatever was built in dst, freeing dst is up to the caller
+        size_t i = 0;
+        try {
+            for (; i < n; ++i)  {
+                ::new (static_cast<void*>(dst + i)) T(std::move_if_noexcept(src[i]));
+            }
+        } catch (...) {
+            destroy(dst, dst + i);
+            throw;
+        }
+        destroy(src, src + n);
+    }
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::destroy(T* first, T* last)  {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (; first != last; ++first)  {
+            first->~T();
+        }
+    }
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::release()  {
+    destroy(arr_, arr_ + size_);
+    if (!is_inline()) std::allocator<T>().deallocate(arr_, capacity_);
+    arr_ = inline_data();
+    size_ = 0;
+    capacity_ = N;
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::steal(InlineArray& other) noexcept(NOTHROW_RELOCATE)  {
+    // Precondition: *this holds no elems and no heap buffer
+    if (other.is_inline()) {
+        // elems live inside other, so they have to be relocated one by one
+        relocate(inline_data(), other.arr_, other.size_);
+        arr_ = inline_data();
+        capacity_ = N;
+    } else {
+        arr_ = other.arr_; // heap buffer: transfer ownership as Array does
+        capacity_ = other.capacity_;
+    }
+    size_ = other.size_;
+    other.arr_ = other.inline_data();
+    other.size_ = 0;
+    other.capacity_ = N;
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::reallocate(size_t new_capacity)  {
+    // Precondition: new_capacity > N and new_capacity >= size_
+    T* temp = std::allocator<T>().allocate(new_capacity);
+    try {
+        relocate(temp, arr_, size_);
+    } catch (...) {
+        std::allocator<T>().deallocate(temp, new_capacity);
+        throw;
+    }
+    if (!is_inline()) std::allocator<T>().deallocate(arr_, capacity_);
+    arr_ = temp;
+    capacity_ = new_capacity;
+}
+
+
+template <typename T, size_t N>
+InlineArray<T, N>::InlineArray() : arr_(inline_data()), size_(0), capacity_(N) {}
+
+template <typename T, size_t N>
+InlineArray<T, N>::InlineArray(size_t count, const T& other) : InlineArray() {
+    reserve(count);
+    for (size_t i = 0; i < count; ++i)  {
+        push_back(other);
+    }
+}
+
+template <typename T, size_t N>
+InlineArray<T, N>::~InlineArray() {
+    release();
+}
+
+template <typename T, size_t N>
+InlineArray<T, N>::InlineArray(const InlineArray& other) : InlineArray() {
+    reserve(other.size_);
+    for (size_t i = 0; i < other.size_; ++i)  {
+        push_back(other[i]);
+    }
+}
+
+template <typename T, size_t N>
+InlineArray<T, N>& InlineArray<T, N>::operator=(const InlineArray& other)    {
+    if (this != &other) {
+        clear();
+        reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i)  {
+            push_back(other[i]);
+        }
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+InlineArray<T, N>::InlineArray(InlineArray&& other) noexcept(NOTHROW_RELOCATE) : InlineArray() {
+    steal(other);
+}
+
+template <typename T, size_t N>
+InlineArray<T, N>& InlineArray<T, N>::operator=(InlineArray&& other) noexcept(NOTHROW_RELOCATE)  {
+    if (this != &other) {
+        release();
+        steal(other);
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+T& InlineArray<T, N>::operator[](size_t index)   {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return arr_[index];
+}
+
+template <typename T, size_t N>
+const T& InlineArray<T, N>::operator[](size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return arr_[index];
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::push_back(const T& input)   {
+    emplace_back(input);
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::push_back(T&& input)   {
+    emplace_back(std::move(input));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+void InlineArray<T, N>::emplace_back(Args&&... args) {
+    if (capacity_ == size_) {
+        emplace_back_realloc(std::forward<Args>(args)...);
+        return;
+    }
+    ::new (static_cast<void*>(arr_ + size_)) T(std::forward<Args>(args)...);
+    size_++;
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+void InlineArray<T, N>::emplace_back_realloc(Args&&... args) {
+    // spill to (or grow on) the heap
+    size_t new_capacity = capacity_ * 2;
+    T* temp = std::allocator<T>().allocate(new_capacity);
+    try {
+        // Construct the new elem BEFORE relocating: args may refer to an elem of this arr
+        ::new (static_cast<void*>(temp + size_)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        std::allocator<T>().deallocate(temp, new_capacity);
+        throw;
+    }
+    try {
+        relocate(temp, arr_, size_);
+    } catch (...) {
+        temp[size_].~T();
+        std::allocator<T>().deallocate(temp, new_capacity);
+        throw;
+    }
+    if (!is_inline()) std::allocator<T>().deallocate(arr_, capacity_);
+    arr_ = temp;
+    capacity_ = new_capacity;
+    size_++;
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::remove(size_t index)   {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    if constexpr (is_trivially_relocatable_v<T>) {
+        arr_[index].~T();
+        std::memmove(static_cast<void*>(arr_ + index), static_cast<const void*>(arr_ + index + 1), (size_ - index - 1) * sizeof(T));
+    } else {
+        for (size_t i = index; i + 1 < size_; ++i)    {
+            arr_[i] = std::move(arr_[i + 1]);
+        }
+        arr_[size_ - 1].~T();
+    }
+    size_--;
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::clear()   {
+    destroy(arr_, arr_ + size_);
+    size_ = 0;
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::resize(size_t new_size, const T& filler)   {
+    if (new_size == size_) return;
+    if (new_size < size_) {
+        destroy(arr_ + new_size, arr_ + size_);
+        size_ = new_size;
+        return;
+    }
+    for (size_t i = size_; i < new_size; ++i)  {
+        push_back(filler);
+    }
+}
+
+template <typename T, size_t N>
+void InlineArray<T, N>::reserve(size_t new_capacity)   {
+    if (new_capacity <= capacity_) return;
+    reallocate(new_capacity);
+}
+
+
+#endif // __INLINEARRAY_INLINEARRAY_HPP
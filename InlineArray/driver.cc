@@ -0,0 +1,181 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include "InlineArray.hpp"
+
+void printTestResult(const std::string& testName, bool passed) {
+    std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+template<typename T, size_t N>
+bool verifyContents(const InlineArray<T, N>& arr, const std::vector<T>& expected) {
+    if (arr.size() != expected.size()) return false;
+    for (size_t i = 0; i < arr.size(); ++i) {
+        if (arr[i] != expected[i]) return false;
+    }
+    return true;
+}
+
+// A move that may throw, so relocation copies, and a copy that throws once copies_left runs out
+struct ThrowingCopy {
+    static int live;
+    static int copies_left;
+    std::string value; // heap allocated, so a leaked elem shows up under LeakSanitizer
+
+    ThrowingCopy(int v) : value(std::string(32, 'a') + std::to_string(v)) { ++live; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (copies_left-- == 0) throw std::runtime_error("copy");
+        ++live;
+    }
+    ThrowingCopy(ThrowingCopy&& other) : value(std::move(other.value)) { ++live; }
+    ~ThrowingCopy() { --live; }
+};
+int ThrowingCopy::live = 0;
+int ThrowingCopy::copies_left = -1; // never runs out
+
+int main() {
+    try {
+        // Test 1: Inline Storage
+        {
+            InlineArray<int, 4> arr;
+            printTestResult("Initial Empty Check", arr.empty());
+            printTestResult("Initial Capacity Is N", arr.capacity() == 4);
+            printTestResult("Initial Is Inline", arr.is_inline());
+
+            for (int i = 0; i < 4; ++i) {
+                arr.push_back(i);
+            }
+            printTestResult("Stays Inline Up To N", arr.is_inline() && arr.size() == 4);
+
+            arr.push_back(4);
+            printTestResult("Spills Past N", !arr.is_inline() && arr.capacity() >= 5);
+            printTestResult("Contents After Spill", verifyContents(arr, {0, 1, 2, 3, 4}));
+
+            bool exceptionThrown = false;
+            try {
+                arr[5];
+            } catch (const std::out_of_range&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Out of Bounds Exception", exceptionThrown);
+        }
+
+        // Test 2: Remove, Resize and Reserve
+        {
+            InlineArray<std::string, 4> arr;
+            arr.push_back("one");
+            arr.push_back("two");
+            arr.emplace_back(3, 'x');
+            arr.remove(1);
+            printTestResult("Remove Middle Element", verifyContents(arr, {"one", "xxx"}));
+
+            arr.resize(6, "fill");
+            printTestResult("Resize Larger", arr.size() == 6 && arr[5] == "fill" && !arr.is_inline());
+
+            arr.resize(1);
+            printTestResult("Resize Smaller", verifyContents(arr, {"one"}));
+
+            InlineArray<int, 8> small;
+            small.reserve(4);
+            printTestResult("Reserve Within N Stays Inline", small.is_inline() && small.capacity() == 8);
+            small.reserve(100);
+            printTestResult("Reserve Past N", !small.is_inline() && small.capacity() == 100);
+        }
+
+        // Test 3: Iterator Operations
+        {
+            InlineArray<int, 8> arr;
+            std::vector<int> values = {1, 2, 3, 4, 5};
+            for (int val : values) {
+                arr.push_back(val);
+            }
+            std::vector<int> traversed;
+            for (const auto& elem : arr) {
+                traversed.push_back(elem);
+            }
+            printTestResult("Iterator Traversal", values == traversed);
+            printTestResult("Iterator Arithmetic", *(arr.begin() + 2) == 3);
+        }
+
+        // Test 4: Copy and Move Operations (inline and spilled)
+        {
+            InlineArray<std::string, 2> inlineSrc;
+            inlineSrc.push_back("a");
+            inlineSrc.push_back("b");
+
+            InlineArray<std::string, 2> spilledSrc;
+            for (int i = 0; i < 5; ++i) {
+                spilledSrc.push_back(std::to_string(i));
+            }
+
+            InlineArray<std::string, 2> copied(inlineSrc);
+            printTestResult("Copy Constructor - Inline", verifyContents(copied, {"a", "b"}) && copied.is_inline());
+
+            InlineArray<std::string, 2> movedInline(std::move(inlineSrc));
+            printTestResult("Move Constructor - Inline", verifyContents(movedInline, {"a", "b"}) && inlineSrc.empty());
+
+            InlineArray<std::string, 2> movedSpilled(std::move(spilledSrc));
+            printTestResult("Move Constructor - Spilled", movedSpilled.size() == 5 && movedSpilled[4] == "4" && spilledSrc.empty() && spilledSrc.is_inline());
+
+            copied = movedSpilled;
+            printTestResult("Copy Assignment", copied.size() == 5 && copied[0] == "0");
+
+            movedSpilled = std::move(movedInline);
+            printTestResult("Move Assignment", verifyContents(movedSpilled, {"a", "b"}) && movedInline.empty());
+
+            // moved-from arrs are reusable
+            movedInline.push_back("c");
+            printTestResult("Moved-from Reuse", verifyContents(movedInline, {"c"}));
+        }
+
+        // Test 5: Throwing Relocation
+        {
+            static_assert(std::is_nothrow_move_constructible_v<InlineArray<std::string, 2>>);
+            static_assert(!std::is_nothrow_move_constructible_v<InlineArray<ThrowingCopy, 2>>);
+            {
+                InlineArray<ThrowingCopy, 4> arr;
+                for (int i = 0; i < 4; ++i) {
+                    arr.emplace_back(i);
+                }
+                bool intact = true;
+                auto relocationThrows = [&](auto&& op) { // the 3rd copy throws
+                    ThrowingCopy::copies_left = 2;
+                    try {
+                        op();
+                        intact = false;
+                    } catch (const std::runtime_error&) {}
+                    ThrowingCopy::copies_left = -1;
+                    intact = intact && arr.size() == 4 && arr.is_inline() && arr[3].value.back() == '3' && ThrowingCopy::live == 4;
+                };
+                relocationThrows([&] { arr.emplace_back(4); });
+                relocationThrows([&] { arr.reserve(16); });
+                relocationThrows([&] { InlineArray<ThrowingCopy, 4> moved(std::move(arr)); });
+                printTestResult("Throwing Relocation - Arr Intact", intact);
+            }
+            printTestResult("Throwing Relocation - Leaks Nothing", ThrowingCopy::live == 0);
+        }
+
+        // Test 6: Stress Test
+        {
+            InlineArray<int, 16> arr;
+            std::vector<int> reference;
+            for (int i = 0; i < 1000; ++i) {
+                arr.push_back(i);
+                reference.push_back(i);
+            }
+            for (int i = 0; i < 500; ++i) {
+                arr.remove(0);
+                reference.erase(reference.begin());
+            }
+            printTestResult("Stress Test - Insertions and Removals", verifyContents(arr, reference));
+        }
+
+        std::cout << "\nAll InlineArray tests completed!" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
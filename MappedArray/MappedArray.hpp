@@ -0,0 +1,423 @@
+#ifndef __MAPPEDARRAY_MAPPEDARRAY_HPP
+#define __MAPPEDARRAY_MAPPEDARRAY_HPP
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "./../Array/Array.hpp" // for the shared iterator
+
+/*
+MappedArray: Array whose elems live in a file, accessed through mmap
+
+Opening an existing file maps it and is done: no elem is read, copied or parsed until it is touched,
+and the pages are shared w/ the page cache (and every other process mapping the same file).
+Hence loading a large lookup table costs O(1) instead of a full deserialization pass.
+Checking the checksum reads every byte, so it is opt in: verify() after opening, or verify_checksum on open.
+
+File layout (native endianness, so files are only portable between machines of the same arch):
+
+    [ header (64 B) | elem 0 | elem 1 | ... | elem count-1 | (spare capacity while open for writing) ]
+
+    header: magic "MAPARRAY", format version, sizeof(T), count, checksum of the elem bytes
+
+The elems start at offset 64 (mmap returns page aligned mem), so any T w/ alignof(T) <= 64 is properly aligned.
+
+Modes:
+- ReadOnly:  PROT_READ mapping, the file is never modified. Writing through operator[] / iters faults (SIGSEGV).
+- ReadWrite: opens the file, or creates an empty one if missing. Grows geometrically through ftruncate + mremap.
+- Create:    as ReadWrite, but truncates an existing file to an empty arr.
+
+Durability: in the writable modes the header (count + checksum) is only brought up to date by flush() and close()
+(the destructor closes). A process dying in between leaves a file whose checksum does not match its elems,
+which verify() (or an open w/ verify_checksum) reports instead of silently loading half written data.
+close() also trims the spare capacity off the file, so a closed file is exactly header + count * sizeof(T) bytes.
+
+Growth invalidates ptrs, refs and iters (the mapping may move), just as reallocation does for Array.
+T must be trivially copyable, as elems are stored as raw bytes and never constructed or destroyed on open/close.
+*/
+
+struct MappedArrayHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t elem_size;
+    uint64_t count;
+    uint64_t checksum;
+};
+
+enum class MapMode { ReadOnly, ReadWrite, Create };
+
+template <typename T>
+class MappedArray {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedArray requires a trivially copyable T");
+    static_assert(alignof(T) <= 64, "MappedArray elems must not be over-aligned beyond the 64 B data offset");
+public:
+    using iterator = typename Array<T>::iterator; // iter is a plain ptr wrapper, so the Array one fits as is
+    using const_iterator = typename Array<T>::const_iterator;
+
+    static constexpr size_t HEADER_SIZE = 64; // data offset
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    // Throws std::runtime_error if the file cannot be opened / mapped, is not a MappedArray file,
+    // was written for another sizeof(T), is truncated, or (verify_checksum, O(n)) its checksum does not match
+    explicit MappedArray(const std::string& path, MapMode mode = MapMode::ReadOnly, bool verify_checksum = false);
+    ~MappedArray();
+    MappedArray(const MappedArray& other) = delete; // one mapping per object: copying a file is the caller's call
+    MappedArray& operator=(const MappedArray& other) = delete;
+    MappedArray(MappedArray&& other) noexcept;
+    MappedArray& operator=(MappedArray&& other) noexcept;
+
+    T& operator[](size_t index);
+    const T& operator[](size_t index) const;
+
+    T* data()  {return arr_;}
+    const T* data() const  {return arr_;}
+
+    void push_back(const T& input);
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+    void pop_back();
+    void clear()  {require_writable(); size_ = 0;}
+
+    size_t size() const   {return size_;}
+    size_t capacity() const   {return capacity_;}
+    bool empty() const  {return size_ == 0;}
+    bool writable() const  {return writable_;}
+    bool is_open() const  {return fd_ >= 0;}
+
+    void resize(size_t new_size, const T& filler = T());
+    void reserve(size_t new_capacity); // grows the file, never shrinks it
+
+    void flush(bool async = false); // writes count + checksum into the header, then msync (MS_ASYNC if async)
+    void close(); // flush (if writable), unmap, trim the spare capacity & close the file; a no-op if closed
+
+    uint64_t stored_checksum() const  {require_open(); return header()->checksum;} // as of the last flush / open
+    bool verify() const  {return stored_checksum() == checksum(arr_, size_ * sizeof(T));} // O(n): reads every elem
+    static uint64_t checksum(const void* bytes, size_t len);
+
+    iterator begin()  {return iterator(arr_);}
+    iterator end()  {return iterator(arr_ + size_);}
+
+    const_iterator begin() const  {return const_iterator(arr_);}
+    const_iterator end() const  {return const_iterator(arr_ + size_);}
+
+private:
+    int fd_;
+    unsigned char* base_; // start of the mapping, i.e. the header
+    size_t mapped_bytes_;
+    T* arr_; // base_ + HEADER_SIZE
+    size_t size_;
+    size_t capacity_;
+    bool writable_;
+
+    MappedArrayHeader* header()  {return reinterpret_cast<MappedArrayHeader*>(base_);}
+    const MappedArrayHeader* header() const  {return reinterpret_cast<const MappedArrayHeader*>(base_);}
+    static size_t file_bytes(size_t count)  {return HEADER_SIZE + count * sizeof(T);}
+
+    [[noreturn]] static void throw_errno(const std::string& what);
+    void require_writable() const;
+    void require_open() const;
+    void map(size_t bytes);
+    void remap(size_t new_capacity); // resizes the file and the mapping
+    void unmap() noexcept;
+    void init_header();
+    void load_header(bool verify_checksum, size_t file_size);
+    void steal(MappedArray& other) noexcept; // takes over other's mapping, other is left closed
+};
+
+
+template <typename T>
+void MappedArray<T>::throw_errno(const std::string& what)  {
+    throw std::runtime_error("MappedArray: " + what + ": " + std::strerror(errno));
+}
+
+template <typename T>
+void MappedArray<T>::require_writable() const  {
+    if (!writable_) {
+        throw std::logic_error("MappedArray is read only");
+    }
+}
+
+template <typename T>
+void MappedArray<T>::require_open() const  {
+    if (!base_) {
+        throw std::logic_error("MappedArray is closed");
+    }
+}
+
+template <typename T>
+uint64_t MappedArray<T>::checksum(const void* bytes, size_t len)  {
+    // FNV-1a style, but folding a whole 8 B word per multiply (8x fewer multiplies than bytewise FNV-1a)
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    uint64_t hash = 0xcbf29ce484222325ULL ^ len;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)  {
+        uint64_t word;
+        std::memcpy(&word, p + i, 8);
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+    if (i < len) {
+        uint64_t word = 0;
+        std::memcpy(&word, p + i, len - i);
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+template <typename T>
+void MappedArray<T>::map(size_t bytes)  {
+    int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* addr = ::mmap(nullptr, bytes, prot, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED) throw_errno("mmap");
+    base_ = static_cast<unsigned char*>(addr);
+    mapped_bytes_ = bytes;
+    arr_ = reinterpret_cast<T*>(base_ + HEADER_SIZE);
+}
+
+template <typename T>
+void MappedArray<T>::remap(size_t new_capacity)  {
+    size_t bytes = file_bytes(new_capacity);
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) throw_errno("ftruncate");
+#ifdef MREMAP_MAYMOVE
+    // Linux: extend in place if the address range allows, else let the kernel move the mapping (no copying either way)
+    void* addr = ::mremap(base_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+    if (addr == MAP_FAILED) throw_errno("mremap");
+    base_ = static_cast<unsigned char*>(addr);
+    mapped_bytes_ = bytes;
+    arr_ = reinterpret_cast<T*>(base_ + HEADER_SIZE);
+#else
+    unmap();
+    map(bytes);
+#endif
+    capacity_ = new_capacity;
+}
+
+template <typename T>
+void MappedArray<T>::unmap() noexcept  {
+    if (base_) ::munmap(base_, mapped_bytes_);
+    base_ = nullptr;
+    arr_ = nullptr;
+    mapped_bytes_ = 0;
+}
+
+template <typename T>
+void MappedArray<T>::init_header()  {
+    MappedArrayHeader* h = header();
+    std::memset(static_cast<void*>(base_), 0, HEADER_SIZE);
+    std::memcpy(h->magic, "MAPARRAY", 8);
+    h->version = FORMAT_VERSION;
+    h->elem_size = static_cast<uint32_t>(sizeof(T));
+    h->count = 0;
+    h->checksum = checksum(nullptr, 0);
+}
+
+template <typename T>
+void MappedArray<T>::load_header(bool verify_checksum, size_t file_size)  {
+    const MappedArrayHeader* h = header();
+    if (std::memcmp(h->magic, "MAPARRAY", 8) != 0) {
+        throw std::runtime_error("MappedArray: not a MappedArray file");
+    }
+    if (h->version != FORMAT_VERSION) {
+        throw std::runtime_error("MappedArray: unsupported format version " + std::to_string(h->version));
+    }
+    if (h->elem_size != sizeof(T)) {
+        throw std::runtime_error("MappedArray: element size mismatch (file " + std::to_string(h->elem_size)
+                                 + " B, expected " + std::to_string(sizeof(T)) + " B)");
+    }
+    capacity_ = (file_size - HEADER_SIZE) / sizeof(T);
+    if (h->count > capacity_) {
+        throw std::runtime_error("MappedArray: file is truncated");
+    }
+    size_ = static_cast<size_t>(h->count);
+    if (verify_checksum && !verify()) {
+        throw std::runtime_error("MappedArray: checksum mismatch");
+    }
+}
+
+template <typename T>
+void MappedArray<T>::steal(MappedArray& other) noexcept  {
+    fd_ = other.fd_;
+    base_ = other.base_;
+    mapped_bytes_ = other.mapped_bytes_;
+    arr_ = other.arr_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    writable_ = other.writable_;
+    other.fd_ = -1;
+    other.base_ = nullptr;
+    other.mapped_bytes_ = 0;
+    other.arr_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+}
+
+
+template <typename T>
+MappedArray<T>::MappedArray(const std::string& path, MapMode mode, bool verify_checksum)
+    : fd_(-1), base_(nullptr), mapped_bytes_(0), arr_(nullptr), size_(0), capacity_(0), writable_(mode != MapMode::ReadOnly) {
+    int flags = O_CLOEXEC;
+    if (mode == MapMode::ReadOnly) flags |= O_RDONLY;
+    else flags |= O_RDWR | O_CREAT | (mode == MapMode::Create ? O_TRUNC : 0);
+
+    fd_ = ::open(path.c_str(), flags, 0644);
+    if (fd_ < 0) throw_errno("open " + path);
+
+    try {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) throw_errno("fstat " + path);
+        size_t file_size = static_cast<size_t>(st.st_size);
+
+        if (file_size == 0 && writable_) { // fresh file: header + room for 1 elem, as an empty Array has
+            if (::ftruncate(fd_, static_cast<off_t>(file_bytes(1))) != 0) throw_errno("ftruncate " + path);
+            map(file_bytes(1));
+            init_header();
+            capacity_ = 1;
+        } else {
+            if (file_size < HEADER_SIZE) {
+                throw std::runtime_error("MappedArray: " + path + " is too small to hold a header");
+            }
+            map(file_size);
+            load_header(verify_checksum, file_size);
+        }
+    } catch (...) {
+        unmap();
+        ::close(fd_);
+        fd_ = -1;
+        throw;
+    }
+}
+
+template <typename T>
+MappedArray<T>::~MappedArray()  {
+    try {
+        close();
+    } catch (...) {
+        // a destructor must not throw: the stale checksum tells the next open about the failed flush
+        unmap();
+        if (fd_ >= 0) ::close(fd_);
+    }
+}
+
+template <typename T>
+MappedArray<T>::MappedArray(MappedArray&& other) noexcept  {
+    steal(other);
+}
+
+template <typename T>
+MappedArray<T>& MappedArray<T>::operator=(MappedArray&& other) noexcept  {
+    if (this != &other) {
+        try {
+            close();
+        } catch (...) {
+            unmap();
+            if (fd_ >= 0) ::close(fd_);
+        }
+        steal(other);
+    }
+    return *this;
+}
+
+template <typename T>
+T& MappedArray<T>::operator[](size_t index)   {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return arr_[index];
+}
+
+template <typename T>
+const T& MappedArray<T>::operator[](size_t index) const   {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return arr_[index];
+}
+
+template <typename T>
+void MappedArray<T>::push_back(const T& input)  {
+    emplace_back(input);
+}
+
+template <typename T>
+template <typename... Args>
+void MappedArray<T>::emplace_back(Args&&... args)  {
+    require_writable();
+    T value(std::forward<Args>(args)...); // built before growing: args may refer into the mapping, which may move
+    if (size_ == capacity_) {
+        remap(capacity_ ? capacity_ * 2 : 1);
+    }
+    ::new (static_cast<void*>(arr_ + size_)) T(value);
+    ++size_;
+}
+
+template <typename T>
+void MappedArray<T>::pop_back()  {
+    require_writable();
+    if (size_ == 0) {
+        throw std::out_of_range("Array is empty");
+    }
+    --size_;
+}
+
+template <typename T>
+void MappedArray<T>::resize(size_t new_size, const T& filler)  {
+    require_writable();
+    if (new_size > capacity_) {
+        T value = filler; // filler may refer into the mapping
+        remap(std::max(new_size, capacity_ * 2));
+        for (size_t i = size_; i < new_size; ++i)  {
+            ::new (static_cast<void*>(arr_ + i)) T(value);
+        }
+    } else {
+        for (size_t i = size_; i < new_size; ++i)  {
+            ::new (static_cast<void*>(arr_ + i)) T(filler);
+        }
+    }
+    size_ = new_size;
+}
+
+template <typename T>
+void MappedArray<T>::reserve(size_t new_capacity)  {
+    require_writable();
+    if (new_capacity > capacity_) {
+        remap(new_capacity);
+    }
+}
+
+template <typename T>
+void MappedArray<T>::flush(bool async)  {
+    require_writable();
+    MappedArrayHeader* h = header();
+    h->count = size_;
+    h->checksum = checksum(arr_, size_ * sizeof(T));
+    if (::msync(base_, file_bytes(size_), async ? MS_ASYNC : MS_SYNC) != 0) throw_errno("msync");
+}
+
+template <typename T>
+void MappedArray<T>::close()  {
+    if (fd_ < 0) return;
+    if (writable_) {
+        flush();
+        unmap();
+        if (::ftruncate(fd_, static_cast<off_t>(file_bytes(size_))) != 0) throw_errno("ftruncate");
+    } else {
+        unmap();
+    }
+    ::close(fd_);
+    fd_ = -1;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+
+#endif // __MAPPEDARRAY_MAPPEDARRAY_HPP
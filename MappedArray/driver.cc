@@ -0,0 +1,196 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include "MappedArray.hpp"
+
+void printTestResult(const std::string& testName, bool passed) {
+    std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+template<typename T>
+bool verifyContents(const MappedArray<T>& arr, const std::vector<T>& expected) {
+    if (arr.size() != expected.size()) return false;
+    for (size_t i = 0; i < arr.size(); ++i) {
+        if (arr[i] != expected[i]) return false;
+    }
+    return true;
+}
+
+struct Point {
+    int32_t x;
+    int32_t y;
+    bool operator==(const Point& other) const { return x == other.x && y == other.y; }
+};
+
+template<typename F>
+bool throwsRuntimeError(F f) {
+    try {
+        f();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    const std::string path = (std::filesystem::temp_directory_path() / "mappedarray_driver.bin").string();
+    const std::string otherPath = (std::filesystem::temp_directory_path() / "mappedarray_driver_other.bin").string();
+
+    try {
+        // Test 1: Create And Grow
+        {
+            MappedArray<int> arr(path, MapMode::Create);
+            printTestResult("Create - Empty", arr.empty() && arr.writable());
+            printTestResult("Create - Initial Capacity", arr.capacity() == 1);
+
+            for (int i = 0; i < 1000; ++i) {
+                arr.push_back(i * 3);
+            }
+            printTestResult("Grow - Size", arr.size() == 1000);
+            printTestResult("Grow - Geometric Capacity", arr.capacity() == 1024);
+
+            bool allCorrect = true;
+            for (int i = 0; i < 1000; ++i) {
+                if (arr[i] != i * 3) allCorrect = false;
+            }
+            printTestResult("Grow - Contents", allCorrect);
+
+            bool exceptionThrown = false;
+            try {
+                arr[1000];
+            } catch (const std::out_of_range&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Out Of Bounds Throws", exceptionThrown);
+        }
+        printTestResult("Close - Trims Spare Capacity",
+                        std::filesystem::file_size(path) == MappedArray<int>::HEADER_SIZE + 1000 * sizeof(int));
+
+        // Test 2: Read Only Reopen
+        {
+            MappedArray<int> arr(path);
+            printTestResult("Reopen - Read Only", !arr.writable());
+            printTestResult("Reopen - Size", arr.size() == 1000);
+            printTestResult("Reopen - Checksum Verifies", arr.verify());
+
+            int sum = 0;
+            for (int value : arr) {
+                sum += value;
+            }
+            printTestResult("Reopen - Range For", sum == 3 * 999 * 1000 / 2);
+            printTestResult("Reopen - std::find", std::find(arr.begin(), arr.end(), 300) - arr.begin() == 100);
+
+            bool exceptionThrown = false;
+            try {
+                arr.push_back(1);
+            } catch (const std::logic_error&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Read Only - Mutation Throws", exceptionThrown);
+        }
+
+        // Test 3: Read Write Reopen Appends
+        {
+            MappedArray<int> arr(path, MapMode::ReadWrite);
+            arr.pop_back();
+            arr.resize(1002, -1);
+            arr[0] = 42;
+            arr.flush();
+            printTestResult("Flush - Checksum Current", arr.verify());
+            arr[1] = 43;
+            printTestResult("Unflushed Write - Checksum Stale", !arr.verify());
+        }
+        {
+            const MappedArray<int> arr(path);
+            printTestResult("Read Write - Persisted", arr.size() == 1002 && arr[0] == 42 && arr[1] == 43
+                            && arr[998] == 998 * 3 && arr[999] == -1 && arr[1001] == -1);
+        }
+
+        // Test 4: Struct Elems
+        {
+            MappedArray<Point> points(otherPath, MapMode::Create);
+            points.emplace_back(Point{1, 2});
+            points.push_back({3, 4});
+            points.push_back(points[0]); // aliasing push_back across a remap
+        }
+        {
+            MappedArray<Point> points(otherPath);
+            printTestResult("Struct Elems", verifyContents(points, {{1, 2}, {3, 4}, {1, 2}}));
+        }
+
+        // Test 5: Header Validation
+        {
+            printTestResult("Elem Size Mismatch Throws", throwsRuntimeError([&] { MappedArray<int64_t> wrong(path); }));
+            printTestResult("Missing File Throws", throwsRuntimeError([&] { MappedArray<int> missing(path + ".missing"); }));
+
+            // corrupt one data byte behind the header's back
+            {
+                std::FILE* f = std::fopen(path.c_str(), "r+b");
+                std::fseek(f, MappedArray<int>::HEADER_SIZE + 10 * sizeof(int), SEEK_SET);
+                std::fputc(0x7f, f);
+                std::fclose(f);
+            }
+            printTestResult("Corruption Detected", throwsRuntimeError([&] { MappedArray<int> corrupt(path, MapMode::ReadOnly, true); }));
+
+            MappedArray<int> unchecked(path); // the default open reads no elem
+            printTestResult("Default Open Skips Checksum", unchecked.size() == 1002 && !unchecked.verify());
+
+            {
+                std::FILE* f = std::fopen(otherPath.c_str(), "wb");
+                std::fputs("definitely not a mapped array, just some text that is long enough for a header......", f);
+                std::fclose(f);
+            }
+            printTestResult("Bad Magic Throws", throwsRuntimeError([&] { MappedArray<int> bad(otherPath); }));
+        }
+
+        // Test 6: Move
+        {
+            MappedArray<int> a(path, MapMode::Create);
+            a.push_back(7);
+            MappedArray<int> b(std::move(a));
+            printTestResult("Move - Source Closed", !a.is_open() && a.size() == 0);
+            b.push_back(8);
+            a = std::move(b);
+            printTestResult("Move Assignment", a.is_open() && verifyContents(a, {7, 8}));
+            a.close();
+            printTestResult("Explicit Close", !a.is_open());
+            bool exceptionThrown = false;
+            try {
+                a.verify(); // no header left to read
+            } catch (const std::logic_error&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Closed - Checksum Throws", exceptionThrown);
+
+            MappedArray<int> reopened(path);
+            printTestResult("Close - Persisted", verifyContents(reopened, {7, 8}));
+        }
+
+        // Test 7: Reserve And Clear
+        {
+            MappedArray<double> arr(otherPath, MapMode::Create);
+            arr.reserve(500);
+            printTestResult("Reserve", arr.capacity() == 500 && arr.empty());
+            arr.resize(10, 1.5);
+            arr.clear();
+            printTestResult("Clear", arr.empty() && arr.capacity() == 500);
+        }
+        printTestResult("Empty File Round Trip", MappedArray<double>(otherPath).empty());
+
+        std::cout << "\nAll MappedArray tests completed!" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        std::remove(path.c_str());
+        std::remove(otherPath.c_str());
+        return 1;
+    }
+
+    std::remove(path.c_str());
+    std::remove(otherPath.c_str());
+    return 0;
+}
@@ -0,0 +1,210 @@
+#ifndef __MEMORYRESOURCE_MEMORYRESOURCE_HPP
+#define __MEMORYRESOURCE_MEMORYRESOURCE_HPP
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+/*
+std::pmr::memory_resource imples to plug into Array/HashMap/Heap through std::pmr::polymorphic_allocator.
+
+- MonotonicArena: bump ptr allocation, deallocate is a no-op, everything is freed at once by release() or destruction.
+  Ideal for request-scoped containers: build, use, drop the whole arena.
+- SizeClassPool: segregated free lists for power-of-2 size classes. Freed blocks are recycled for same-class requests,
+  so containers that grow & shrink repeatedly stop hitting the upstream allocator. Oversized requests go upstream directly.
+
+Both obtain their chunks from an upstream resource (default: new/delete) and are NOT thread safe,
+i.e. one arena per thread/request.
+
+Usage:
+    MonotonicArena arena;
+    PmrArray<int> arr(&arena); // polymorphic_allocator is implicitly constructible from memory_resource*
+    ...
+    arena.release(); // or let it go out of scope; arr must not be used afterwards
+*/
+
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    explicit MonotonicArena(size_t initial_chunk_size = 1024, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    MonotonicArena(void* buffer, size_t buffer_size, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()); // uses buffer first, e.g. a stack arr
+    ~MonotonicArena() override  {release();}
+
+    MonotonicArena(const MonotonicArena&) = delete; // blocks handed out refer to this very arena
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void release(); // frees every chunk at once, all blocks handed out become invalid
+    size_t bytes_allocated() const  {return bytes_allocated_;} // sum of the sizes requested since last release
+
+private:
+    struct Chunk  { // header placed at the front of each upstream chunk, forming a singly linked list
+        Chunk* next;
+        size_t size; // incl. header
+    };
+
+    std::pmr::memory_resource* upstream_;
+    Chunk* chunks_ = nullptr;
+    unsigned char* cur_ = nullptr; // bump ptr
+    unsigned char* end_ = nullptr;
+    void* initial_buffer_ = nullptr;
+    size_t initial_buffer_size_ = 0;
+    size_t next_chunk_size_;
+    size_t bytes_allocated_ = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override  {} // monotonic: mem is only reclaimed by release()
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override  {return this == &other;}
+};
+
+
+class SizeClassPool : public std::pmr::memory_resource {
+public:
+    static constexpr size_t MIN_BLOCK = 8;
+    static constexpr size_t NUM_CLASSES = 10; // 8, 16, ..., 4096 bytes
+    static constexpr size_t MAX_BLOCK = MIN_BLOCK << (NUM_CLASSES - 1);
+
+    explicit SizeClassPool(size_t chunk_size = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~SizeClassPool() override  {release();}
+
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    void release(); // returns every chunk to upstream, incl. blocks still in use
+
+private:
+    struct FreeBlock  { // intrusive free list node, lives inside the freed block itself
+        FreeBlock* next;
+    };
+    struct Chunk  {
+        Chunk* next;
+        size_t size;
+    };
+
+    std::pmr::memory_resource* upstream_;
+    size_t chunk_size_;
+    Chunk* chunks_ = nullptr;
+    unsigned char* cur_ = nullptr; // carving position in the newest chunk
+    unsigned char* end_ = nullptr;
+    FreeBlock* free_lists_[NUM_CLASSES] = {};
+
+    static size_t class_of(size_t bytes); // index of the smallest class fitting bytes
+    void* carve(size_t block_size);
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override  {return this == &other;}
+};
+
+
+// Round ptr up to a multiple of alignment (a power of 2)
+inline unsigned char* align_up(unsigned char* ptr, size_t alignment)  {
+    auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+    return reinterpret_cast<unsigned char*>((addr + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+}
+
+
+inline MonotonicArena::MonotonicArena(size_t initial_chunk_size, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), next_chunk_size_(initial_chunk_size ? initial_chunk_size : 1024) {}
+
+inline MonotonicArena::MonotonicArena(void* buffer, size_t buffer_size, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), cur_(static_cast<unsigned char*>(buffer)), end_(static_cast<unsigned char*>(buffer) + buffer_size),
+      initial_buffer_(buffer), initial_buffer_size_(buffer_size), next_chunk_size_(buffer_size ? buffer_size * 2 : 1024) {}
+
+inline void MonotonicArena::release()  {
+    while (chunks_) {
+        Chunk* next = chunks_->next;
+        upstream_->deallocate(chunks_, chunks_->size, alignof(std::max_align_t));
+        chunks_ = next;
+    }
+    // rewind to the user buffer if any
+    cur_ = static_cast<unsigned char*>(initial_buffer_);
+    end_ = cur_ ? cur_ + initial_buffer_size_ : nullptr;
+    bytes_allocated_ = 0;
+}
+
+inline void* MonotonicArena::do_allocate(size_t bytes, size_t alignment)  {
+    unsigned char* ptr = cur_ ? align_up(cur_, alignment) : nullptr;
+    if (!ptr || ptr + bytes > end_) {
+        // current chunk exhausted: get a new one, geometrically larger so the number of chunks stays O(log n)
+        size_t needed = sizeof(Chunk) + bytes + alignment;
+        while (next_chunk_size_ < needed) next_chunk_size_ *= 2;
+        auto chunk = static_cast<Chunk*>(upstream_->allocate(next_chunk_size_, alignof(std::max_align_t)));
+        chunk->next = chunks_;
+        chunk->size = next_chunk_size_;
+        chunks_ = chunk;
+        cur_ = reinterpret_cast<unsigned char*>(chunk + 1);
+        end_ = reinterpret_cast<unsigned char*>(chunk) + next_chunk_size_;
+        next_chunk_size_ *= 2;
+        ptr = align_up(cur_, alignment);
+    }
+    cur_ = ptr + bytes;
+    bytes_allocated_ += bytes;
+    return ptr;
+}
+
+
+inline SizeClassPool::SizeClassPool(size_t chunk_size, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), chunk_size_(chunk_size < 2 * MAX_BLOCK ? 2 * MAX_BLOCK : chunk_size) {}
+
+inline void SizeClassPool::release()  {
+    while (chunks_) {
+        Chunk* next = chunks_->next;
+        upstream_->deallocate(chunks_, chunks_->size, alignof(std::max_align_t));
+        chunks_ = next;
+    }
+    cur_ = end_ = nullptr;
+    for (auto& head : free_lists_) head = nullptr;
+}
+
+inline size_t SizeClassPool::class_of(size_t bytes)  {
+    size_t idx = 0;
+    size_t block = MIN_BLOCK;
+    while (block < bytes) {
+        block <<= 1;
+        ++idx;
+    }
+    return idx;
+}
+
+inline void* SizeClassPool::carve(size_t block_size)  {
+    // blocks are carved at multiples of their own size from a max_align_t aligned base,
+    // hence a block of class 2^k is aligned to min(2^k, chunk alignment)
+    unsigned char* ptr = cur_ ? align_up(cur_, block_size) : nullptr;
+    if (!ptr || ptr + block_size > end_) {
+        auto chunk = static_cast<Chunk*>(upstream_->allocate(chunk_size_, alignof(std::max_align_t)));
+        chunk->next = chunks_;
+        chunk->size = chunk_size_;
+        chunks_ = chunk;
+        cur_ = reinterpret_cast<unsigned char*>(chunk + 1);
+        end_ = reinterpret_cast<unsigned char*>(chunk) + chunk_size_;
+        ptr = align_up(cur_, block_size);
+    }
+    cur_ = ptr + block_size;
+    return ptr;
+}
+
+inline void* SizeClassPool::do_allocate(size_t bytes, size_t alignment)  {
+    size_t request = bytes > alignment ? bytes : alignment; // a block of size >= alignment is aligned enough, see carve()
+    if (request > MAX_BLOCK) return upstream_->allocate(bytes, alignment);
+
+    size_t idx = class_of(request);
+    if (FreeBlock* head = free_lists_[idx]) { // recycle
+        free_lists_[idx] = head->next;
+        return head;
+    }
+    return carve(MIN_BLOCK << idx);
+}
+
+inline void SizeClassPool::do_deallocate(void* ptr, size_t bytes, size_t alignment)  {
+    size_t request = bytes > alignment ? bytes : alignment;
+    if (request > MAX_BLOCK) {
+        upstream_->deallocate(ptr, bytes, alignment);
+        return;
+    }
+    // push onto the class free list, the block itself stores the link
+    size_t idx = class_of(request);
+    auto block = ::new (ptr) FreeBlock{free_lists_[idx]};
+    free_lists_[idx] = block;
+}
+
+
+#endif // __MEMORYRESOURCE_MEMORYRESOURCE_HPP
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "MemoryResource.hpp"
+#include "./../Array/Array.hpp"
+#include "./../HashMap/HashMap.hpp"
+#include "./../Heap/Heap.hpp"
+
+void printTestResult(const std::string& testName, bool passed) {
+    std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+// Upstream that counts outstanding bytes, to verify resources give everything back
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t outstanding = 0;
+    size_t calls = 0;
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        outstanding += bytes;
+        ++calls;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+int main() {
+    try {
+        // Test 1: MonotonicArena
+        {
+            CountingResource upstream;
+            {
+                MonotonicArena arena(256, &upstream);
+                void* a = arena.allocate(10, 1);
+                void* b = arena.allocate(32, 32);
+                printTestResult("Arena - Distinct Blocks", a != b);
+                printTestResult("Arena - Alignment", reinterpret_cast<std::uintptr_t>(b) % 32 == 0);
+
+                void* big = arena.allocate(10000, 8);
+                printTestResult("Arena - Oversized Request", big != nullptr && arena.bytes_allocated() == 10042);
+
+                arena.release();
+                printTestResult("Arena - Release Frees Upstream", upstream.outstanding == 0);
+                (void)arena.allocate(64, 8);
+            }
+            printTestResult("Arena - Destructor Frees Upstream", upstream.outstanding == 0);
+
+            alignas(std::max_align_t) unsigned char buffer[1024];
+            CountingResource untouched;
+            MonotonicArena stackArena(buffer, sizeof(buffer), &untouched);
+            (void)stackArena.allocate(512, 8);
+            printTestResult("Arena - Initial Buffer Used First", untouched.calls == 0);
+        }
+
+        // Test 2: SizeClassPool
+        {
+            CountingResource upstream;
+            {
+                SizeClassPool pool(4096 * 4, &upstream);
+                void* a = pool.allocate(24, 8);
+                pool.deallocate(a, 24, 8);
+                void* b = pool.allocate(30, 8); // same 32 byte class
+                printTestResult("Pool - Block Recycled", a == b);
+
+                void* aligned = pool.allocate(64, 64);
+                printTestResult("Pool - Alignment", reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+
+                size_t callsBefore = upstream.calls;
+                for (int i = 0; i < 100; ++i) {
+                    void* p = pool.allocate(100, 8);
+                    pool.deallocate(p, 100, 8);
+                }
+                printTestResult("Pool - No Upstream Traffic On Churn", upstream.calls == callsBefore);
+
+                void* huge = pool.allocate(SizeClassPool::MAX_BLOCK + 1, 8);
+                pool.deallocate(huge, SizeClassPool::MAX_BLOCK + 1, 8);
+            }
+            printTestResult("Pool - Destructor Frees Upstream", upstream.outstanding == 0);
+        }
+
+        // Test 3: Containers on an arena
+        {
+            CountingResource upstream;
+            {
+                MonotonicArena arena(1024, &upstream);
+
+                PmrArray<std::string> arr(&arena);
+                for (int i = 0; i < 100; ++i) {
+                    arr.push_back(std::to_string(i));
+                }
+                printTestResult("PmrArray - Contents", arr.size() == 100 && arr[99] == "99");
+                printTestResult("PmrArray - Uses Arena", arr.get_allocator().resource() == &arena && arena.bytes_allocated() > 0);
+
+                PmrArray<std::string> copied(arr);
+                printTestResult("PmrArray - Copy", copied.size() == 100 && copied[50] == "50");
+
+                PmrHashMap<int, int> map(&arena);
+                for (int i = 0; i < 1000; ++i) {
+                    map.insert(i, i * 2);
+                }
+                bool allFound = true;
+                for (int i = 0; i < 1000; ++i) {
+                    if (!map.contains(i) || map.at(i) != i * 2) allFound = false;
+                }
+                printTestResult("PmrHashMap - Rehash On Arena", allFound && map.get_allocator().resource() == &arena);
+
+                PmrHeap<int> heap(&arena);
+                for (int i = 100; i > 0; --i) {
+                    heap.push(i);
+                }
+                printTestResult("PmrHeap - Top", heap.top() == 1);
+                heap.pop();
+                printTestResult("PmrHeap - Pop", heap.top() == 2 && heap.size() == 99);
+
+                // Move between arrs on different arenas falls back to elementwise moves
+                MonotonicArena other(1024, &upstream);
+                PmrArray<std::string> foreign(&other);
+                foreign = std::move(copied);
+                printTestResult("PmrArray - Move Across Resources", foreign.size() == 100 && foreign[1] == "1" && foreign.get_allocator().resource() == &other);
+            }
+            printTestResult("Containers - Arena Freed All", upstream.outstanding == 0);
+        }
+
+        // Test 4: Containers on a pool
+        {
+            SizeClassPool pool;
+            PmrArray<int> arr(&pool);
+            for (int i = 0; i < 500; ++i) {
+                arr.push_back(i); // grows through several classes, then upstream
+            }
+            bool ok = true;
+            for (int i = 0; i < 500; ++i) {
+                if (arr[i] != i) ok = false;
+            }
+            printTestResult("PmrArray On Pool - Contents", ok);
+        }
+
+        std::cout << "\nAll MemoryResource tests completed!" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
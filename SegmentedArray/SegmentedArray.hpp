@@ -0,0 +1,384 @@
+#ifndef __SEGMENTEDARRAY_SEGMENTEDARRAY_HPP
+#define __SEGMENTEDARRAY_SEGMENTEDARRAY_HPP
+#include <stdexcept>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <bit>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include "./../Array/Array.hpp"
+#include "./../Array/ArrayParallel.hpp" // for ParallelConfig
+
+/*
+SegmentedArray: Array made of fixed size chunks, so growing never moves an elem
+
+    directory (an Array<T*>)         chunks, ChunkSize elems each
+    [ c0 | c1 | c2 ]   c0 -> [ 0 | 1 | 2 | 3 ]
+                       c1 -> [ 4 | 5 | 6 | 7 ]
+                       c2 -> [ 8 | 9 | _ | _ ]   <- size_ = 10, capacity() = 12
+
+- arr[i] is chunks[i >> log2(ChunkSize)][i & (ChunkSize - 1)]: O(1), one extra dependent load vs Array.
+- push_back past capacity allocates ONE new chunk and appends its ptr to the directory. No elem is copied or moved,
+  so the worst case push_back is a single chunk allocation instead of Array's O(n) relocation,
+  and ptrs / refs to elems stay valid for as long as the elem lives (until it is popped, cleared or the arr destroyed).
+  Only the directory itself reallocates, copying n / ChunkSize ptrs.
+- Iters hold (arr, idx) rather than a ptr, so they too survive growth.
+- Elems are only contiguous within a chunk: for_each_chunk / parallel_for_each_chunk hand out whole chunks as
+  [first, last) ptr ranges, which is the fast way to scan (no per elem directory lookup, vectorizable inner loop).
+
+ChunkSize is in elems and must be a power of 2; the default targets ~16 KiB chunks.
+Extra mem: at most one partially filled chunk + the directory (8 B per chunk).
+*/
+
+template <typename T>
+constexpr size_t segmented_default_chunk_size()  {
+    return std::bit_floor(std::max<size_t>(16384 / sizeof(T), 1));
+}
+
+template <typename T, size_t ChunkSize = segmented_default_chunk_size<T>(), typename Alloc = std::allocator<T>>
+class SegmentedArray {
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "SegmentedArray requires a power of 2 ChunkSize");
+
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using PtrAlloc = typename AllocTraits::template rebind_alloc<T*>;
+
+    static constexpr size_t CHUNK_SHIFT = std::countr_zero(ChunkSize);
+    static constexpr size_t CHUNK_MASK = ChunkSize - 1;
+
+public:
+    using allocator_type = Alloc;
+    static constexpr size_t chunk_size = ChunkSize;
+
+    // Random access, but not contiguous: the elems are only adjacent within a chunk.
+    // basic_iterator<true> is the const_iterator, yielding const T&; an iterator converts to it, never the other way around
+    template <bool Const>
+    class basic_iterator  {
+        using Owner = std::conditional_t<Const, const SegmentedArray, SegmentedArray>;
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using iterator_category = std::random_access_iterator_tag;
+
+        basic_iterator() : owner_(nullptr), index_(0) {}
+        basic_iterator(Owner* owner, size_t index) : owner_(owner), index_(index) {}
+        template <bool OtherConst> requires (Const && !OtherConst)
+        basic_iterator(const basic_iterator<OtherConst>& other) : owner_(other.owner_), index_(other.index_) {} // iterator -> const_iterator
+
+        basic_iterator& operator++()  {++index_; return *this;}
+        basic_iterator& operator--()  {--index_; return *this;}
+        basic_iterator operator++(int)  {basic_iterator old = *this; ++index_; return old;}
+        basic_iterator operator--(int)  {basic_iterator old = *this; --index_; return old;}
+
+        basic_iterator& operator+=(difference_type n)  {index_ += n; return *this;}
+        basic_iterator& operator-=(difference_type n)  {index_ -= n; return *this;}
+        basic_iterator operator+(difference_type n) const  {return basic_iterator(owner_, index_ + n);}
+        basic_iterator operator-(difference_type n) const  {return basic_iterator(owner_, index_ - n);}
+        friend basic_iterator operator+(difference_type n, const basic_iterator& it)  {return it + n;}
+
+        reference operator*() const  {return owner_->slot(index_);}
+        pointer operator->() const  {return &owner_->slot(index_);}
+        reference operator[](difference_type n) const  {return owner_->slot(index_ + n);}
+
+        bool operator==(const basic_iterator& rhs) const  {return index_ == rhs.index_ && owner_ == rhs.owner_;} // != is derived
+        auto operator<=>(const basic_iterator& rhs) const  {return index_ <=> rhs.index_;} // iters of the same arr only
+
+        difference_type operator-(const basic_iterator& other) const { return static_cast<difference_type>(index_ - other.index_); }
+
+        size_t index() const  {return index_;}
+
+    private:
+        template <bool> friend class basic_iterator;
+
+        Owner* owner_;
+        size_t index_;
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    SegmentedArray() : SegmentedArray(Alloc()) {}
+    explicit SegmentedArray(const Alloc& alloc); // empty, no chunk allocated yet
+    SegmentedArray(size_t count, const T& other = T(), const Alloc& alloc = Alloc()); // fill constructor
+    ~SegmentedArray();
+    SegmentedArray(const SegmentedArray& other); // copy constructor
+    SegmentedArray& operator=(const SegmentedArray& other); // copy assignment
+    SegmentedArray(SegmentedArray&& other) noexcept; // move constructor: steals the directory, elems stay put
+    SegmentedArray& operator=(SegmentedArray&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value);
+
+    allocator_type get_allocator() const  {return alloc_;}
+
+    T& operator[](size_t index);
+    const T& operator[](size_t index) const;
+
+    void push_back(const T& input);
+    void push_back(T&& input);
+    template <typename... Args>
+    T& emplace_back(Args&&... args); // returns the new elem, whose address never changes
+
+    void pop_back(); // rm last elem, keeps its chunk
+    void clear(); // destroys all elems, keeps the chunks
+
+    size_t size() const   {return size_;}
+    size_t capacity() const   {return chunks_.size() * ChunkSize;}
+    bool empty() const  {return size_ == 0;}
+
+    void resize(size_t new_size, const T& filler = T());
+    void reserve(size_t new_capacity); // allocates chunks up front
+    void shrink_to_fit(); // frees the chunks past the last elem, as no elem has to move this is cheap
+
+    size_t chunk_count() const  {return chunks_.size();}
+    T* chunk_data(size_t chunk)  {return chunks_.data()[chunk];}
+    const T* chunk_data(size_t chunk) const  {return chunks_.data()[chunk];}
+    size_t chunk_length(size_t chunk) const; // num of live elems in chunk (ChunkSize for all but the last used one)
+
+    // f(T* first, T* last) for every chunk holding elems, in order
+    template <typename F>
+    void for_each_chunk(F f);
+    // The same, spread over a ThreadPool: chunks are grouped into tasks of about config.grain elems.
+    // f runs concurrently on distinct chunks, so it must not touch elems outside [first, last)
+    template <typename F>
+    void parallel_for_each_chunk(F f, const ParallelConfig& config = {});
+
+    iterator begin()  {return iterator(this, 0);}
+    iterator end()  {return iterator(this, size_);}
+
+    const_iterator begin() const  {return const_iterator(this, 0);}
+    const_iterator end() const  {return const_iterator(this, size_);}
+    const_iterator cbegin() const  {return begin();}
+    const_iterator cend() const  {return end();}
+
+private:
+    [[no_unique_address]] Alloc alloc_;
+    Array<T*, PtrAlloc> chunks_; // directory: chunks_[c] holds elems [c * ChunkSize, (c + 1) * ChunkSize)
+    size_t size_;
+
+    T& slot(size_t index)  {return chunks_.data()[index >> CHUNK_SHIFT][index & CHUNK_MASK];}
+    const T& slot(size_t index) const  {return chunks_.data()[index >> CHUNK_SHIFT][index & CHUNK_MASK];}
+
+    void add_chunk();
+    void destroy_tail(size_t new_size); // destroys elems [new_size, size_)
+    void release(); // destroys elems and frees every chunk
+};
+
+template <typename T, size_t ChunkSize = segmented_default_chunk_size<T>()>
+using PmrSegmentedArray = SegmentedArray<T, ChunkSize, std::pmr::polymorphic_allocator<T>>;
+
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::add_chunk()  {
+    T* chunk = AllocTraits::allocate(alloc_, ChunkSize);
+    try {
+        chunks_.push_back(chunk);
+    } catch (...) {
+        AllocTraits::deallocate(alloc_, chunk, ChunkSize);
+        throw;
+    }
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::destroy_tail(size_t new_size)  {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (size_t i = new_size; i < size_; ++i)  {
+            AllocTraits::destroy(alloc_, &slot(i));
+        }
+    }
+    size_ = new_size;
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::release()  {
+    destroy_tail(0);
+    for (size_t c = 0; c < chunks_.size(); ++c)  {
+        AllocTraits::deallocate(alloc_, chunks_.data()[c], ChunkSize);
+    }
+    chunks_.clear();
+}
+
+
+template <typename T, size_t ChunkSize, typename Alloc>
+SegmentedArray<T, ChunkSize, Alloc>::SegmentedArray(const Alloc& alloc) : alloc_(alloc), chunks_(PtrAlloc(alloc)), size_(0) {}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+SegmentedArray<T, ChunkSize, Alloc>::SegmentedArray(size_t count, const T& other, const Alloc& alloc) : SegmentedArray(alloc) {
+    resize(count, other);
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+SegmentedArray<T, ChunkSize, Alloc>::~SegmentedArray() {
+    release();
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+SegmentedArray<T, ChunkSize, Alloc>::SegmentedArray(const SegmentedArray& other)
+    : SegmentedArray(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+    reserve(other.size_);
+    for (size_t i = 0; i < other.size_; ++i)  {
+        emplace_back(other.slot(i));
+    }
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+SegmentedArray<T, ChunkSize, Alloc>& SegmentedArray<T, ChunkSize, Alloc>::operator=(const SegmentedArray& other)    {
+    if (this != &other) {
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) release(); // our chunks must be freed by the allocator that allocated them
+            alloc_ = other.alloc_;
+        }
+        clear();
+        reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i)  {
+            emplace_back(other.slot(i));
+        }
+    }
+    return *this;
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+SegmentedArray<T, ChunkSize, Alloc>::SegmentedArray(SegmentedArray&& other) noexcept
+    : alloc_(std::move(other.alloc_)), chunks_(std::move(other.chunks_)), size_(other.size_) {
+    other.size_ = 0;
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+SegmentedArray<T, ChunkSize, Alloc>& SegmentedArray<T, ChunkSize, Alloc>::operator=(SegmentedArray&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)  {
+    if (this != &other) {
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value) {
+            if (alloc_ != other.alloc_) {
+                // other's chunks belong to another resource which we cannot free: move elem by elem instead
+                clear();
+                reserve(other.size_);
+                for (size_t i = 0; i < other.size_; ++i)  {
+                    emplace_back(std::move(other.slot(i)));
+                }
+                other.clear();
+                return *this;
+            }
+        }
+        release();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            alloc_ = std::move(other.alloc_);
+        }
+        chunks_ = std::move(other.chunks_);
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+T& SegmentedArray<T, ChunkSize, Alloc>::operator[](size_t index)   {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return slot(index);
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+const T& SegmentedArray<T, ChunkSize, Alloc>::operator[](size_t index) const   {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return slot(index);
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::push_back(const T& input)  {
+    emplace_back(input);
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::push_back(T&& input)  {
+    emplace_back(std::move(input));
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+template <typename... Args>
+T& SegmentedArray<T, ChunkSize, Alloc>::emplace_back(Args&&... args)  {
+    // args may refer to an elem of ours: safe, as adding a chunk moves nothing
+    if (size_ == capacity()) add_chunk();
+    T* dst = &slot(size_);
+    AllocTraits::construct(alloc_, dst, std::forward<Args>(args)...);
+    ++size_;
+    return *dst;
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::pop_back()  {
+    if (size_ == 0) {
+        throw std::out_of_range("Array is empty");
+    }
+    destroy_tail(size_ - 1);
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::clear()  {
+    destroy_tail(0);
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::resize(size_t new_size, const T& filler)  {
+    if (new_size < size_) {
+        destroy_tail(new_size);
+        return;
+    }
+    reserve(new_size);
+    while (size_ < new_size) {
+        emplace_back(filler);
+    }
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::reserve(size_t new_capacity)  {
+    size_t needed = (new_capacity + ChunkSize - 1) >> CHUNK_SHIFT;
+    chunks_.reserve(needed);
+    while (chunks_.size() < needed) {
+        add_chunk();
+    }
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+void SegmentedArray<T, ChunkSize, Alloc>::shrink_to_fit()  {
+    size_t needed = (size_ + ChunkSize - 1) >> CHUNK_SHIFT;
+    while (chunks_.size() > needed) {
+        AllocTraits::deallocate(alloc_, chunks_.data()[chunks_.size() - 1], ChunkSize);
+        chunks_.pop_back();
+    }
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+size_t SegmentedArray<T, ChunkSize, Alloc>::chunk_length(size_t chunk) const  {
+    size_t first = chunk << CHUNK_SHIFT;
+    if (first >= size_) return 0;
+    return std::min(ChunkSize, size_ - first);
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+template <typename F>
+void SegmentedArray<T, ChunkSize, Alloc>::for_each_chunk(F f)  {
+    size_t used = (size_ + ChunkSize - 1) >> CHUNK_SHIFT;
+    for (size_t c = 0; c < used; ++c)  {
+        T* first = chunks_.data()[c];
+        f(first, first + chunk_length(c));
+    }
+}
+
+template <typename T, size_t ChunkSize, typename Alloc>
+template <typename F>
+void SegmentedArray<T, ChunkSize, Alloc>::parallel_for_each_chunk(F f, const ParallelConfig& config)  {
+    size_t used = (size_ + ChunkSize - 1) >> CHUNK_SHIFT;
+    size_t chunks_per_task = std::max<size_t>(config.grain >> CHUNK_SHIFT, 1);
+    config.get_pool().parallel_for(0, used, chunks_per_task, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)  {
+            T* first = chunks_.data()[c];
+            f(first, first + chunk_length(c));
+        }
+    });
+}
+
+
+#endif // __SEGMENTEDARRAY_SEGMENTEDARRAY_HPP
@@ -0,0 +1,188 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include "SegmentedArray.hpp"
+#include "./../MemoryResource/MemoryResource.hpp"
+
+void printTestResult(const std::string& testName, bool passed) {
+    std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+template<typename T, size_t C, typename A>
+bool verifyContents(const SegmentedArray<T, C, A>& arr, const std::vector<T>& expected) {
+    if (arr.size() != expected.size()) return false;
+    for (size_t i = 0; i < arr.size(); ++i) {
+        if (arr[i] != expected[i]) return false;
+    }
+    return true;
+}
+
+int main() {
+    try {
+        // Test 1: Basic Operations
+        {
+            SegmentedArray<int, 4> arr;
+            printTestResult("Initial Empty Check", arr.empty() && arr.capacity() == 0);
+
+            for (int i = 0; i < 10; ++i) {
+                arr.push_back(i);
+            }
+            printTestResult("Push Back - Size", arr.size() == 10);
+            printTestResult("Push Back - Chunk Granular Capacity", arr.capacity() == 12 && arr.chunk_count() == 3);
+            printTestResult("Push Back - Contents", verifyContents(arr, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+            printTestResult("Chunk Lengths", arr.chunk_length(0) == 4 && arr.chunk_length(2) == 2 && arr.chunk_length(3) == 0);
+
+            bool exceptionThrown = false;
+            try {
+                arr[10];
+            } catch (const std::out_of_range&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Out Of Bounds Throws", exceptionThrown);
+
+            arr.pop_back();
+            arr.resize(12, -1);
+            printTestResult("Pop Back And Resize", verifyContents(arr, {0, 1, 2, 3, 4, 5, 6, 7, 8, -1, -1, -1}));
+            arr.resize(3);
+            printTestResult("Resize Down", verifyContents(arr, {0, 1, 2}) && arr.capacity() == 12);
+            arr.shrink_to_fit();
+            printTestResult("Shrink To Fit", arr.capacity() == 4);
+            arr.clear();
+            printTestResult("Clear Keeps Chunks", arr.empty() && arr.capacity() == 4);
+        }
+
+        // Test 2: Stable References
+        {
+            SegmentedArray<std::string, 8> arr;
+            arr.push_back("first");
+            std::string* first = &arr[0];
+            auto it = arr.begin();
+            for (int i = 0; i < 1000; ++i) {
+                arr.push_back(std::to_string(i));
+            }
+            printTestResult("Stable Address Across Growth", first == &arr[0] && *first == "first");
+            printTestResult("Stable Iterator Across Growth", *it == "first");
+
+            arr.emplace_back(arr[0]); // aliasing emplace_back right at a chunk boundary
+            printTestResult("Aliasing Emplace Back", arr[arr.size() - 1] == "first");
+
+            std::string& ref = arr.emplace_back(5, 'x');
+            printTestResult("Emplace Back Returns Elem", &ref == &arr[arr.size() - 1] && ref == "xxxxx");
+        }
+
+        // Test 3: Iterators
+        {
+            SegmentedArray<int, 16> arr;
+            for (int i = 0; i < 100; ++i) {
+                arr.push_back(i);
+            }
+            int sum = 0;
+            for (int value : arr) {
+                sum += value;
+            }
+            printTestResult("Range For", sum == 99 * 100 / 2);
+            printTestResult("Iterator Distance", arr.end() - arr.begin() == 100);
+            printTestResult("std::find", std::find(arr.begin(), arr.end(), 42).index() == 42);
+
+            std::vector<int> copied(arr.begin(), arr.end());
+            printTestResult("Copy Into Vector", copied.size() == 100 && copied[99] == 99);
+
+            static_assert(std::random_access_iterator<SegmentedArray<int, 16>::iterator>);
+            static_assert(std::random_access_iterator<SegmentedArray<int, 16>::const_iterator>);
+            static_assert(std::is_same_v<std::iter_reference_t<SegmentedArray<int, 16>::const_iterator>, const int&>);
+            static_assert(std::is_convertible_v<SegmentedArray<int, 16>::iterator, SegmentedArray<int, 16>::const_iterator>);
+            static_assert(!std::is_convertible_v<SegmentedArray<int, 16>::const_iterator, SegmentedArray<int, 16>::iterator>);
+
+            auto it = arr.begin();
+            it += 20;
+            it -= 4;
+            auto old = it++;
+            printTestResult("Compound And Postfix Ops", old.index() == 16 && it.index() == 17 && it[3] == 20 && *(it - 17) == 0
+                            && *(2 + it) == 19 && arr.begin() < it && it > old && arr.end() >= it);
+            std::advance(it, -7);
+            printTestResult("std::advance Backwards", *it == 10);
+
+            const SegmentedArray<int, 16>& constArr = arr;
+            SegmentedArray<int, 16>::const_iterator cit = arr.begin(); // iterator -> const_iterator
+            printTestResult("Const Iterator", cit == constArr.begin() && constArr.cend() - cit == 100
+                            && *std::lower_bound(constArr.begin(), constArr.end(), 37) == 37);
+            std::ranges::reverse(arr);
+            printTestResult("std::ranges Algorithms", arr[0] == 99 && std::ranges::is_sorted(constArr, std::greater<>()));
+        }
+
+        // Test 4: Chunk Iteration
+        {
+            SegmentedArray<int, 64> arr;
+            for (int i = 0; i < 1000; ++i) {
+                arr.push_back(i);
+            }
+            long long serial = 0;
+            size_t chunks = 0;
+            arr.for_each_chunk([&](int* first, int* last) {
+                serial = std::accumulate(first, last, serial);
+                ++chunks;
+            });
+            printTestResult("For Each Chunk", serial == 999LL * 1000 / 2 && chunks == 16);
+
+            ThreadPool pool(3);
+            arr.parallel_for_each_chunk([](int* first, int* last) {
+                for (; first != last; ++first) *first *= 2;
+            }, {&pool, 128});
+            bool doubled = true;
+            for (int i = 0; i < 1000; ++i) {
+                if (arr[i] != 2 * i) doubled = false;
+            }
+            printTestResult("Parallel For Each Chunk", doubled);
+
+            std::atomic<long long> total{0};
+            parallel_for_each(arr.begin(), arr.end(), [&](int value) { total.fetch_add(value); }, {&pool, 100});
+            printTestResult("Generic Parallel For Each", total.load() == 999LL * 1000);
+        }
+
+        // Test 5: Copy And Move
+        {
+            SegmentedArray<std::string, 4> a;
+            for (int i = 0; i < 10; ++i) {
+                a.push_back(std::to_string(i));
+            }
+            SegmentedArray<std::string, 4> b(a);
+            b[0] = "changed";
+            printTestResult("Copy Constructor - Deep", a[0] == "0" && b[0] == "changed" && b.size() == 10);
+
+            std::string* elem = &a[5];
+            SegmentedArray<std::string, 4> c(std::move(a));
+            printTestResult("Move Constructor - Elems Stay Put", &c[5] == elem && a.empty());
+
+            b = c;
+            printTestResult("Copy Assignment", verifyContents(b, {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"}));
+            a = std::move(b);
+            printTestResult("Move Assignment", a.size() == 10 && b.empty());
+            a.push_back("10"); // a moved-from directory must still grow
+            b.push_back("x");
+            printTestResult("Reuse After Move", a.size() == 11 && b.size() == 1 && b[0] == "x");
+        }
+
+        // Test 6: Pmr
+        {
+            MonotonicArena arena(1 << 16);
+            PmrSegmentedArray<int, 32> arr(&arena);
+            for (int i = 0; i < 100; ++i) {
+                arr.push_back(i);
+            }
+            printTestResult("Pmr - Chunks From Arena", arena.bytes_allocated() >= 4 * 32 * sizeof(int) && arr[99] == 99);
+        }
+
+        std::cout << "\nAll SegmentedArray tests completed!" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
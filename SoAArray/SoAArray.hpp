@@ -0,0 +1,255 @@
+#ifndef __SOAARRAY_SOAARRAY_HPP
+#define __SOAARRAY_SOAARRAY_HPP
+#include <stdexcept>
+#include <tuple>
+#include <span>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+#include "./../Array/Array.hpp"
+
+/*
+SoAArray: structure of arrays, one Array per field
+
+    Array<Particle> (AoS)                    SoAArray<float, float, int> (SoA)
+    [ x0 y0 id0 | x1 y1 id1 | x2 y2 id2 ]    x:  [ x0 | x1 | x2 ]
+                                             y:  [ y0 | y1 | y2 ]
+                                             id: [ id0 | id1 | id2 ]
+
+A scan over x alone reads sizeof(float) B per record instead of sizeof(Particle), so every fetched cache line is all payload,
+and the column is a plain contiguous arr the SIMD kernels (ArraySIMD.hpp) and the compiler's auto vectorizer handle directly:
+
+    SoAArray<float, float, int> particles;
+    particles.push_back(1.f, 2.f, 7);
+    simd_sum(particles.column<0>());               // touches the x column only
+    for (float& y : particles.span<1>()) y += 1;   // std::span over the y column
+
+Whole records are accessed through proxies: soa[i] / *it is a std::tuple of refs into the columns,
+
+    auto [x, y, id] = particles[0];  x = 3.f;      // writes through to the x column
+
+The columns always have equal sizes: record ops touch all of them and roll back on a throw, and column<I>() only hands out
+a const ref, so resizing a single column is impossible (element access through span<I>() / data is fine).
+Proxy iters are random access but NOT swappable like real refs, so run std::sort etc. on an index permutation instead.
+iterator models std::random_access_iterator; const_iterator only w/ a C++23 std lib (__cpp_lib_ranges_zip), whose tuples
+of refs have the common_reference the concept asks for. The legacy random access ops, std::advance etc. work either way.
+*/
+
+template <typename... Fields>
+class SoAArray {
+    static_assert(sizeof...(Fields) > 0, "SoAArray requires at least one field");
+public:
+    using value_type = std::tuple<Fields...>; // a record by value
+    using reference = std::tuple<Fields&...>; // a record proxy
+    using const_reference = std::tuple<const Fields&...>;
+
+    static constexpr size_t num_fields = sizeof...(Fields);
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    template <bool Const>
+    class basic_iterator  {
+        using Owner = std::conditional_t<Const, const SoAArray, SoAArray>;
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = SoAArray::value_type;
+        using reference = std::conditional_t<Const, SoAArray::const_reference, SoAArray::reference>;
+        using pointer = void;
+        using iterator_category = std::random_access_iterator_tag;
+
+        basic_iterator() : owner_(nullptr), index_(0) {}
+        basic_iterator(Owner* owner, size_t index) : owner_(owner), index_(index) {}
+        template <bool OtherConst> requires (Const && !OtherConst)
+        basic_iterator(const basic_iterator<OtherConst>& other) : owner_(other.owner_), index_(other.index_) {} // iterator -> const_iterator
+
+        basic_iterator& operator++()  {++index_; return *this;}
+        basic_iterator& operator--()  {--index_; return *this;}
+        basic_iterator operator++(int)  {basic_iterator old = *this; ++index_; return old;}
+        basic_iterator operator--(int)  {basic_iterator old = *this; --index_; return old;}
+
+        basic_iterator& operator+=(difference_type n)  {index_ += n; return *this;}
+        basic_iterator& operator-=(difference_type n)  {index_ -= n; return *this;}
+        basic_iterator operator+(difference_type n) const  {return basic_iterator(owner_, index_ + n);}
+        basic_iterator operator-(difference_type n) const  {return basic_iterator(owner_, index_ - n);}
+        friend basic_iterator operator+(difference_type n, const basic_iterator& it)  {return it + n;}
+
+        reference operator*() const  {return owner_->record(index_);}
+        reference operator[](difference_type n) const  {return owner_->record(index_ + n);}
+
+        bool operator==(const basic_iterator& rhs) const  {return index_ == rhs.index_ && owner_ == rhs.owner_;} // != is derived
+        auto operator<=>(const basic_iterator& rhs) const  {return index_ <=> rhs.index_;} // iters of the same arr only
+
+        difference_type operator-(const basic_iterator& other) const { return static_cast<difference_type>(index_ - other.index_); }
+
+        size_t index() const  {return index_;}
+
+    private:
+        template <bool> friend class basic_iterator;
+
+        Owner* owner_;
+        size_t index_;
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    SoAArray() = default;
+
+    reference operator[](size_t index); // record proxy, throws out_of_range like Array
+    const_reference operator[](size_t index) const;
+
+    // Single field access, reading only that column
+    template <size_t I>
+    field_type<I>& get(size_t index)  {return std::get<I>(columns_)[index];}
+    template <size_t I>
+    const field_type<I>& get(size_t index) const  {return std::get<I>(columns_)[index];}
+
+    // Whole columns: the Array itself (read only, to keep the sizes in sync) or a mutable span over its elems
+    template <size_t I>
+    const Array<field_type<I>>& column() const  {return std::get<I>(columns_);}
+    template <size_t I>
+    std::span<field_type<I>> span()  {return {std::get<I>(columns_).data(), size()};}
+    template <size_t I>
+    std::span<const field_type<I>> span() const  {return {std::get<I>(columns_).data(), size()};}
+
+    void push_back(const Fields&... fields);
+    void push_back(const value_type& record);
+    template <typename... Args>
+    void emplace_back(Args&&... args); // one arg per field, each forwarded to its column's emplace_back
+
+    void pop_back();
+    void swap_remove(size_t index); // O(1) per column, does NOT preserve order
+    void clear();
+
+    size_t size() const   {return std::get<0>(columns_).size();}
+    size_t capacity() const; // min over the columns
+    bool empty() const  {return size() == 0;}
+
+    void resize(size_t new_size, const value_type& filler = value_type());
+    void reserve(size_t new_capacity);
+    void shrink_to_fit();
+
+    iterator begin()  {return iterator(this, 0);}
+    iterator end()  {return iterator(this, size());}
+    const_iterator begin() const  {return const_iterator(this, 0);}
+    const_iterator end() const  {return const_iterator(this, size());}
+
+private:
+    std::tuple<Array<Fields>...> columns_;
+
+    // Unchecked record proxies, for the iters
+    reference record(size_t index)  {
+        return std::apply([index](auto&... column) {return reference(column.data()[index]...);}, columns_);
+    }
+    const_reference record(size_t index) const  {
+        return std::apply([index](const auto&... column) {return const_reference(column.data()[index]...);}, columns_);
+    }
+
+    template <typename Fn>
+    void for_each_column(Fn&& fn)  {std::apply([&fn](auto&... column) {(fn(column), ...);}, columns_);}
+
+    template <size_t... Is, typename... Args>
+    void emplace_columns(std::index_sequence<Is...>, Args&&... args);
+};
+
+
+template <typename... Fields>
+typename SoAArray<Fields...>::reference SoAArray<Fields...>::operator[](size_t index)  {
+    if (index >= size()) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return record(index);
+}
+
+template <typename... Fields>
+typename SoAArray<Fields...>::const_reference SoAArray<Fields...>::operator[](size_t index) const  {
+    if (index >= size()) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return record(index);
+}
+
+template <typename... Fields>
+template <size_t... Is, typename... Args>
+void SoAArray<Fields...>::emplace_columns(std::index_sequence<Is...>, Args&&... args)  {
+    // Column by column, left to right. If column k throws, columns [0, k) already grew and are popped again,
+    // leaving every column at its old size (strong guarantee, as pop_back never reallocates).
+    size_t pushed = 0;
+    try {
+        ((std::get<Is>(columns_).emplace_back(std::forward<Args>(args)), ++pushed), ...);
+    } catch (...) {
+        size_t k = 0;
+        ((k++ < pushed ? std::get<Is>(columns_).pop_back() : void()), ...);
+        throw;
+    }
+}
+
+template <typename... Fields>
+void SoAArray<Fields...>::push_back(const Fields&... fields)  {
+    emplace_columns(std::index_sequence_for<Fields...>(), fields...);
+}
+
+template <typename... Fields>
+void SoAArray<Fields...>::push_back(const value_type& record)  {
+    std::apply([this](const Fields&... fields) {push_back(fields...);}, record);
+}
+
+template <typename... Fields>
+template <typename... Args>
+void SoAArray<Fields...>::emplace_back(Args&&... args)  {
+    static_assert(sizeof...(Args) == sizeof...(Fields), "emplace_back takes exactly one arg per field");
+    emplace_columns(std::index_sequence_for<Fields...>(), std::forward<Args>(args)...);
+}
+
+template <typename... Fields>
+void SoAArray<Fields...>::pop_back()  {
+    if (empty()) {
+        throw std::out_of_range("Array is empty");
+    }
+    for_each_column([](auto& column) {column.pop_back();});
+}
+
+template <typename... Fields>
+void SoAArray<Fields...>::swap_remove(size_t index)  {
+    if (index >= size()) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    for_each_column([index](auto& column) {column.swap_remove(index);});
+}
+
+template <typename... Fields>
+void SoAArray<Fields...>::clear()  {
+    for_each_column([](auto& column) {column.clear();});
+}
+
+template <typename... Fields>
+size_t SoAArray<Fields...>::capacity() const  {
+    return std::apply([](const auto&... column) {return std::min({column.capacity()...});}, columns_);
+}
+
+template <typename... Fields>
+void SoAArray<Fields...>::resize(size_t new_size, const value_type& filler)  {
+    if (new_size <= size()) {
+        // pop_back rather than column.resize: shrinking must not need a default constructible filler per field
+        for_each_column([new_size](auto& column) {
+            while (column.size() > new_size) column.pop_back();
+        });
+        return;
+    }
+    reserve(new_size); // after this, growing cannot fail for lack of mem
+    while (size() < new_size) {
+        push_back(filler);
+    }
+}
+
+template <typename... Fields>
+void SoAArray<Fields...>::reserve(size_t new_capacity)  {
+    for_each_column([new_capacity](auto& column) {column.reserve(new_capacity);});
+}
+
+template <typename... Fields>
+void SoAArray<Fields...>::shrink_to_fit()  {
+    for_each_column([](auto& column) {column.shrink_to_fit();});
+}
+
+
+#endif // __SOAARRAY_SOAARRAY_HPP
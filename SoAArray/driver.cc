@@ -0,0 +1,177 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+#include <version>
+#include "SoAArray.hpp"
+#include "./../Array/ArraySIMD.hpp"
+
+void printTestResult(const std::string& testName, bool passed) {
+    std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+// Throws on the n-th copy, to check that a failed push_back leaves all columns in sync
+struct ThrowOnCopy {
+    static int copies_left;
+    int value = 0;
+    ThrowOnCopy() = default;
+    ThrowOnCopy(int v) : value(v) {}
+    ThrowOnCopy(const ThrowOnCopy& other) : value(other.value) {
+        if (copies_left-- == 0) throw std::runtime_error("copy failed");
+    }
+    ThrowOnCopy& operator=(const ThrowOnCopy&) = default;
+};
+int ThrowOnCopy::copies_left = 1000000;
+
+// No default constructor: shrinking must not need one
+struct NoDefault {
+    int value;
+    explicit NoDefault(int v) : value(v) {}
+};
+
+int main() {
+    try {
+        // Test 1: Basic Operations
+        {
+            SoAArray<int, double, std::string> soa;
+            printTestResult("Initial Empty Check", soa.empty() && soa.size() == 0);
+
+            soa.push_back(1, 1.5, "one");
+            soa.push_back(std::make_tuple(2, 2.5, std::string("two")));
+            soa.emplace_back(3, 3.5, "xxxxx"); // the const char* is forwarded to std::string's constructor
+            printTestResult("Push Back - Size", soa.size() == 3);
+            printTestResult("Push Back - Contents", std::get<0>(soa[0]) == 1 && std::get<1>(soa[1]) == 2.5
+                            && soa.get<2>(2) == "xxxxx");
+
+            bool exceptionThrown = false;
+            try {
+                soa[3];
+            } catch (const std::out_of_range&) {
+                exceptionThrown = true;
+            }
+            printTestResult("Out Of Bounds Throws", exceptionThrown);
+
+            auto [id, weight, name] = soa[0];
+            id = 10;
+            name = "ten";
+            printTestResult("Proxy Writes Through", soa.get<0>(0) == 10 && soa.get<2>(0) == "ten" && weight == 1.5);
+
+            soa.swap_remove(0);
+            printTestResult("Swap Remove", soa.size() == 2 && soa.get<0>(0) == 3 && soa.get<2>(0) == "xxxxx");
+            soa.pop_back();
+            printTestResult("Pop Back", soa.size() == 1 && soa.get<0>(0) == 3);
+            soa.clear();
+            printTestResult("Clear", soa.empty());
+        }
+
+        // Test 2: Columns
+        {
+            SoAArray<float, int> soa;
+            for (int i = 0; i < 1000; ++i) {
+                soa.push_back(static_cast<float>(i), i % 7);
+            }
+            printTestResult("Column Size", soa.column<0>().size() == 1000 && soa.column<1>().size() == 1000);
+            printTestResult("Column SIMD Sum", simd_sum(soa.column<0>()) == 999.0 * 1000 / 2);
+            printTestResult("Column SIMD Count", simd_count(soa.column<1>(), 0) == 143);
+
+            for (int& key : soa.span<1>()) {
+                key *= 2;
+            }
+            printTestResult("Span Writes Through", soa.get<1>(13) == 12);
+            printTestResult("Span Is Contiguous", soa.span<0>().data() + 999 == &soa.get<0>(999));
+        }
+
+        // Test 3: Zipped Iterators
+        {
+            SoAArray<int, char> soa;
+            for (int i = 0; i < 26; ++i) {
+                soa.push_back(i, static_cast<char>('a' + i));
+            }
+            std::string letters;
+            int sum = 0;
+            for (auto [number, letter] : soa) {
+                sum += number;
+                letters += letter;
+            }
+            printTestResult("Range For Over Records", sum == 25 * 26 / 2 && letters == "abcdefghijklmnopqrstuvwxyz");
+
+            for (auto record : soa) {
+                std::get<1>(record) = static_cast<char>(std::get<1>(record) - 'a' + 'A');
+            }
+            printTestResult("Iterator Proxies Write Through", soa.get<1>(25) == 'Z');
+
+            auto it = std::find_if(soa.begin(), soa.end(), [](auto record) { return std::get<1>(record) == 'Q'; });
+            printTestResult("std::find_if", it.index() == 16 && it - soa.begin() == 16);
+
+            const SoAArray<int, char>& constSoa = soa;
+            int constSum = 0;
+            for (auto [number, letter] : constSoa) {
+                constSum += number;
+            }
+            printTestResult("Const Iteration", constSum == sum);
+
+            static_assert(std::random_access_iterator<SoAArray<int, char>::iterator>);
+#ifdef __cpp_lib_ranges_zip // C++23 tuples of refs have a common_reference
+            static_assert(std::random_access_iterator<SoAArray<int, char>::const_iterator>);
+#endif
+            static_assert(std::is_convertible_v<SoAArray<int, char>::iterator, SoAArray<int, char>::const_iterator>);
+            auto jt = soa.begin();
+            jt += 10;
+            jt -= 4;
+            auto old = jt++;
+            printTestResult("Compound And Postfix Ops", old.index() == 6 && jt.index() == 7 && std::get<1>(jt[3]) == 'K'
+                            && std::get<0>(*(jt - 7)) == 0 && std::get<0>(*(2 + jt)) == 9 && soa.begin() < jt && jt > old);
+            std::advance(jt, -5);
+            SoAArray<int, char>::const_iterator cjt = jt; // iterator -> const_iterator
+            printTestResult("std::advance Backwards", std::get<0>(*cjt) == 2 && constSoa.end() - cjt == 24);
+            printTestResult("std::ranges Algorithms", std::ranges::distance(soa) == 26
+                            && std::ranges::find_if(soa, [](auto record) { return std::get<0>(record) == 20; }).index() == 20);
+        }
+
+        // Test 4: Resize And Reserve
+        {
+            SoAArray<int, double> soa;
+            soa.reserve(100);
+            printTestResult("Reserve", soa.capacity() >= 100 && soa.empty());
+            soa.resize(5, {7, 0.5});
+            printTestResult("Resize Up", soa.size() == 5 && soa.get<0>(4) == 7 && soa.get<1>(4) == 0.5);
+            soa.resize(2);
+            printTestResult("Resize Down", soa.size() == 2 && soa.column<1>().size() == 2);
+            soa.shrink_to_fit();
+            printTestResult("Shrink To Fit", soa.capacity() == 2);
+
+            SoAArray<int, NoDefault> noDefault;
+            for (int i = 0; i < 5; ++i) {
+                noDefault.emplace_back(i, NoDefault(i));
+            }
+            noDefault.resize(2, {0, NoDefault(0)});
+            printTestResult("Resize Down W/out Default Constructor", noDefault.size() == 2 && noDefault.get<1>(1).value == 1);
+        }
+
+        // Test 5: Columns Stay In Sync When A Push Throws
+        {
+            SoAArray<int, ThrowOnCopy> soa;
+            soa.push_back(1, ThrowOnCopy(1));
+            ThrowOnCopy::copies_left = 0;
+            bool exceptionThrown = false;
+            try {
+                soa.push_back(2, ThrowOnCopy(2));
+            } catch (const std::runtime_error&) {
+                exceptionThrown = true;
+            }
+            ThrowOnCopy::copies_left = 1000000;
+            printTestResult("Throwing Push Back Rolls Back", exceptionThrown && soa.size() == 1
+                            && soa.column<0>().size() == 1 && soa.column<1>().size() == 1);
+        }
+
+        std::cout << "\nAll SoAArray tests completed!" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#ifndef __THREADPOOL_THREADPOOL_HPP
+#define __THREADPOOL_THREADPOOL_HPP
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include "./../Queue/Queue.hpp"
+#include "./../Array/Array.hpp"
+
+/*
+ThreadPool: a fixed set of worker threads pulling tasks from a shared FIFO queue.
+
+- submit(task): fire & forget.
+- parallel_for(begin, end, grain, body): split [begin, end) into chunks of grain idxs and run body(chunk_begin, chunk_end)
+  on the workers AND the calling thread, return once every chunk is done. The first exception thrown by body is rethrown
+  in the caller (the remaining chunks still run).
+
+Chunks are claimed through an atomic counter rather than pre-assigned to threads, which balances uneven chunks and makes
+parallel_for safe to nest: a caller never blocks while a chunk of its own loop is unclaimed, as it runs them itself.
+
+Chunk boundaries only depend on (begin, end, grain), never on the num of threads, so algorithms combining per-chunk results
+in chunk order (see Array/ArrayParallel.hpp) are deterministic.
+*/
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t num_threads = std::max(1u, std::thread::hardware_concurrency()));
+    ~ThreadPool(); // finishes queued tasks, then joins
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const  {return workers.size();}
+
+    void submit(std::function<void()> task);
+
+    void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    static ThreadPool& global(); // process wide pool w/ one thread per core, created on first use
+
+private:
+    Array<std::thread> workers;
+    Queue<std::function<void()>> tasks;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+
+    void work();
+};
+
+
+inline ThreadPool::ThreadPool(size_t num_threads)  {
+    if (num_threads == 0) throw std::invalid_argument("ThreadPool needs at least one thread");
+    workers.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)  {
+        workers.emplace_back([this] {work();});
+    }
+}
+
+inline ThreadPool::~ThreadPool()  {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers)  {
+        worker.join();
+    }
+}
+
+inline ThreadPool& ThreadPool::global()  {
+    static ThreadPool pool; // thread safe init since C++11
+    return pool;
+}
+
+inline void ThreadPool::submit(std::function<void()> task)  {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        tasks.push(std::move(task));
+    }
+    cv.notify_one();
+}
+
+inline void ThreadPool::work()  {
+    while (1) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this] {return stopping || !tasks.empty();});
+            if (tasks.empty()) return; // stopping and drained
+            task = tasks.front(); // Queue only hands out const refs
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+inline void ThreadPool::parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body)  {
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+    size_t num_chunks = (end - begin + grain - 1) / grain;
+    if (num_chunks == 1) {
+        body(begin, end); // not worth a round trip through the queue
+        return;
+    }
+
+    // Shared w/ the helper tasks, which may only get to run after this call returned: they then find no chunk left
+    // and exit w/out touching body.
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+
+    auto run_chunks = [state, begin, end, grain, num_chunks, &body] {
+        size_t chunk;
+        while ((chunk = state->next.fetch_add(1)) < num_chunks) {
+            size_t chunk_begin = begin + chunk * grain;
+            try {
+                body(chunk_begin, std::min(end, chunk_begin + grain));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mtx);
+                if (!state->error) state->error = std::current_exception();
+            }
+            if (state->done.fetch_add(1) + 1 == num_chunks) {
+                std::lock_guard<std::mutex> lock(state->mtx); // pairs w/ the waiting caller, so the wakeup is not lost
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(num_chunks - 1, size());
+    for (size_t i = 0; i < helpers; ++i)  {
+        submit(run_chunks);
+    }
+    run_chunks(); // the caller works too instead of idling
+
+    std::unique_lock<std::mutex> lock(state->mtx);
+    state->cv.wait(lock, [&] {return state->done.load() == num_chunks;});
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+
+#endif // __THREADPOOL_THREADPOOL_HPP
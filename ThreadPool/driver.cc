@@ -0,0 +1,92 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include "ThreadPool.hpp"
+
+void printTestResult(const std::string& testName, bool passed) {
+    std::cout << testName << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+}
+
+int main() {
+    try {
+        // Test 1: Submit
+        {
+            std::atomic<int> counter{0};
+            {
+                ThreadPool pool(4);
+                printTestResult("Pool Size", pool.size() == 4);
+                for (int i = 0; i < 100; ++i) {
+                    pool.submit([&counter] { counter.fetch_add(1); });
+                }
+            } // destructor drains the queue
+            printTestResult("Submit - All Tasks Run", counter.load() == 100);
+        }
+
+        // Test 2: Parallel For covers every idx exactly once
+        {
+            ThreadPool pool(3);
+            std::vector<std::atomic<int>> hits(10007);
+            pool.parallel_for(0, hits.size(), 100, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+            });
+            bool exactlyOnce = true;
+            for (auto& hit : hits) {
+                if (hit.load() != 1) exactlyOnce = false;
+            }
+            printTestResult("Parallel For - Exactly Once", exactlyOnce);
+
+            bool called = false;
+            pool.parallel_for(5, 5, 10, [&](size_t, size_t) { called = true; });
+            printTestResult("Parallel For - Empty Range", !called);
+        }
+
+        // Test 3: Nested Parallel For does not deadlock
+        {
+            ThreadPool pool(2);
+            std::atomic<int> total{0};
+            pool.parallel_for(0, 8, 1, [&](size_t, size_t) {
+                pool.parallel_for(0, 100, 10, [&](size_t begin, size_t end) {
+                    total.fetch_add(static_cast<int>(end - begin));
+                });
+            });
+            printTestResult("Parallel For - Nested", total.load() == 800);
+        }
+
+        // Test 4: Exceptions propagate to the caller
+        {
+            ThreadPool pool(2);
+            bool caught = false;
+            try {
+                pool.parallel_for(0, 100, 10, [](size_t begin, size_t) {
+                    if (begin == 50) throw std::runtime_error("chunk failed");
+                });
+            } catch (const std::runtime_error&) {
+                caught = true;
+            }
+            printTestResult("Parallel For - Exception Propagates", caught);
+
+            std::atomic<int> after{0};
+            pool.parallel_for(0, 10, 1, [&](size_t, size_t) { after.fetch_add(1); });
+            printTestResult("Parallel For - Usable After Exception", after.load() == 10);
+        }
+
+        // Test 5: Global Pool
+        {
+            std::atomic<int> sum{0};
+            ThreadPool::global().parallel_for(0, 1000, 64, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) sum.fetch_add(static_cast<int>(i));
+            });
+            printTestResult("Global Pool", sum.load() == 999 * 1000 / 2);
+        }
+
+        std::cout << "\nAll ThreadPool tests completed!" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}